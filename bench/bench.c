@@ -0,0 +1,321 @@
+// bench.c
+// Micro-benchmarks do motor de notas. Cada resultado sai como uma linha JSON
+// em stdout, para comparar versões com ferramentas comuns (jq, planilhas, CI).
+//
+//   output/bench                       roda todos os cenários
+//   output/bench --gerar arq.samba [--notas N] [--densidade D] [--longas P] [--acordes P] [--semente S]
+//                                      só gera um chart sintético
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <SDL2/SDL_mixer.h>
+
+#include "../src/defs.h"
+#include "../src/stage.h"
+#include "../src/note.h"
+#include "../src/confetti.h"
+#include "chartgen.h"
+
+// O jogo define estes globais em main.c; aqui usamos a resolução de referência.
+int SCREEN_WIDTH  = 1920;
+int SCREEN_HEIGHT = 1080;
+
+#define BENCH_VERSAO        3
+#define BENCH_JANELAS       5      // trechos cronometrados, do começo ao fim do chart
+#define BENCH_QUADROS       600    // 10 s a 60 fps por trecho
+#define BENCH_AQUECIMENTO   60     // quadros fora do cronômetro antes de cada trecho
+#define BENCH_QUADROS_RENDER 300
+#define BENCH_DT            (1.0f / 60.0f)
+#define BENCH_QUADROS_CONFETES 600
+#define BENCH_ESCALA        (NOTE_SPEED / 1000.0f) // hi-speed 100%
+#define BENCH_OFFSET_MS     0.0f                   // OFFSET_MS padrão do config
+
+typedef struct {
+    ChartGenParams params;
+    int repeticoesParser;
+} Cenario;
+
+static const Cenario s_cenarios[] = {
+    { {   1000,  8.0f, 0.10f, 0.10f, 1u }, 10 },
+    { {  10000, 12.0f, 0.10f, 0.20f, 2u },  5 },
+    { { 100000, 20.0f, 0.10f, 0.20f, 3u },  3 }, // stress: denso
+    { { 100000, 20.0f, 0.50f, 0.10f, 4u },  3 }, // stress: muitas longas
+    { { 100000, 20.0f, 0.05f, 0.60f, 5u },  3 }, // stress: muitos acordes
+};
+
+static double s_msPorTick = 0.0;
+
+static double agoraMs(void) {
+    return (double)SDL_GetPerformanceCounter() * s_msPorTick;
+}
+
+// Volta todas as notas ao estado de recém-carregadas, na ordem de surgimento
+// que Game_Init deixa (hi-speed 100%)
+static void reiniciarFase(Fase* fase) {
+    Note_SortBySpawn(fase->beatmap, fase->totalNotas, BENCH_ESCALA);
+    for (int i = 0; i < fase->totalNotas; ++i) {
+        Nota* n = &fase->beatmap[i];
+        n->estado = NOTA_INATIVA;
+        n->pos.x = NOTE_START_X;
+        n->despawnTimer = 0.0f;
+    }
+    fase->proximaNotaIndex = 0;
+}
+
+// O mesmo passo de notas de Game_Update (Note_AdvanceFrame), com hi-speed 100%
+static void simularQuadro(Fase* fase, Uint32 tempoAtual, float dt) {
+    double distAgora = ScrollMap_Dist(&fase->rolagem, tempoAtual);
+    NotasPerdidas perdidas;
+    Note_AdvanceFrame(fase->beatmap, fase->totalNotas, &fase->proximaNotaIndex, distAgora,
+                      BENCH_ESCALA, tempoAtual, BENCH_OFFSET_MS, dt, &perdidas);
+}
+
+// Espelho da busca de Game_HandleEvent: primeira nota ativa da pista dentro da janela.
+static Nota* buscarAcerto(Fase* fase, SDL_Keycode tecla, float agoraMs) {
+    for (int i = 0; i < fase->totalNotas; ++i) {
+        Nota* nota = &fase->beatmap[i];
+        if (nota->estado != NOTA_ATIVA || nota->tecla != tecla) continue;
+        if (fabsf(agoraMs - (float)nota->hitTime) <= HIT_WINDOW_OK_MS) return nota;
+    }
+    return NULL;
+}
+
+static void benchParser(SDL_Renderer* renderer, const char* nome, const char* caminho,
+                        int repeticoes, double baseMs, Fase** faseOut) {
+    double melhor = 1e30, soma = 0.0;
+    int notas = 0;
+    for (int r = 0; r < repeticoes; ++r) {
+        double t0 = agoraMs();
+        Fase* fase = Fase_CarregarDeArquivo(renderer, caminho);
+        double ms = agoraMs() - t0;
+        if (!fase) return;
+        notas = fase->totalNotas;
+        if (ms < melhor) melhor = ms;
+        soma += ms;
+        if (r == repeticoes - 1 && faseOut) *faseOut = fase;
+        else Fase_Liberar(fase);
+    }
+    double parse = melhor - baseMs;
+    if (parse < 0.0) parse = 0.0;
+    printf("{\"bench\":\"parser\",\"chart\":\"%s\",\"notas\":%d,\"reps\":%d,"
+           "\"ms_min\":%.3f,\"ms_med\":%.3f,\"ms_parse\":%.3f,\"notas_por_s\":%.0f}\n",
+           nome, notas, repeticoes, melhor, soma / repeticoes, parse,
+           parse > 0.0 ? notas / (parse / 1000.0) : 0.0);
+}
+
+// Fim do chart: alvo (ou fim da longa) da última nota
+static Uint32 fimDoChart(const Fase* fase) {
+    Uint32 fim = 0;
+    for (int i = 0; i < fase->totalNotas; ++i) {
+        Uint32 t = fase->beatmap[i].hitTime + fase->beatmap[i].duration;
+        if (t > fim) fim = t;
+    }
+    return fim;
+}
+
+// Trechos de BENCH_QUADROS espalhados do começo ao fim do chart (o último termina
+// depois da última nota): um chart de 100k notas dura mais de uma hora e o
+// custo do fim, com o beatmap todo já percorrido, é o que mais importa.
+static void benchUpdateEAcertos(Fase* fase, const char* nome) {
+    const Uint32 janelaMs = (Uint32)(BENCH_QUADROS * BENCH_DT * 1000.0f);
+    const Uint32 fim = fimDoChart(fase) + (Uint32)HIT_WINDOW_OK_MS + 1;
+    const Uint32 ultimoInicio = fim > janelaMs ? fim - janelaMs : 0;
+
+    double totalUpdate = 0.0, piorUpdate = 0.0, totalBusca = 0.0;
+    int buscas = 0, processadas = 0;
+    for (int j = 0; j < BENCH_JANELAS; ++j) {
+        Uint32 inicio = (Uint32)((Uint64)ultimoInicio * j / (BENCH_JANELAS - 1));
+
+        // Aquecimento: o primeiro quadro faz surgir (e perder) tudo o que vem
+        // antes do trecho de uma vez, o que não acontece no jogo
+        reiniciarFase(fase);
+        for (int q = -BENCH_AQUECIMENTO; q < 0; ++q) {
+            Sint64 t = (Sint64)inicio + (Sint64)(q * BENCH_DT * 1000.0f);
+            simularQuadro(fase, (Uint32)(t > 0 ? t : 0), BENCH_DT);
+        }
+        int surgidasAntes = fase->proximaNotaIndex;
+
+        for (int q = 0; q < BENCH_QUADROS; ++q) {
+            Uint32 tempo = inicio + (Uint32)(q * BENCH_DT * 1000.0f);
+
+            double t0 = agoraMs();
+            simularQuadro(fase, tempo, BENCH_DT);
+            double ms = agoraMs() - t0;
+            totalUpdate += ms;
+            if (ms > piorUpdate) piorUpdate = ms;
+
+            // Um "toque" perfeito para cada nota que cruzou o checker neste quadro
+            for (int i = 0; i < fase->proximaNotaIndex; ++i) {
+                Nota* n = &fase->beatmap[i];
+                if (n->estado != NOTA_ATIVA) continue;
+                if ((float)n->hitTime > tempo + BENCH_DT * 500.0f) continue;
+
+                double b0 = agoraMs();
+                Nota* alvo = buscarAcerto(fase, n->tecla, (float)tempo);
+                totalBusca += agoraMs() - b0;
+                buscas++;
+                if (alvo) alvo->estado = NOTA_ATINGIDA;
+            }
+        }
+        processadas += fase->proximaNotaIndex - surgidasAntes;
+    }
+
+    const int quadros = BENCH_JANELAS * BENCH_QUADROS;
+    printf("{\"bench\":\"update\",\"chart\":\"%s\",\"notas\":%d,\"janelas\":%d,\"quadros\":%d,"
+           "\"chart_ms\":%u,\"notas_processadas\":%d,\"us_por_quadro\":%.3f,\"us_pior_quadro\":%.3f}\n",
+           nome, fase->totalNotas, BENCH_JANELAS, quadros, (unsigned)fim, processadas,
+           totalUpdate * 1000.0 / quadros, piorUpdate * 1000.0);
+    printf("{\"bench\":\"busca_acerto\",\"chart\":\"%s\",\"notas\":%d,\"buscas\":%d,"
+           "\"us_por_busca\":%.3f}\n",
+           nome, fase->totalNotas, buscas, buscas ? totalBusca * 1000.0 / buscas : 0.0);
+}
+
+static void benchRender(SDL_Renderer* renderer, Fase* fase, const char* nome) {
+    reiniciarFase(fase);
+
+    double total = 0.0;
+    long desenhadas = 0;
+    for (int q = 0; q < BENCH_QUADROS_RENDER; ++q) {
+        Uint32 tempo = (Uint32)(q * BENCH_DT * 1000.0f);
+        simularQuadro(fase, tempo, BENCH_DT);
+
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+        SDL_RenderClear(renderer);
+
+        double t0 = agoraMs();
+        for (int i = 0; i < fase->totalNotas; ++i) {
+            Nota* nota = &fase->beatmap[i];
+            if (nota->estado != NOTA_INATIVA && nota->estado != NOTA_ATINGIDA) desenhadas++;
+            Note_Render(nota, renderer, Note_CheckerX(nota->tecla));
+        }
+        SDL_RenderPresent(renderer);
+        total += agoraMs() - t0;
+    }
+
+    printf("{\"bench\":\"note_render\",\"chart\":\"%s\",\"notas\":%d,\"quadros\":%d,"
+           "\"us_por_quadro\":%.3f,\"notas_visiveis_media\":%.1f,\"renderer\":\"software\"}\n",
+           nome, fase->totalNotas, BENCH_QUADROS_RENDER,
+           total * 1000.0 / BENCH_QUADROS_RENDER, (double)desenhadas / BENCH_QUADROS_RENDER);
+}
+
+// Especial contínuo: emissão na taxa do jogo até o orçamento encher
+static void benchConfetes(SDL_Renderer* renderer) {
+    Arena arena;
+    if (!Arena_Init(&arena, Confetti_ArenaSize())) return;
+    if (!Confetti_Init(&arena)) { Arena_Free(&arena); return; }
+
+    double totalUpdate = 0.0, totalRender = 0.0;
+    long vivas = 0;
+    for (int q = 0; q < BENCH_QUADROS_CONFETES; ++q) {
+        double t0 = agoraMs();
+        Confetti_Emit(BENCH_DT);
+        Confetti_Update(BENCH_DT);
+        double t1 = agoraMs();
+
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+        SDL_RenderClear(renderer);
+        double t2 = agoraMs();
+        Confetti_Render(renderer);
+        SDL_RenderPresent(renderer);
+        totalRender += agoraMs() - t2;
+        totalUpdate += t1 - t0;
+        vivas += Confetti_Count();
+    }
+
+    printf("{\"bench\":\"confetes\",\"orcamento\":%d,\"quadros\":%d,\"vivas_media\":%.1f,"
+           "\"us_update\":%.3f,\"us_render\":%.3f,\"renderer\":\"software\"}\n",
+           CONFETTI_MAX, BENCH_QUADROS_CONFETES, (double)vivas / BENCH_QUADROS_CONFETES,
+           totalUpdate * 1000.0 / BENCH_QUADROS_CONFETES, totalRender * 1000.0 / BENCH_QUADROS_CONFETES);
+    Confetti_Shutdown();
+    Arena_Free(&arena);
+}
+
+static int gerarSomente(int argc, char* argv[]) {
+    const char* caminho = NULL;
+    ChartGenParams p = { 1000, 8.0f, 0.1f, 0.1f, 1u };
+    for (int i = 1; i < argc; ++i) {
+        if      (strcmp(argv[i], "--gerar") == 0     && i + 1 < argc) caminho = argv[++i];
+        else if (strcmp(argv[i], "--notas") == 0     && i + 1 < argc) p.totalNotas = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--densidade") == 0 && i + 1 < argc) p.notasPorSegundo = (float)atof(argv[++i]);
+        else if (strcmp(argv[i], "--longas") == 0    && i + 1 < argc) p.proporcaoLongas = (float)atof(argv[++i]);
+        else if (strcmp(argv[i], "--acordes") == 0   && i + 1 < argc) p.proporcaoAcordes = (float)atof(argv[++i]);
+        else if (strcmp(argv[i], "--semente") == 0   && i + 1 < argc) p.semente = (unsigned int)strtoul(argv[++i], NULL, 10);
+    }
+    if (!caminho) return 1;
+    return ChartGen_Escrever(caminho, &p) ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--gerar") == 0) return gerarSomente(argc, argv);
+    }
+
+    // Sem janela e sem placa de som: renderer por software e driver de áudio nulo
+    SDL_setenv("SDL_AUDIODRIVER", "dummy", 1);
+    if (SDL_Init(SDL_INIT_AUDIO) < 0) {
+        printf("ERRO: SDL nao pode inicializar! SDL_Error: %s\n", SDL_GetError());
+        return 1;
+    }
+    IMG_Init(IMG_INIT_PNG | IMG_INIT_JPG);
+    if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048) < 0) {
+        printf("ERRO: SDL_mixer nao pode inicializar! Mix_Error: %s\n", Mix_GetError());
+        return 1;
+    }
+
+    SDL_Surface* alvo = SDL_CreateRGBSurfaceWithFormat(0, SCREEN_WIDTH, SCREEN_HEIGHT, 32, SDL_PIXELFORMAT_ARGB8888);
+    SDL_Renderer* renderer = alvo ? SDL_CreateSoftwareRenderer(alvo) : NULL;
+    if (!renderer) {
+        printf("ERRO: renderer por software indisponivel: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    s_msPorTick = 1000.0 / (double)SDL_GetPerformanceFrequency();
+    printf("{\"bench\":\"meta\",\"versao\":%d,\"quadro_ms\":%.3f}\n", BENCH_VERSAO, BENCH_DT * 1000.0f);
+
+    // Custo fixo de carregar música e texturas, descontado do parser
+    ChartGenParams vazio = { 0, 1.0f, 0.0f, 0.0f, 1u };
+    const char* caminhoVazio = "output/bench_vazio.samba";
+    double baseMs = 0.0;
+    if (ChartGen_Escrever(caminhoVazio, &vazio)) {
+        double melhor = 1e30;
+        for (int r = 0; r < 5; ++r) {
+            double t0 = agoraMs();
+            Fase* f = Fase_CarregarDeArquivo(renderer, caminhoVazio);
+            double ms = agoraMs() - t0;
+            if (f) Fase_Liberar(f);
+            if (ms < melhor) melhor = ms;
+        }
+        baseMs = melhor;
+        printf("{\"bench\":\"parser_base\",\"ms_min\":%.3f}\n", baseMs);
+    }
+
+    for (size_t c = 0; c < SDL_arraysize(s_cenarios); ++c) {
+        const Cenario* cen = &s_cenarios[c];
+        char nome[64], caminho[128];
+        ChartGen_Nome(&cen->params, nome, sizeof(nome));
+        snprintf(caminho, sizeof(caminho), "output/bench_%s.samba", nome);
+        if (!ChartGen_Escrever(caminho, &cen->params)) continue;
+
+        Fase* fase = NULL;
+        benchParser(renderer, nome, caminho, cen->repeticoesParser, baseMs, &fase);
+        if (!fase) continue;
+
+        benchUpdateEAcertos(fase, nome);
+        benchRender(renderer, fase, nome);
+        Fase_Liberar(fase);
+        fflush(stdout);
+    }
+
+    benchConfetes(renderer);
+
+    SDL_DestroyRenderer(renderer);
+    SDL_FreeSurface(alvo);
+    Mix_CloseAudio();
+    Mix_Quit();
+    IMG_Quit();
+    SDL_Quit();
+    return 0;
+}
@@ -0,0 +1,71 @@
+#include "chartgen.h"
+#include <stdio.h>
+
+// Gerador próprio (xorshift32) para o chart não depender da libc da máquina
+static unsigned int proximo(unsigned int* estado) {
+    unsigned int x = *estado;
+    x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+    return *estado = x;
+}
+
+static float uniforme(unsigned int* estado) {
+    return (proximo(estado) >> 8) * (1.0f / 16777216.0f);
+}
+
+void ChartGen_Nome(const ChartGenParams* p, char* out, int tamanho) {
+    snprintf(out, tamanho, "n%d_d%g_l%d_c%d", p->totalNotas, p->notasPorSegundo,
+             (int)(p->proporcaoLongas * 100.0f + 0.5f), (int)(p->proporcaoAcordes * 100.0f + 0.5f));
+}
+
+bool ChartGen_Escrever(const char* caminho, const ChartGenParams* p) {
+    FILE* f = fopen(caminho, "w");
+    if (!f) {
+        printf("Erro: Nao foi possivel criar o chart sintetico: %s\n", caminho);
+        return false;
+    }
+
+    unsigned int estado = p->semente ? p->semente : 1u;
+    const char teclas[3] = { 'z', 'x', 'c' };
+    const float intervaloMedio = 1000.0f / (p->notasPorSegundo > 0.0f ? p->notasPorSegundo : 1.0f);
+    unsigned int livreAte[3] = {0, 0, 0}; // fim da nota longa ocupando cada pista
+
+    // Duração estimada para o cabeçalho; o jogo encerra a fase ao atingi-la.
+    unsigned int duracao = (unsigned int)(p->totalNotas * intervaloMedio) + 8000u;
+
+    fprintf(f, "# Chart sintetico gerado pelo benchmark\n");
+    fprintf(f, "MUSICA:assets/music/MeuLugar_ArlindoCruz.mp3\n");
+    fprintf(f, "BACKGROUND:assets/image/meuLugarBG.png\n");
+    fprintf(f, "RHYTHMTRACK:assets/image/rhythmTrack.png\n");
+    fprintf(f, "DURACAO_MS:%u\n", duracao);
+    fprintf(f, "---\n");
+
+    double tempo = 500.0;
+    int escritas = 0;
+    while (escritas < p->totalNotas) {
+        // Intervalo com variação de ±50% em torno da média, em passos de 1 ms
+        tempo += intervaloMedio * (0.5f + uniforme(&estado));
+        unsigned int t = (unsigned int)tempo;
+
+        int notasNoEvento = 1;
+        if (uniforme(&estado) < p->proporcaoAcordes) notasNoEvento = 2 + (int)(uniforme(&estado) * 2.0f);
+
+        int primeira = (int)(uniforme(&estado) * 3.0f) % 3;
+        for (int k = 0; k < 3 && notasNoEvento > 0 && escritas < p->totalNotas; ++k) {
+            int pista = (primeira + k) % 3;
+            if (livreAte[pista] > t) continue; // pista ainda segurando uma longa
+
+            if (uniforme(&estado) < p->proporcaoLongas) {
+                unsigned int dur = 200u + (unsigned int)(uniforme(&estado) * 1300.0f);
+                fprintf(f, "l,%c,%u,%u\n", teclas[pista], t, dur);
+                livreAte[pista] = t + dur + 50u;
+            } else {
+                fprintf(f, "n,%c,%u\n", teclas[pista], t);
+            }
+            notasNoEvento--;
+            escritas++;
+        }
+    }
+
+    fclose(f);
+    return true;
+}
@@ -0,0 +1,22 @@
+#ifndef CHARTGEN_H
+#define CHARTGEN_H
+
+#include <stdbool.h>
+
+// Parâmetros do gerador de charts sintéticos (.samba) usados no benchmark
+typedef struct {
+    int   totalNotas;        // quantidade de notas a gerar
+    float notasPorSegundo;   // densidade média de eventos (acordes contam como um evento)
+    float proporcaoLongas;   // 0..1: chance de uma nota ser longa
+    float proporcaoAcordes;  // 0..1: chance de um evento virar acorde de 2 ou 3 pistas
+    unsigned int semente;
+} ChartGenParams;
+
+// Escreve um .samba completo (cabeçalho + beatmap) em 'caminho'.
+// O cabeçalho aponta para assets reais do jogo, então o arquivo abre normalmente.
+bool ChartGen_Escrever(const char* caminho, const ChartGenParams* p);
+
+// Nome curto e estável para identificar o cenário na saída do benchmark.
+void ChartGen_Nome(const ChartGenParams* p, char* out, int tamanho);
+
+#endif // CHARTGEN_H
@@ -0,0 +1,161 @@
+#include "autoplay.h"
+#include "defs.h"
+#include <string.h>
+
+// Parâmetros do modo humano (em ms; positivo = adiantado)
+#define AUTOPLAY_HUMANO_MEDIA_MS    4.0f
+#define AUTOPLAY_HUMANO_DESVIO_MS   15.0f
+#define AUTOPLAY_HUMANO_CHANCE_ERRO 100 // 1 nota em cada 100 é ignorada
+
+#define AUTOPLAY_MAX_EVENTOS 32
+
+static AutoplayMode s_modo = AUTOPLAY_DESLIGADO;
+static Uint32       s_semente = 0;
+
+static Uint8* s_tocada = NULL;             // 1 = já apertou (ou desistiu) desta nota (na arena)
+static int    s_capacidade = 0;
+static int    s_cursor = 0;               // primeira nota que ainda pode precisar de toque
+static int    s_segurando[3] = {-1, -1, -1}; // índice da nota longa segura em cada pista
+
+static SDL_Event s_fila[AUTOPLAY_MAX_EVENTOS];
+static int       s_filaInicio = 0;
+static int       s_filaTamanho = 0;
+
+static int pistaDaTecla(SDL_Keycode tecla) {
+    switch (tecla) {
+        case SDLK_z: return 0;
+        case SDLK_x: return 1;
+        case SDLK_c: return 2;
+    }
+    return -1;
+}
+
+// Hash inteiro (nota, canal) -> [0,1). Não depende da ordem dos frames,
+// então a mesma semente reproduz a mesma partida em qualquer máquina.
+static float aleatorioDaNota(int indice, Uint32 canal) {
+    Uint32 h = s_semente ^ ((Uint32)indice * 2654435761u) ^ (canal * 0x9E3779B9u);
+    h ^= h >> 16; h *= 0x7FEB352Du;
+    h ^= h >> 15; h *= 0x846CA68Bu;
+    h ^= h >> 16;
+    return (h >> 8) * (1.0f / 16777216.0f);
+}
+
+// Desvio de tempo (ms, positivo = adiantado) de um toque/soltura.
+// Soma de três uniformes ~ normal, suficiente para parecer gente.
+static float desvioEmMs(int indice, Uint32 canal) {
+    if (s_modo != AUTOPLAY_HUMANO) return 0.0f;
+    float soma = aleatorioDaNota(indice, canal * 3 + 0)
+               + aleatorioDaNota(indice, canal * 3 + 1)
+               + aleatorioDaNota(indice, canal * 3 + 2);
+    float z  = (soma - 1.5f) * 2.0f;
+    return AUTOPLAY_HUMANO_MEDIA_MS + AUTOPLAY_HUMANO_DESVIO_MS * z;
+}
+
+static void enfileirar(Uint32 tipo, SDL_Keycode tecla) {
+    if (s_filaTamanho >= AUTOPLAY_MAX_EVENTOS) return;
+
+    SDL_Event e;
+    memset(&e, 0, sizeof(e));
+    e.type = tipo;
+    e.key.timestamp = SDL_GetTicks();
+    e.key.state = (tipo == SDL_KEYDOWN) ? SDL_PRESSED : SDL_RELEASED;
+    e.key.repeat = 0;
+    e.key.keysym.sym = tecla;
+
+    s_fila[(s_filaInicio + s_filaTamanho) % AUTOPLAY_MAX_EVENTOS] = e;
+    s_filaTamanho++;
+}
+
+void Autoplay_Reset(AutoplayMode modo, Uint32 semente, int capacidade, Arena* arena) {
+    s_modo = modo;
+    s_semente = semente;
+    s_tocada = NULL;
+    s_capacidade = 0;
+    if (modo != AUTOPLAY_DESLIGADO && capacidade > 0) {
+        s_tocada = (Uint8*)Arena_Alloc(arena, (size_t)capacidade, 1);
+        if (s_tocada) s_capacidade = capacidade;
+        else          s_modo = AUTOPLAY_DESLIGADO;
+    }
+    s_cursor = 0;
+    for (int i = 0; i < 3; ++i) s_segurando[i] = -1;
+    s_filaInicio = 0;
+    s_filaTamanho = 0;
+}
+
+void Autoplay_Resync(const Fase* fase) {
+    if (s_modo == AUTOPLAY_DESLIGADO || !s_tocada) return;
+
+    // Notas já resolvidas voltam a ser marcadas no próximo update (estado != ATIVA)
+    memset(s_tocada, 0, (size_t)s_capacidade);
+    s_cursor = 0;
+    for (int pista = 0; pista < 3; ++pista) {
+        if (s_segurando[pista] < 0) continue;
+        s_segurando[pista] = -1;
+        for (int i = 0; i < fase->totalNotas; ++i) {
+            const Nota* nota = &fase->beatmap[i];
+            if (nota->estado == NOTA_SEGURANDO && pistaDaTecla(nota->tecla) == pista) {
+                s_segurando[pista] = i;
+                s_tocada[i] = 1;
+                break;
+            }
+        }
+    }
+}
+
+void Autoplay_Update(const Fase* fase, Uint32 tempoAtual, float deltaTime) {
+    if (s_modo == AUTOPLAY_DESLIGADO || !fase || fase->totalNotas > s_capacidade) return;
+
+    // Meio frame adiante: apertando dentro dessa margem, o modo perfeito
+    // nunca fica a mais de meio frame do alvo.
+    const float agora = (float)tempoAtual + deltaTime * 500.0f;
+
+    // 1) Solta as notas longas cuja cauda chegou ao checker
+    for (int pista = 0; pista < 3; ++pista) {
+        int idx = s_segurando[pista];
+        if (idx < 0) continue;
+
+        const Nota* nota = &fase->beatmap[idx];
+        if (nota->estado == NOTA_ATIVA) continue; // o toque ainda está na fila
+        if (nota->estado != NOTA_SEGURANDO) { s_segurando[pista] = -1; continue; }
+
+        if ((float)(nota->hitTime + nota->duration) - agora <= desvioEmMs(idx, 1)) {
+            enfileirar(SDL_KEYUP, nota->tecla);
+            s_segurando[pista] = -1;
+        }
+    }
+
+    // 2) Aperta as notas que chegaram ao alvo (as notas nascem em ordem)
+    while (s_cursor < fase->totalNotas && s_tocada[s_cursor]) s_cursor++;
+
+    for (int i = s_cursor; i < fase->proximaNotaIndex; ++i) {
+        if (s_tocada[i]) continue;
+
+        const Nota* nota = &fase->beatmap[i];
+        if (nota->estado != NOTA_ATIVA) { s_tocada[i] = 1; continue; } // já resolvida pelo jogo
+
+        int pista = pistaDaTecla(nota->tecla);
+        if (pista < 0) { s_tocada[i] = 1; continue; }
+        if (s_segurando[pista] >= 0) continue; // mão ocupada segurando outra nota
+
+        if (s_modo == AUTOPLAY_HUMANO &&
+            (int)(aleatorioDaNota(i, 7) * AUTOPLAY_HUMANO_CHANCE_ERRO) == 0) {
+            s_tocada[i] = 1; // "esqueceu" esta nota
+            continue;
+        }
+
+        if ((float)nota->hitTime - agora <= desvioEmMs(i, 0)) {
+            enfileirar(SDL_KEYDOWN, nota->tecla);
+            s_tocada[i] = 1;
+            if (nota->duration > 0) s_segurando[pista] = i;
+            else                    enfileirar(SDL_KEYUP, nota->tecla);
+        }
+    }
+}
+
+int Autoplay_PollEvent(SDL_Event* e) {
+    if (s_filaTamanho == 0) return 0;
+    *e = s_fila[s_filaInicio];
+    s_filaInicio = (s_filaInicio + 1) % AUTOPLAY_MAX_EVENTOS;
+    s_filaTamanho--;
+    return 1;
+}
@@ -0,0 +1,32 @@
+#ifndef AUTOPLAY_H
+#define AUTOPLAY_H
+
+#include <SDL2/SDL.h>
+#include "stage.h"
+#include "auxFuncs/arena.h"
+
+// Modos do bot que toca sozinho (demo, attract e medição de desempenho)
+typedef enum {
+    AUTOPLAY_DESLIGADO,
+    AUTOPLAY_PERFEITO,  // aperta exatamente no alvo
+    AUTOPLAY_HUMANO     // erra alguns ms para os dois lados, de forma repetível
+} AutoplayMode;
+
+// Prepara o bot para uma nova partida. A mesma semente gera sempre os mesmos desvios.
+// As marcas por nota (capacidade bytes) saem da arena da sessão; o bot só
+// toca fases com até 'capacidade' notas.
+void Autoplay_Reset(AutoplayMode modo, Uint32 semente, int capacidade, Arena* arena);
+
+// O beatmap da fase foi trocado (recarga do chart): os índices antigos não
+// valem mais. Esquece as marcas e reencontra as notas longas seguras.
+void Autoplay_Resync(const Fase* fase);
+
+// Decide, após o update das notas, quais teclas apertar/soltar e enfileira os eventos.
+// 'tempoAtual' é o tempo da música do frame (o mesmo do julgamento).
+void Autoplay_Update(const Fase* fase, Uint32 tempoAtual, float deltaTime);
+
+// Retira o próximo evento sintético da fila (mesma ideia do SDL_PollEvent).
+// Retorna 1 se preencheu 'e', 0 se a fila está vazia.
+int Autoplay_PollEvent(SDL_Event* e);
+
+#endif // AUTOPLAY_H
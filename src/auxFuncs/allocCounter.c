@@ -0,0 +1,74 @@
+#include "allocCounter.h"
+#include <SDL2/SDL.h>
+#include <stdio.h>
+
+#ifdef DEBUG_ALOCACOES
+
+static SDL_malloc_func  s_mallocOriginal;
+static SDL_calloc_func  s_callocOriginal;
+static SDL_realloc_func s_reallocOriginal;
+static SDL_free_func    s_freeOriginal;
+
+static bool         s_instalado = false;
+static bool         s_observando = false;
+static SDL_threadID s_thread = 0;
+static int          s_contagem = 0;
+static size_t       s_bytes = 0;
+
+static void registrar(size_t tamanho) {
+    if (s_observando && SDL_ThreadID() == s_thread) {
+        s_contagem++;
+        s_bytes += tamanho;
+    }
+}
+
+static void* contarMalloc(size_t tamanho) {
+    registrar(tamanho);
+    return s_mallocOriginal(tamanho);
+}
+
+static void* contarCalloc(size_t n, size_t tamanho) {
+    registrar(n * tamanho);
+    return s_callocOriginal(n, tamanho);
+}
+
+static void* contarRealloc(void* p, size_t tamanho) {
+    registrar(tamanho);
+    return s_reallocOriginal(p, tamanho);
+}
+
+void AllocCounter_Install(void) {
+    if (s_instalado) return;
+    SDL_GetMemoryFunctions(&s_mallocOriginal, &s_callocOriginal, &s_reallocOriginal, &s_freeOriginal);
+    s_instalado = SDL_SetMemoryFunctions(contarMalloc, contarCalloc, contarRealloc, s_freeOriginal) == 0;
+    if (!s_instalado) printf("Aviso: contador de alocacoes indisponivel: %s\n", SDL_GetError());
+}
+
+void AllocCounter_Begin(void) {
+    if (!s_instalado) return;
+    s_thread = SDL_ThreadID();
+    s_contagem = 0;
+    s_bytes = 0;
+    s_observando = true;
+}
+
+int AllocCounter_End(const char* onde) {
+    if (!s_observando) return 0;
+    s_observando = false;
+    if (s_contagem > 0) {
+        printf("ALOCACOES: %d alocacoes (%zu bytes) durante a partida, ate '%s'.\n", s_contagem, s_bytes, onde);
+    }
+    SDL_assert(s_contagem == 0);
+    return s_contagem;
+}
+
+bool AllocCounter_IsWatching(void) { return s_observando; }
+
+#else
+
+void AllocCounter_Install(void) {}
+void AllocCounter_Begin(void) {}
+int  AllocCounter_End(const char* onde) { (void)onde; return 0; }
+bool AllocCounter_IsWatching(void) { return false; }
+
+#endif // DEBUG_ALOCACOES
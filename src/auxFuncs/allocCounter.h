@@ -0,0 +1,24 @@
+#ifndef ALLOC_COUNTER_H
+#define ALLOC_COUNTER_H
+
+#include <stdbool.h>
+
+// Contador de alocações de depuração. Conta toda alocação que passa pelo
+// SDL_malloc/calloc/realloc (SDL, SDL_ttf, SDL_image, SDL_mixer e drivers de render)
+// feita pela thread que abriu a janela de observação.
+//
+// Só existe com -DDEBUG_ALOCACOES (make DEBUG=1); sem ele as funções não fazem nada.
+
+// Instala os ganchos de memória. Chamar no começo do main, antes do SDL_Init.
+void AllocCounter_Install(void);
+
+// Abre a janela em que nenhuma alocação é esperada (início da música).
+void AllocCounter_Begin(void);
+
+// Fecha a janela (resultados, fim de jogo ou saída). Dispara SDL_assert se
+// houve alocação. 'onde' aparece na mensagem. Retorna quantas foram contadas.
+int AllocCounter_End(const char* onde);
+
+bool AllocCounter_IsWatching(void);
+
+#endif // ALLOC_COUNTER_H
@@ -0,0 +1,40 @@
+#include "arena.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+bool Arena_Init(Arena* arena, size_t capacidade) {
+    arena->base = (Uint8*)malloc(capacidade);
+    arena->capacidade = arena->base ? capacidade : 0;
+    arena->usado = 0;
+    return arena->base != NULL;
+}
+
+void Arena_Free(Arena* arena) {
+    free(arena->base);
+    arena->base = NULL;
+    arena->capacidade = 0;
+    arena->usado = 0;
+}
+
+void* Arena_Alloc(Arena* arena, size_t tamanho, size_t alinhamento) {
+    if (!arena->base) return NULL;
+
+    uintptr_t inicio = (uintptr_t)(arena->base + arena->usado);
+    uintptr_t alinhado = (inicio + (alinhamento - 1)) & ~(uintptr_t)(alinhamento - 1);
+    size_t deslocamento = (size_t)(alinhado - (uintptr_t)arena->base);
+    if (deslocamento > arena->capacidade || tamanho > arena->capacidade - deslocamento) {
+        printf("Erro: arena sem espaco (%zu de %zu bytes usados, pedido de %zu).\n",
+               arena->usado, arena->capacidade, tamanho);
+        return NULL;
+    }
+
+    arena->usado = deslocamento + tamanho;
+    memset((void*)alinhado, 0, tamanho);
+    return (void*)alinhado;
+}
+
+void Arena_Reset(Arena* arena) {
+    arena->usado = 0;
+}
@@ -0,0 +1,28 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Alocador linear: um único bloco reservado na carga, do qual os módulos tiram
+// memória só avançando um ponteiro. Nada é liberado individualmente; o bloco
+// inteiro é descartado (Arena_Free) ou reaproveitado (Arena_Reset) de uma vez.
+typedef struct {
+    Uint8* base;
+    size_t capacidade;
+    size_t usado;
+} Arena;
+
+// Reserva 'capacidade' bytes. Retorna false se faltou memória.
+bool Arena_Init(Arena* arena, size_t capacidade);
+void Arena_Free(Arena* arena);
+
+// Devolve 'tamanho' bytes zerados, alinhados a 'alinhamento' (potência de 2),
+// ou NULL se a arena não tem espaço.
+void* Arena_Alloc(Arena* arena, size_t tamanho, size_t alinhamento);
+
+// Esquece tudo que foi alocado, mantendo o bloco.
+void Arena_Reset(Arena* arena);
+
+#endif // ARENA_H
@@ -0,0 +1,175 @@
+#include "assetPack.h"
+#include "utils.h"
+#include <SDL2/SDL_image.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <sys/stat.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+static const Uint8* s_base = NULL;   // o pacote inteiro (mapeado ou lido)
+static size_t       s_tamanho = 0;
+static Sint64       s_data = 0;      // mtime do pacote
+static bool         s_mapeado = false;
+static Uint32       s_total = 0;
+static const Uint8* s_indice = NULL;
+static const Uint8* s_nomes = NULL;
+
+// Caminhos entram no pacote como "assets/..."; "./assets/..." é o mesmo arquivo
+static const char* normalizar(const char* caminho) {
+    while (caminho[0] == '.' && caminho[1] == '/') caminho += 2;
+    return caminho;
+}
+
+static void liberarBase(void) {
+    if (!s_base) return;
+#ifndef _WIN32
+    if (s_mapeado) munmap((void*)s_base, s_tamanho);
+    else           SDL_free((void*)s_base);
+#else
+    SDL_free((void*)s_base);
+#endif
+    s_base = NULL;
+    s_tamanho = 0;
+    s_mapeado = false;
+}
+
+static bool validar(void) {
+    if (s_tamanho < ASSETPACK_CABECALHO || memcmp(s_base, ASSETPACK_MAGICO, 4) != 0) return false;
+    if (GetU32LE(s_base + 4) != ASSETPACK_VERSAO) return false;
+
+    Uint64 total = GetU32LE(s_base + 8);
+    Uint64 bytesNomes = GetU32LE(s_base + 12);
+    Uint64 fimIndice = ASSETPACK_CABECALHO + total * ASSETPACK_ENTRADA + bytesNomes;
+    if (fimIndice > s_tamanho) return false;
+    if (Fnv1a32(s_base + ASSETPACK_CABECALHO, (size_t)(fimIndice - ASSETPACK_CABECALHO)) != GetU32LE(s_base + 16))
+        return false;
+
+    s_total  = (Uint32)total;
+    s_indice = s_base + ASSETPACK_CABECALHO;
+    s_nomes  = s_indice + total * ASSETPACK_ENTRADA;
+
+    // Nenhuma entrada pode apontar para fora do arquivo
+    for (Uint32 i = 0; i < s_total; ++i) {
+        const Uint8* e = s_indice + (size_t)i * ASSETPACK_ENTRADA;
+        Uint64 offset = GetU64LE(e + 8), tamanho = GetU64LE(e + 16);
+        Uint64 nomeOffset = GetU32LE(e + 24), nomeTamanho = GetU32LE(e + 28);
+        if (offset > s_tamanho || tamanho > s_tamanho - offset) return false;
+        if (nomeOffset + nomeTamanho > bytesNomes) return false;
+    }
+    return true;
+}
+
+bool AssetPack_Open(const char* caminho) {
+    AssetPack_Close();
+
+#ifndef _WIN32
+    int fd = open(caminho, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        void* mapa = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapa != MAP_FAILED) {
+            // Pede ao kernel o arquivo inteiro de uma vez, em leitura sequencial
+            madvise(mapa, (size_t)st.st_size, MADV_WILLNEED);
+            s_base = (const Uint8*)mapa;
+            s_tamanho = (size_t)st.st_size;
+            s_mapeado = true;
+            s_data = (Sint64)st.st_mtime;
+        }
+    }
+    close(fd); // o mapeamento continua válido sem o descritor
+#else
+    s_base = (const Uint8*)SDL_LoadFile(caminho, &s_tamanho); // sem mmap: uma leitura só
+    struct stat st;
+    s_data = stat(caminho, &st) == 0 ? (Sint64)st.st_mtime : 0;
+#endif
+    if (!s_base) return false;
+
+    if (!validar()) {
+        printf("Aviso: pacote '%s' invalido; usando os arquivos soltos.\n", caminho);
+        AssetPack_Close();
+        return false;
+    }
+    printf("Pacote '%s': %u arquivos, %zu bytes.\n", caminho, s_total, s_tamanho);
+    return true;
+}
+
+void AssetPack_Close(void) {
+    liberarBase();
+    s_total = 0;
+    s_indice = s_nomes = NULL;
+}
+
+bool AssetPack_Find(const char* caminho, const void** dados, size_t* tamanho) {
+    if (!s_base || s_total == 0) return false;
+
+    caminho = normalizar(caminho);
+    size_t len = strlen(caminho);
+    Uint64 hash = Fnv1a64(caminho, len);
+
+    // Primeira entrada com hash >= o procurado
+    Uint32 lo = 0, hi = s_total;
+    while (lo < hi) {
+        Uint32 meio = lo + (hi - lo) / 2;
+        if (GetU64LE(s_indice + (size_t)meio * ASSETPACK_ENTRADA) < hash) lo = meio + 1;
+        else hi = meio;
+    }
+    for (Uint32 i = lo; i < s_total; ++i) {
+        const Uint8* e = s_indice + (size_t)i * ASSETPACK_ENTRADA;
+        if (GetU64LE(e) != hash) break;
+        if (GetU32LE(e + 28) == len && memcmp(s_nomes + GetU32LE(e + 24), caminho, len) == 0) {
+            *dados = s_base + GetU64LE(e + 8);
+            *tamanho = (size_t)GetU64LE(e + 16);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Asset_Stat(const char* caminho, Uint64* tamanho, Sint64* data) {
+    const void* dados;
+    size_t t;
+    if (AssetPack_Find(caminho, &dados, &t)) {
+        *tamanho = (Uint64)t;
+        *data = s_data;
+        return true;
+    }
+    struct stat st;
+    if (stat(caminho, &st) != 0) return false;
+    *tamanho = (Uint64)st.st_size;
+    *data = (Sint64)st.st_mtime;
+    return true;
+}
+
+SDL_RWops* Asset_RW(const char* caminho) {
+    const void* dados;
+    size_t tamanho;
+    if (AssetPack_Find(caminho, &dados, &tamanho)) return SDL_RWFromConstMem(dados, (int)tamanho);
+    return SDL_RWFromFile(caminho, "rb");
+}
+
+SDL_Surface* Asset_LoadSurface(const char* caminho) {
+    SDL_RWops* rw = Asset_RW(caminho);
+    return rw ? IMG_Load_RW(rw, 1) : NULL;
+}
+
+Mix_Music* Asset_LoadMUS(const char* caminho) {
+    SDL_RWops* rw = Asset_RW(caminho);
+    return rw ? Mix_LoadMUS_RW(rw, 1) : NULL;
+}
+
+Mix_Chunk* Asset_LoadWAV(const char* caminho) {
+    SDL_RWops* rw = Asset_RW(caminho);
+    return rw ? Mix_LoadWAV_RW(rw, 1) : NULL;
+}
+
+TTF_Font* Asset_OpenFont(const char* caminho, int tamanho) {
+    SDL_RWops* rw = Asset_RW(caminho);
+    return rw ? TTF_OpenFontRW(rw, 1, tamanho) : NULL;
+}
@@ -0,0 +1,51 @@
+#ifndef ASSET_PACK_H
+#define ASSET_PACK_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_mixer.h>
+#include <SDL2/SDL_ttf.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Pacote de assets: um arquivo só (gerado por `make pack`) com um índice e os
+// arquivos de assets/ alinhados. Na inicialização ele é mapeado em memória e os
+// loaders abaixo leem direto do mapeamento (SDL_RWFromConstMem), sem cópia: uma
+// leitura sequencial no lugar de dezenas de open() numa partida a frio.
+// Sem pacote, ou para um arquivo que não está nele, tudo cai no arquivo solto.
+// Charts, config e recordes continuam soltos: são editados e regravados.
+//
+// Formato (little-endian):
+//   cabeçalho  "SBPK", versão, total de entradas, bytes de nomes, FNV-1a 32 do índice+nomes
+//   índice     por entrada: hash do caminho (FNV-1a 64), offset, tamanho, offset e
+//              tamanho do nome; em ordem de hash (busca binária)
+//   nomes      os caminhos ("assets/image/menuBG.png"), para confirmar o hash
+//   dados      cada arquivo começa num múltiplo de ASSETPACK_ALINHAMENTO
+#define ASSETPACK_PATH        "assets.pak"
+#define ASSETPACK_MAGICO      "SBPK"
+#define ASSETPACK_VERSAO      1
+#define ASSETPACK_CABECALHO   32
+#define ASSETPACK_ENTRADA     32
+#define ASSETPACK_ALINHAMENTO 64
+
+// Mapeia o pacote. Retorna false (e segue com os arquivos soltos) se ele não
+// existe ou não passa na verificação.
+bool AssetPack_Open(const char* caminho);
+// Desmapeia. Chamar depois de liberar tudo que foi aberto a partir do pacote
+// (fontes e músicas continuam lendo do mapeamento enquanto vivem).
+void AssetPack_Close(void);
+
+// Bytes do arquivo dentro do pacote. Seguro de qualquer thread depois do Open.
+bool AssetPack_Find(const char* caminho, const void** dados, size_t* tamanho);
+
+// Tamanho e data de um asset, para caches derivados dele. No pacote, a data
+// é a do próprio pacote (refazer o pacote invalida o que veio dele).
+bool Asset_Stat(const char* caminho, Uint64* tamanho, Sint64* data);
+
+// Leitura de um asset: do pacote se estiver nele, senão do disco
+SDL_RWops*   Asset_RW(const char* caminho);
+SDL_Surface* Asset_LoadSurface(const char* caminho);
+Mix_Music*   Asset_LoadMUS(const char* caminho);
+Mix_Chunk*   Asset_LoadWAV(const char* caminho);
+TTF_Font*    Asset_OpenFont(const char* caminho, int tamanho);
+
+#endif // ASSET_PACK_H
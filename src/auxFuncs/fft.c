@@ -0,0 +1,120 @@
+#include "fft.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+bool Fft_Init(Fft* fft, int n) {
+    memset(fft, 0, sizeof(*fft));
+    if (n < 8 || (n & (n - 1)) != 0) return false;
+
+    int meio = n / 2;
+    fft->n = n;
+    fft->meio = meio;
+    fft->janela  = (float*)malloc((size_t)n * sizeof(float));
+    fft->fatCos  = (float*)malloc((size_t)meio * sizeof(float));
+    fft->fatSin  = (float*)malloc((size_t)meio * sizeof(float));
+    fft->sepCos  = (float*)malloc((size_t)meio * sizeof(float));
+    fft->sepSin  = (float*)malloc((size_t)meio * sizeof(float));
+    fft->inverso = (int*)malloc((size_t)meio * sizeof(int));
+    fft->re      = (float*)malloc((size_t)meio * sizeof(float));
+    fft->im      = (float*)malloc((size_t)meio * sizeof(float));
+    if (!fft->janela || !fft->fatCos || !fft->fatSin || !fft->sepCos || !fft->sepSin ||
+        !fft->inverso || !fft->re || !fft->im) {
+        Fft_Free(fft);
+        return false;
+    }
+
+    for (int i = 0; i < n; ++i) fft->janela[i] = (float)(0.5 - 0.5 * cos(2.0 * M_PI * i / n));
+
+    // Estágio com meia-largura h usa h fatores e^{-iπj/h}, guardados a partir de h-1
+    for (int h = 1; h < meio; h *= 2) {
+        for (int j = 0; j < h; ++j) {
+            fft->fatCos[h - 1 + j] = (float)cos(M_PI * j / h);
+            fft->fatSin[h - 1 + j] = (float)-sin(M_PI * j / h);
+        }
+    }
+    for (int k = 0; k < meio; ++k) {
+        fft->sepCos[k] = (float)cos(2.0 * M_PI * k / n);
+        fft->sepSin[k] = (float)-sin(2.0 * M_PI * k / n);
+    }
+
+    int bits = 0;
+    while ((1 << bits) < meio) ++bits;
+    for (int i = 0; i < meio; ++i) {
+        int r = 0;
+        for (int b = 0; b < bits; ++b) if (i & (1 << b)) r |= 1 << (bits - 1 - b);
+        fft->inverso[i] = r;
+    }
+    return true;
+}
+
+void Fft_Free(Fft* fft) {
+    free(fft->janela);
+    free(fft->fatCos);
+    free(fft->fatSin);
+    free(fft->sepCos);
+    free(fft->sepSin);
+    free(fft->inverso);
+    free(fft->re);
+    free(fft->im);
+    memset(fft, 0, sizeof(*fft));
+}
+
+// Um grupo de borboletas: 'restrict' garante ao compilador que as metades não
+// se sobrepõem, então o laço é vetorizado sem verificação em tempo de execução.
+static void borboletas(float* restrict ar, float* restrict ai, float* restrict br, float* restrict bi,
+                       const float* restrict wc, const float* restrict ws, int h) {
+    for (int j = 0; j < h; ++j) {
+        float tr = br[j] * wc[j] - bi[j] * ws[j];
+        float ti = br[j] * ws[j] + bi[j] * wc[j];
+        br[j] = ar[j] - tr;
+        bi[j] = ai[j] - ti;
+        ar[j] += tr;
+        ai[j] += ti;
+    }
+}
+
+void Fft_Magnitudes(Fft* fft, const float* amostras, float* magnitudes) {
+    const int meio = fft->meio;
+    float* re = fft->re;
+    float* im = fft->im;
+
+    // Pares (par, ímpar) viram um complexo, já na ordem bit-reversa
+    for (int m = 0; m < meio; ++m) {
+        int d = fft->inverso[m];
+        re[d] = amostras[2 * m]     * fft->janela[2 * m];
+        im[d] = amostras[2 * m + 1] * fft->janela[2 * m + 1];
+    }
+
+    // Primeiro estágio: fator 1, só soma e subtração
+    for (int k = 0; k < meio; k += 2) {
+        float tr = re[k + 1], ti = im[k + 1];
+        re[k + 1] = re[k] - tr; im[k + 1] = im[k] - ti;
+        re[k] += tr;            im[k] += ti;
+    }
+
+    for (int h = 2; h < meio; h *= 2) {
+        const float* wc = fft->fatCos + (h - 1);
+        const float* ws = fft->fatSin + (h - 1);
+        for (int k = 0; k < meio; k += 2 * h) {
+            borboletas(re + k, im + k, re + k + h, im + k + h, wc, ws, h);
+        }
+    }
+
+    // Separa o espectro das amostras pares (E) e ímpares (O): X[k] = E[k] + W^k O[k]
+    magnitudes[0]    = fabsf(re[0] + im[0]);
+    magnitudes[meio] = fabsf(re[0] - im[0]);
+    for (int k = 1; k < meio; ++k) {
+        float zr = re[k], zi = im[k];
+        float cr = re[meio - k], ci = im[meio - k];
+        float er = 0.5f * (zr + cr), ei = 0.5f * (zi - ci);
+        float or_ = 0.5f * (zi + ci), oi = -0.5f * (zr - cr);
+        float xr = er + fft->sepCos[k] * or_ - fft->sepSin[k] * oi;
+        float xi = ei + fft->sepCos[k] * oi + fft->sepSin[k] * or_;
+        magnitudes[k] = sqrtf(xr * xr + xi * xi);
+    }
+}
@@ -0,0 +1,37 @@
+#ifndef FFT_H
+#define FFT_H
+
+#include <stdbool.h>
+
+// FFT de sinal real, tamanho potência de 2, para análise de áudio (espectro
+// de magnitudes com janela de Hann). Radix-2 iterativa com os dados em dois
+// arrays separados (real / imaginário) e uma tabela de fatores contígua por
+// estágio: o laço de borboletas vira acesso sequencial e o compilador o
+// vetoriza (SSE/AVX/NEON) sem intrínsecos. O sinal real de N amostras é
+// empacotado num complexo de N/2 pontos, o que corta o trabalho pela metade.
+//
+// Tabelas e buffers são alocados em Fft_Init; as chamadas seguintes não alocam
+// (podem rodar na thread de áudio).
+
+typedef struct {
+    int    n;        // tamanho do quadro (amostras reais)
+    int    meio;     // n/2: tamanho da FFT complexa
+    float* janela;   // Hann, n pontos
+    float* fatCos;   // fatores por estágio, concatenados (meio-1 entradas)
+    float* fatSin;
+    float* sepCos;   // e^{-2πik/n}, k < meio: separação do espectro real
+    float* sepSin;
+    int*   inverso;  // permutação bit-reversa de 'meio' pontos
+    float* re;       // área de trabalho (meio pontos)
+    float* im;
+} Fft;
+
+// 'n' precisa ser potência de 2 e >= 8. Retorna false se faltou memória.
+bool Fft_Init(Fft* fft, int n);
+void Fft_Free(Fft* fft);
+
+// Magnitude |X[k]| de 'amostras' (n valores) para k = 0..n/2 (n/2+1 valores),
+// aplicando a janela de Hann.
+void Fft_Magnitudes(Fft* fft, const float* amostras, float* magnitudes);
+
+#endif // FFT_H
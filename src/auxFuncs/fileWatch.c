@@ -0,0 +1,91 @@
+#include "fileWatch.h"
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+static void lerAssinatura(const char* caminho, Uint64* tamanho, Sint64* data) {
+    struct stat st;
+    if (stat(caminho, &st) == 0) {
+        *tamanho = (Uint64)st.st_size;
+        *data    = (Sint64)st.st_mtime;
+    } else {
+        *tamanho = 0;
+        *data    = 0;
+    }
+}
+
+bool FileWatch_Open(FileWatch* w, const char* caminho) {
+    memset(w, 0, sizeof(*w));
+    w->fd = w->wd = -1;
+    snprintf(w->caminho, sizeof(w->caminho), "%s", caminho);
+
+    const char* barra = strrchr(caminho, '/');
+    snprintf(w->nome, sizeof(w->nome), "%s", barra ? barra + 1 : caminho);
+    lerAssinatura(caminho, &w->tamanho, &w->data);
+    w->ultimaConsulta = SDL_GetTicks();
+
+#ifdef __linux__
+    char diretorio[256];
+    if (barra) snprintf(diretorio, sizeof(diretorio), "%.*s", (int)(barra - caminho), caminho);
+    else       snprintf(diretorio, sizeof(diretorio), ".");
+    if (diretorio[0] == '\0') snprintf(diretorio, sizeof(diretorio), "/");
+
+    w->fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (w->fd >= 0) {
+        w->wd = inotify_add_watch(w->fd, diretorio, IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+        if (w->wd < 0) { close(w->fd); w->fd = -1; }
+    }
+    if (w->fd < 0) printf("Aviso: inotify indisponivel; '%s' sera verificado por data.\n", caminho);
+#endif
+    return true;
+}
+
+void FileWatch_Close(FileWatch* w) {
+#ifdef __linux__
+    if (w->fd >= 0) close(w->fd);
+#endif
+    w->fd = w->wd = -1;
+}
+
+bool FileWatch_Poll(FileWatch* w) {
+    Uint32 agora = SDL_GetTicks();
+    bool mudou = false;
+
+#ifdef __linux__
+    if (w->fd >= 0) {
+        char buf[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+        ssize_t lidos;
+        while ((lidos = read(w->fd, buf, sizeof(buf))) > 0) {
+            for (char* p = buf; p < buf + lidos; ) {
+                const struct inotify_event* ev = (const struct inotify_event*)p;
+                if (ev->len > 0 && strcmp(ev->name, w->nome) == 0) mudou = true;
+                p += sizeof(struct inotify_event) + ev->len;
+            }
+        }
+    }
+#endif
+
+    if (w->fd < 0 && agora - w->ultimaConsulta >= FILEWATCH_POLL_MS) {
+        w->ultimaConsulta = agora;
+        Uint64 tamanho;
+        Sint64 data;
+        lerAssinatura(w->caminho, &tamanho, &data);
+        if (tamanho != w->tamanho || data != w->data) {
+            w->tamanho = tamanho;
+            w->data = data;
+            mudou = true;
+        }
+    }
+
+    if (mudou) w->pendenteDesde = agora ? agora : 1;
+    if (w->pendenteDesde && agora - w->pendenteDesde >= FILEWATCH_ESPERA_MS) {
+        w->pendenteDesde = 0;
+        return true;
+    }
+    return false;
+}
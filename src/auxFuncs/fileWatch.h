@@ -0,0 +1,32 @@
+#ifndef FILE_WATCH_H
+#define FILE_WATCH_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+// Avisa quando um arquivo foi regravado, sem bloquear (uma consulta por quadro).
+// No Linux usa inotify no diretório do arquivo: editores costumam salvar num
+// temporário e renomear por cima, o que um watch no próprio arquivo perderia.
+// Nos outros sistemas compara tamanho e data a cada FILEWATCH_POLL_MS.
+// Várias escritas seguidas viram um aviso só, FILEWATCH_ESPERA_MS depois da última.
+
+#define FILEWATCH_POLL_MS   250
+#define FILEWATCH_ESPERA_MS 80
+
+typedef struct {
+    char   caminho[256];
+    char   nome[128];       // só o nome, para filtrar os eventos do diretório
+    int    fd, wd;          // inotify; -1 = consultando por data
+    Uint64 tamanho;
+    Sint64 data;
+    Uint32 ultimaConsulta;
+    Uint32 pendenteDesde;   // 0 = nenhuma mudança esperando
+} FileWatch;
+
+bool FileWatch_Open(FileWatch* w, const char* caminho);
+void FileWatch_Close(FileWatch* w);
+
+// true uma vez por alteração, quando o arquivo parou de mudar
+bool FileWatch_Poll(FileWatch* w);
+
+#endif // FILE_WATCH_H
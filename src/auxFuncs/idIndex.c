@@ -0,0 +1,60 @@
+#include "idIndex.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define ID_INDEX_INICIAL 64
+
+// As chaves já são hashes: basta dobrar os 64 bits
+static int slotInicial(Uint64 chave, int mascara) {
+    return (int)((Uint32)(chave ^ (chave >> 32)) & (Uint32)mascara);
+}
+
+static void colocar(IdIndex* indice, Uint64 chave, int valor) {
+    int mascara = indice->capacidade - 1;
+    int slot = slotInicial(chave, mascara);
+    while (indice->chaves[slot] != 0 && indice->chaves[slot] != chave) slot = (slot + 1) & mascara;
+    if (indice->chaves[slot] == 0) indice->ocupados++;
+    indice->chaves[slot]  = chave;
+    indice->valores[slot] = valor;
+}
+
+static bool crescer(IdIndex* indice) {
+    int capacidade = indice->capacidade ? indice->capacidade * 2 : ID_INDEX_INICIAL;
+    Uint64* chaves  = (Uint64*)calloc(capacidade, sizeof(Uint64));
+    int*    valores = (int*)malloc(capacidade * sizeof(int));
+    if (!chaves || !valores) { free(chaves); free(valores); return false; }
+
+    IdIndex antigo = *indice;
+    indice->chaves = chaves;
+    indice->valores = valores;
+    indice->capacidade = capacidade;
+    indice->ocupados = 0;
+    for (int i = 0; i < antigo.capacidade; ++i) {
+        if (antigo.chaves[i] != 0) colocar(indice, antigo.chaves[i], antigo.valores[i]);
+    }
+    free(antigo.chaves);
+    free(antigo.valores);
+    return true;
+}
+
+bool IdIndex_Put(IdIndex* indice, Uint64 chave, int valor) {
+    if (chave == 0) return false;
+    if ((indice->ocupados + 1) * 2 > indice->capacidade && !crescer(indice)) return false;
+    colocar(indice, chave, valor);
+    return true;
+}
+
+int IdIndex_Get(const IdIndex* indice, Uint64 chave) {
+    if (chave == 0 || indice->capacidade == 0) return -1;
+    int mascara = indice->capacidade - 1;
+    for (int slot = slotInicial(chave, mascara); indice->chaves[slot] != 0; slot = (slot + 1) & mascara) {
+        if (indice->chaves[slot] == chave) return indice->valores[slot];
+    }
+    return -1;
+}
+
+void IdIndex_Free(IdIndex* indice) {
+    free(indice->chaves);
+    free(indice->valores);
+    memset(indice, 0, sizeof(*indice));
+}
@@ -0,0 +1,25 @@
+#ifndef ID_INDEX_H
+#define ID_INDEX_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+// Tabela hash de chartId (ou qualquer id de 64 bits já espalhado, como um
+// FNV) para uma posição num array do chamador. Endereçamento aberto com
+// sondagem linear, ocupação mantida abaixo de 50%. O id 0 é reservado (vazio).
+typedef struct {
+    Uint64* chaves;
+    int*    valores;
+    int     capacidade; // potência de 2 (0 = ainda não alocada)
+    int     ocupados;
+} IdIndex;
+
+// Associa 'valor' a 'chave' (substitui se já existir). Retorna false se faltou memória.
+bool IdIndex_Put(IdIndex* indice, Uint64 chave, int valor);
+
+// Valor associado a 'chave', ou -1
+int IdIndex_Get(const IdIndex* indice, Uint64 chave);
+
+void IdIndex_Free(IdIndex* indice);
+
+#endif // ID_INDEX_H
@@ -0,0 +1,81 @@
+#include "pacing.h"
+#include "profiler.h"
+#include "../config.h"
+#include <SDL2/SDL.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#define PACING_GIRO_MS        1.5f  // final do sono em espera ativa (SDL_Delay erra por ~1 ms)
+#define PACING_QUEDA_CUSTO    0.02f // fração da diferença que a estimativa desce por quadro
+#define PACING_LIMITE_CARGA   2.0f  // quadro > refresh * isto é carga (troca de tela), não conta
+
+static bool   s_jit = false;
+static float  s_periodoMs = 1000.0f / 60.0f;
+static float  s_folgaMs = PACING_FOLGA_PADRAO_US / 1000.0f;
+static float  s_custoMs = 0.0f;   // custo estimado de um quadro (entrada até o present)
+static double s_msPorTick = 0.0;
+static Uint64 s_ancora = 0;       // último vblank previsto
+static Uint64 s_acordou = 0;      // quando o quadro atual acordou (0 = nenhum ainda)
+
+void Pacing_Init(void) {
+    s_msPorTick = 1000.0 / (double)SDL_GetPerformanceFrequency();
+
+    const char* valor = Config_GetString("SINCRONIA", "vsync");
+    s_jit = strcmp(valor, "jit") == 0;
+    if (!s_jit && strcmp(valor, "vsync") != 0) printf("Aviso: SINCRONIA '%s' invalida, usando vsync.\n", valor);
+
+    int folga = Config_GetInt("JIT_FOLGA_US", PACING_FOLGA_PADRAO_US);
+    if (folga < PACING_FOLGA_MIN_US) folga = PACING_FOLGA_MIN_US;
+    if (folga > PACING_FOLGA_MAX_US) folga = PACING_FOLGA_MAX_US;
+    s_folgaMs = folga / 1000.0f;
+
+    s_custoMs = 0.0f;
+    s_ancora = SDL_GetPerformanceCounter();
+    s_acordou = 0;
+}
+
+bool Pacing_UsesVsync(void) { return !s_jit; }
+
+void Pacing_SetRefresh(float periodoMs) {
+    if (periodoMs > 0.0f) s_periodoMs = periodoMs;
+}
+
+void Pacing_WaitForFrame(void) {
+    if (!s_jit) return;
+
+    Uint64 agora = SDL_GetPerformanceCounter();
+    if (s_acordou) {
+        float custo = (float)((double)(agora - s_acordou) * s_msPorTick);
+        if (custo < s_periodoMs * PACING_LIMITE_CARGA) {
+            if (custo > s_custoMs) s_custoMs = custo;
+            else                   s_custoMs += (custo - s_custoMs) * PACING_QUEDA_CUSTO;
+        }
+    }
+
+    Uint64 prof = Prof_Begin(PROF_ZONA_ESPERA);
+
+    // Primeiro vblank da grade, depois do que o quadro anterior mirou, que ainda
+    // dá para alcançar acordando agora; se o quadro anterior atrasou, pula para o
+    // seguinte em vez de acordar no passado.
+    double periodo = s_periodoMs / s_msPorTick;
+    double antecedencia = (s_custoMs + s_folgaMs) / s_msPorTick;
+    double desdeAncora = (double)(Sint64)(agora - s_ancora); // negativo se o quadro terminou antes do vblank
+    double vblanks = ceil((desdeAncora + antecedencia) / periodo);
+    if (vblanks < 1.0) vblanks = 1.0;
+    s_ancora += (Uint64)(vblanks * periodo);
+    Uint64 acordar = s_ancora - (Uint64)antecedencia;
+
+    // Dorme a maior parte e gira o resto: o sono sozinho pode passar do ponto
+    for (;;) {
+        agora = SDL_GetPerformanceCounter();
+        if (agora >= acordar) break;
+        float faltaMs = (float)((double)(acordar - agora) * s_msPorTick);
+        if (faltaMs > PACING_GIRO_MS) SDL_Delay((Uint32)(faltaMs - PACING_GIRO_MS));
+    }
+
+    s_acordou = agora;
+    Prof_End(PROF_ZONA_ESPERA, prof);
+}
+
+const char* Pacing_ModeName(void) { return s_jit ? "jit" : "vsync"; }
@@ -0,0 +1,35 @@
+#ifndef PACING_H
+#define PACING_H
+
+#include <stdbool.h>
+
+// Ritmo dos quadros (chave SINCRONIA do config):
+//   vsync (padrão)  o present espera o vblank. A entrada é lida logo depois do
+//                   present anterior e chega à tela até um quadro inteiro velha.
+//   jit             sem vsync. Cada quadro dorme até pouco antes do próximo vblank
+//                   previsto (vblank - custo estimado do quadro - folga) e só então
+//                   lê a entrada, atualiza e apresenta: a entrada chega à tela com
+//                   a idade de um quadro de trabalho, não de um intervalo de refresh.
+// O custo estimado sobe na hora com um quadro mais caro e desce devagar, para um
+// pico isolado não fazer o quadro seguinte perder o vblank.
+#define PACING_FOLGA_PADRAO_US 1500  // JIT_FOLGA_US: margem contra imprecisão do sono
+#define PACING_FOLGA_MIN_US    200
+#define PACING_FOLGA_MAX_US    8000
+
+// Lê SINCRONIA e JIT_FOLGA_US. Chamar antes de criar o renderer.
+void Pacing_Init(void);
+
+// Se o renderer deve ser criado com SDL_RENDERER_PRESENTVSYNC
+bool Pacing_UsesVsync(void);
+
+// Intervalo de refresh do monitor; a grade de vblanks previstos anda neste passo.
+void Pacing_SetRefresh(float periodoMs);
+
+// Chamar no topo de cada quadro, antes de ler a entrada. Com vsync não faz nada;
+// em jit fecha a medida do custo do quadro anterior e dorme até a hora de acordar.
+// O tempo dormido entra na zona PROF_ZONA_ESPERA do profiler.
+void Pacing_WaitForFrame(void);
+
+const char* Pacing_ModeName(void);
+
+#endif // PACING_H
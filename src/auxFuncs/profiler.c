@@ -0,0 +1,251 @@
+#include "profiler.h"
+#include "trace.h"
+#include "textAtlas.h"
+#include "quality.h"
+#include "pacing.h"
+#include "assetPack.h"
+#include <SDL2/SDL2_gfxPrimitives.h>
+#include <SDL2/SDL_ttf.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define PROF_ANEL_TAMANHO   4096 // potência de 2
+#define PROF_ANEL_MASCARA   (PROF_ANEL_TAMANHO - 1)
+#define PROF_HISTORICO      240  // quadros guardados para gráfico e percentis
+#define PROF_TEXTO_A_CADA   30   // recalcula p50/p99 e refaz os textos a cada N quadros
+#define PROF_LINHA_MAX      96
+#define PROF_FONTE_PATH     "assets/font/pixelFont.ttf"
+#define PROF_FONTE_TAMANHO  18
+#define PROF_GRAFICO_MAX_MS 33.3f
+
+// Uma amostra na fila. 'seq' é a posição lógica que a escreveu;
+// -1 enquanto a escrita está em andamento.
+typedef struct {
+    SDL_atomic_t seq;
+    int          zona;
+    Uint64       inicio;
+    Uint64       fim;
+} ProfAmostra;
+
+static const char* s_nomesZonas[PROF_NUM_ZONAS] = {
+    "eventos", "update", "fundo", "sprites", "pista", "checkers",
+    "notas", "confetes", "texto", "present", "espera", "carga"
+};
+
+static ProfAmostra  s_anel[PROF_ANEL_TAMANHO];
+static SDL_atomic_t s_cabeca;   // próxima posição a ser reservada pelos produtores
+static int          s_lido = 0; // próxima posição a ser lida (só a thread principal)
+
+static double s_msPorTick = 0.0;
+
+static float  s_zonaMs[PROF_NUM_ZONAS][PROF_HISTORICO];
+static float  s_quadroMs[PROF_HISTORICO];
+static float  s_jitterMs[PROF_HISTORICO]; // |quadro - quadro anterior|
+static int    s_quadroAtual = 0;  // índice circular do histórico
+static int    s_quadrosValidos = 0;
+static Uint32 s_numeroQuadro = 0;
+static Uint64 s_fimUltimoQuadro = 0;
+static float  s_ultimaCargaMs = 0.0f;
+static float  s_acumuladoCarga = 0.0f;
+
+static bool         s_overlayVisivel = false;
+static TTF_Font*    s_fonte = NULL;
+static TextAtlas    s_atlas;
+#define PROF_LINHAS (PROF_NUM_ZONAS + 3)
+static char         s_linhas[PROF_LINHAS][PROF_LINHA_MAX]; // quadro, zonas, jitter e ritmo/qualidade
+static int          s_quadrosDesdeTexto = PROF_TEXTO_A_CADA;
+
+void Prof_Init(void) {
+    memset(s_anel, 0, sizeof(s_anel));
+    for (int i = 0; i < PROF_ANEL_TAMANHO; ++i) SDL_AtomicSet(&s_anel[i].seq, -1);
+    SDL_AtomicSet(&s_cabeca, 0);
+    s_lido = 0;
+    s_msPorTick = 1000.0 / (double)SDL_GetPerformanceFrequency();
+    s_fimUltimoQuadro = SDL_GetPerformanceCounter();
+}
+
+void Prof_InitOverlay(SDL_Renderer* renderer) {
+    if (!s_fonte) s_fonte = Asset_OpenFont(PROF_FONTE_PATH, PROF_FONTE_TAMANHO);
+    if (s_fonte && !s_atlas.textura) TextAtlas_Init(&s_atlas, renderer, s_fonte);
+}
+
+void Prof_Shutdown(void) {
+    TextAtlas_Free(&s_atlas);
+    if (s_fonte) { TTF_CloseFont(s_fonte); s_fonte = NULL; }
+}
+
+Uint64 Prof_Begin(ProfZona zona) {
+    (void)zona;
+    return SDL_GetPerformanceCounter();
+}
+
+void Prof_End(ProfZona zona, Uint64 inicio) {
+    Uint64 fim = SDL_GetPerformanceCounter();
+    if (Trace_IsActive()) Trace_Zone(s_nomesZonas[zona], inicio, fim);
+
+    // Reserva uma posição e publica a amostra; se o consumidor atrasar,
+    // as amostras mais antigas são sobrescritas em vez de bloquear.
+    int pos = SDL_AtomicAdd(&s_cabeca, 1);
+    ProfAmostra* a = &s_anel[pos & PROF_ANEL_MASCARA];
+    SDL_AtomicSet(&a->seq, -1);
+    a->zona   = (int)zona;
+    a->inicio = inicio;
+    a->fim    = fim;
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&a->seq, pos);
+}
+
+// Lê tudo que foi publicado desde a última chamada e soma por zona.
+static void Prof_DrainRing(float acumulado[PROF_NUM_ZONAS]) {
+    int cabeca = SDL_AtomicGet(&s_cabeca);
+
+    // Ficou mais de uma volta para trás: pula o que já foi sobrescrito.
+    if (cabeca - s_lido > PROF_ANEL_TAMANHO) s_lido = cabeca - PROF_ANEL_TAMANHO;
+
+    while (s_lido != cabeca) {
+        ProfAmostra* a = &s_anel[s_lido & PROF_ANEL_MASCARA];
+        int seq = SDL_AtomicGet(&a->seq);
+        if (seq != s_lido) {
+            if (seq == -1 || seq - s_lido < 0) break; // produtor ainda escrevendo
+            s_lido++;                                 // sobrescrita por uma volta nova
+            continue;
+        }
+        SDL_MemoryBarrierAcquire();
+        int    zona   = a->zona;
+        Uint64 inicio = a->inicio;
+        Uint64 fim    = a->fim;
+        SDL_MemoryBarrierAcquire();
+        if (SDL_AtomicGet(&a->seq) == s_lido && zona >= 0 && zona < PROF_NUM_ZONAS) {
+            acumulado[zona] += (float)((double)(fim - inicio) * s_msPorTick);
+        }
+        s_lido++;
+    }
+}
+
+static int compararFloat(const void* a, const void* b) {
+    float fa = *(const float*)a, fb = *(const float*)b;
+    return (fa > fb) - (fa < fb);
+}
+
+static void percentis(const float* historico, int n, float* p50, float* p99) {
+    float ordenado[PROF_HISTORICO];
+    memcpy(ordenado, historico, n * sizeof(float));
+    qsort(ordenado, n, sizeof(float), compararFloat);
+    *p50 = ordenado[(n - 1) / 2];
+    *p99 = ordenado[(int)((n - 1) * 0.99f)];
+}
+
+void Prof_EndFrame(void) {
+    float acumulado[PROF_NUM_ZONAS] = {0};
+    Prof_DrainRing(acumulado);
+
+    Trace_Frame(s_numeroQuadro++);
+
+    Uint64 agora = SDL_GetPerformanceCounter();
+    float quadro = (float)((double)(agora - s_fimUltimoQuadro) * s_msPorTick);
+    s_fimUltimoQuadro = agora;
+
+    // Carregamentos acontecem fora do loop; guardamos o total da última leva.
+    if (acumulado[PROF_ZONA_CARGA] > 0.0f) {
+        s_acumuladoCarga += acumulado[PROF_ZONA_CARGA];
+    } else if (s_acumuladoCarga > 0.0f) {
+        s_ultimaCargaMs = s_acumuladoCarga;
+        s_acumuladoCarga = 0.0f;
+    }
+
+    for (int z = 0; z < PROF_NUM_ZONAS; ++z) s_zonaMs[z][s_quadroAtual] = acumulado[z];
+    float anterior = s_quadrosValidos > 0 ? s_quadroMs[(s_quadroAtual - 1 + PROF_HISTORICO) % PROF_HISTORICO] : quadro;
+    s_jitterMs[s_quadroAtual] = fabsf(quadro - anterior);
+    s_quadroMs[s_quadroAtual] = quadro;
+    s_quadroAtual = (s_quadroAtual + 1) % PROF_HISTORICO;
+    if (s_quadrosValidos < PROF_HISTORICO) s_quadrosValidos++;
+    s_quadrosDesdeTexto++;
+}
+
+float Prof_LastFrameMs(void) {
+    if (s_quadrosValidos == 0) return 0.0f;
+    return s_quadroMs[(s_quadroAtual - 1 + PROF_HISTORICO) % PROF_HISTORICO];
+}
+
+float Prof_LastZoneMs(ProfZona zona) {
+    if (s_quadrosValidos == 0) return 0.0f;
+    return s_zonaMs[zona][(s_quadroAtual - 1 + PROF_HISTORICO) % PROF_HISTORICO];
+}
+
+float Prof_LastWaitMs(void) {
+    return Prof_LastZoneMs(PROF_ZONA_PRESENT) + Prof_LastZoneMs(PROF_ZONA_ESPERA);
+}
+
+void Prof_ToggleOverlay(void) {
+    s_overlayVisivel = !s_overlayVisivel;
+    s_quadrosDesdeTexto = PROF_TEXTO_A_CADA;
+}
+
+bool Prof_IsOverlayVisible(void) { return s_overlayVisivel; }
+
+// Refaz os textos do overlay. Só roda a cada PROF_TEXTO_A_CADA quadros
+// para os números ficarem legíveis.
+static void Prof_UpdateOverlayText(void) {
+    if (s_quadrosValidos == 0) return;
+
+    float p50, p99;
+    percentis(s_quadroMs, s_quadrosValidos, &p50, &p99);
+    snprintf(s_linhas[0], PROF_LINHA_MAX, "quadro  p50 %5.2f  p99 %5.2f ms", p50, p99);
+
+    for (int z = 0; z < PROF_ZONA_CARGA; ++z) {
+        percentis(s_zonaMs[z], s_quadrosValidos, &p50, &p99);
+        snprintf(s_linhas[1 + z], PROF_LINHA_MAX, "%-8s p50 %5.2f  p99 %5.2f ms", s_nomesZonas[z], p50, p99);
+    }
+
+    snprintf(s_linhas[1 + PROF_ZONA_CARGA], PROF_LINHA_MAX, "%-8s ultima %7.1f ms",
+             s_nomesZonas[PROF_ZONA_CARGA], s_ultimaCargaMs);
+
+    percentis(s_jitterMs, s_quadrosValidos, &p50, &p99);
+    snprintf(s_linhas[PROF_NUM_ZONAS + 1], PROF_LINHA_MAX, "jitter   p50 %5.2f  p99 %5.2f ms", p50, p99);
+
+    snprintf(s_linhas[PROF_NUM_ZONAS + 2], PROF_LINHA_MAX, "ritmo %s  qualidade %s (%s)", Pacing_ModeName(),
+             Quality_LevelName(Quality_GetLevel()), Quality_IsLocked() ? "travada" : "auto");
+
+    s_quadrosDesdeTexto = 0;
+}
+
+void Prof_RenderOverlay(SDL_Renderer* renderer) {
+    if (!s_overlayVisivel) return;
+
+    if (s_quadrosDesdeTexto >= PROF_TEXTO_A_CADA) Prof_UpdateOverlayText();
+
+    const int x = 10, y = 60, larguraGrafico = PROF_HISTORICO * 2, alturaGrafico = 100;
+    const int alturaLinha = PROF_FONTE_TAMANHO + 4;
+    const int altura = alturaGrafico + 20 + PROF_LINHAS * alturaLinha;
+
+    boxRGBA(renderer, x, y, x + larguraGrafico + 20, y + altura, 0, 0, 0, 180);
+
+    // Gráfico de tempo de quadro: base = 0 ms, topo = PROF_GRAFICO_MAX_MS
+    int gx = x + 10, gy = y + 10;
+    int y60 = gy + alturaGrafico - (int)(alturaGrafico * (16.67f / PROF_GRAFICO_MAX_MS));
+    lineRGBA(renderer, gx, y60, gx + larguraGrafico, y60, 0, 191, 255, 200);
+
+    SDL_Point pontos[PROF_HISTORICO];
+    int n = s_quadrosValidos;
+    int primeiro = (s_quadroAtual - n + PROF_HISTORICO) % PROF_HISTORICO;
+    for (int i = 0; i < n; ++i) {
+        float ms = s_quadroMs[(primeiro + i) % PROF_HISTORICO];
+        if (ms > PROF_GRAFICO_MAX_MS) ms = PROF_GRAFICO_MAX_MS;
+        pontos[i].x = gx + i * 2;
+        pontos[i].y = gy + alturaGrafico - (int)(alturaGrafico * (ms / PROF_GRAFICO_MAX_MS));
+    }
+    if (n > 1) {
+        SDL_SetRenderDrawColor(renderer, 50, 205, 50, 255);
+        SDL_RenderDrawLines(renderer, pontos, n);
+    }
+
+    SDL_Color branco  = {255, 255, 255, 255};
+    SDL_Color amarelo = {255, 223, 0, 255};
+    int ty = gy + alturaGrafico + 10;
+    for (int i = 0; i < PROF_LINHAS; ++i) {
+        TextAtlas_Draw(&s_atlas, renderer, s_linhas[i], gx, ty + i * alturaLinha,
+                       (i == 0 || i >= PROF_NUM_ZONAS + 1) ? amarelo : branco, TEXT_ALIGN_LEFT, 1.0f);
+    }
+}
@@ -0,0 +1,55 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+// Zonas de tempo medidas a cada quadro (a ordem define as linhas do overlay)
+typedef enum {
+    PROF_ZONA_EVENTOS,
+    PROF_ZONA_UPDATE,
+    PROF_ZONA_FUNDO,
+    PROF_ZONA_SPRITES,
+    PROF_ZONA_PISTA,
+    PROF_ZONA_CHECKERS,
+    PROF_ZONA_NOTAS,
+    PROF_ZONA_CONFETES,
+    PROF_ZONA_TEXTO,
+    PROF_ZONA_PRESENT,
+    PROF_ZONA_ESPERA,    // sono do ritmo jit antes de ler a entrada (pacing.h)
+    PROF_ZONA_CARGA,     // carregamento de assets (fora do loop de quadros)
+    PROF_NUM_ZONAS
+} ProfZona;
+
+void Prof_Init(void);
+void Prof_Shutdown(void);
+
+// Carrega a fonte e o atlas de glifos do overlay (precisa do renderer).
+void Prof_InitOverlay(SDL_Renderer* renderer);
+
+// Marca o início de uma zona. Guarde o valor retornado e passe para Prof_End.
+// Pode ser chamado de qualquer thread (a fila de amostras é lock-free).
+Uint64 Prof_Begin(ProfZona zona);
+void   Prof_End(ProfZona zona, Uint64 inicio);
+
+// Fecha o quadro atual: consome as amostras da fila e atualiza o histórico.
+// Deve ser chamado pela thread principal uma vez por quadro.
+void Prof_EndFrame(void);
+
+// Duração do último quadro completo em ms (intervalo entre dois Prof_EndFrame).
+float Prof_LastFrameMs(void);
+
+// Tempo somado de uma zona no último quadro completo, em ms.
+float Prof_LastZoneMs(ProfZona zona);
+
+// Tempo que o quadro passou esperando (vsync no present ou sono do ritmo jit), em ms.
+float Prof_LastWaitMs(void);
+
+void Prof_ToggleOverlay(void);
+bool Prof_IsOverlayVisible(void);
+
+// Desenha o gráfico de tempo de quadro, os p50/p99 de cada zona e o jitter
+// (diferença entre a duração de um quadro e a do anterior).
+void Prof_RenderOverlay(SDL_Renderer* renderer);
+
+#endif // PROFILER_H
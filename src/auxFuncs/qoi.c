@@ -0,0 +1,119 @@
+#include "qoi.h"
+#include <string.h>
+
+#define QOI_OP_INDEX 0x00  // 00xxxxxx: pixel da tabela de 64 vistos recentemente
+#define QOI_OP_DIFF  0x40  // 01rrggbb: diferença pequena (-2..1) em cada canal
+#define QOI_OP_LUMA  0x80  // 10gggggg + rrrrbbbb: diferença guiada pelo verde
+#define QOI_OP_RUN   0xC0  // 11xxxxxx: repete o anterior 1..62 vezes
+#define QOI_OP_RGB   0xFE
+#define QOI_OP_RGBA  0xFF
+#define QOI_RUN_MAX  62
+
+static int indiceDe(const Uint8* px) {
+    return (px[0] * 3 + px[1] * 5 + px[2] * 7 + px[3] * 11) % 64;
+}
+
+size_t Qoi_TamanhoMaximo(int pixels) {
+    return (size_t)pixels * 5; // QOI_OP_RGBA em todos
+}
+
+size_t Qoi_Codificar(const Uint8* origem, int pixels, Uint8* saida) {
+    Uint8 vistos[64][4];
+    memset(vistos, 0, sizeof(vistos));
+    Uint8 anterior[4] = { 0, 0, 0, 255 };
+    size_t n = 0;
+    int repeticoes = 0;
+
+    for (int i = 0; i < pixels; ++i) {
+        const Uint8* px = origem + (size_t)i * 4;
+
+        if (memcmp(px, anterior, 4) == 0) {
+            if (++repeticoes == QOI_RUN_MAX || i == pixels - 1) {
+                saida[n++] = (Uint8)(QOI_OP_RUN | (repeticoes - 1));
+                repeticoes = 0;
+            }
+            continue;
+        }
+        if (repeticoes > 0) {
+            saida[n++] = (Uint8)(QOI_OP_RUN | (repeticoes - 1));
+            repeticoes = 0;
+        }
+
+        int h = indiceDe(px);
+        if (memcmp(vistos[h], px, 4) == 0) {
+            saida[n++] = (Uint8)(QOI_OP_INDEX | h);
+        } else {
+            memcpy(vistos[h], px, 4);
+            if (px[3] == anterior[3]) {
+                Sint8 dr = (Sint8)(px[0] - anterior[0]);
+                Sint8 dg = (Sint8)(px[1] - anterior[1]);
+                Sint8 db = (Sint8)(px[2] - anterior[2]);
+                Sint8 drg = (Sint8)(dr - dg), dbg = (Sint8)(db - dg);
+
+                if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1) {
+                    saida[n++] = (Uint8)(QOI_OP_DIFF | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2));
+                } else if (drg >= -8 && drg <= 7 && dg >= -32 && dg <= 31 && dbg >= -8 && dbg <= 7) {
+                    saida[n++] = (Uint8)(QOI_OP_LUMA | (dg + 32));
+                    saida[n++] = (Uint8)((drg + 8) << 4 | (dbg + 8));
+                } else {
+                    saida[n++] = QOI_OP_RGB;
+                    saida[n++] = px[0]; saida[n++] = px[1]; saida[n++] = px[2];
+                }
+            } else {
+                saida[n++] = QOI_OP_RGBA;
+                memcpy(saida + n, px, 4);
+                n += 4;
+            }
+        }
+        memcpy(anterior, px, 4);
+    }
+    return n;
+}
+
+bool Qoi_Decodificar(const Uint8* dados, size_t tamanho, Uint8* destino, int pixels) {
+    Uint8 vistos[64][4];
+    memset(vistos, 0, sizeof(vistos));
+    Uint8 px[4] = { 0, 0, 0, 255 };
+    size_t p = 0;
+
+    for (int i = 0; i < pixels; ) {
+        if (p >= tamanho) return false;
+        Uint8 op = dados[p++];
+        int repetir = 1;
+
+        if (op == QOI_OP_RGB) {
+            if (p + 3 > tamanho) return false;
+            px[0] = dados[p]; px[1] = dados[p + 1]; px[2] = dados[p + 2];
+            p += 3;
+        } else if (op == QOI_OP_RGBA) {
+            if (p + 4 > tamanho) return false;
+            memcpy(px, dados + p, 4);
+            p += 4;
+        } else switch (op & 0xC0) {
+            case QOI_OP_INDEX:
+                memcpy(px, vistos[op], 4);
+                break;
+            case QOI_OP_DIFF:
+                px[0] += ((op >> 4) & 3) - 2;
+                px[1] += ((op >> 2) & 3) - 2;
+                px[2] += (op & 3) - 2;
+                break;
+            case QOI_OP_LUMA: {
+                if (p >= tamanho) return false;
+                Uint8 b2 = dados[p++];
+                int dg = (op & 0x3F) - 32;
+                px[0] += dg - 8 + (b2 >> 4);
+                px[1] += dg;
+                px[2] += dg - 8 + (b2 & 0x0F);
+            } break;
+            default: // QOI_OP_RUN
+                repetir = (op & 0x3F) + 1;
+                if (i + repetir > pixels) return false;
+                break;
+        }
+
+        memcpy(vistos[indiceDe(px)], px, 4);
+        for (int r = 0; r < repetir; ++r, ++i) memcpy(destino + (size_t)i * 4, px, 4);
+    }
+    return p == tamanho;
+}
@@ -0,0 +1,24 @@
+#ifndef QOI_H
+#define QOI_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Codec QOI ("Quite OK Image") sem o cabeçalho do formato: só o fluxo de
+// operações sobre pixels de 4 bytes, com o alfa no 4º byte. Decodifica bem mais
+// rápido que PNG e comprime muito bem arte em pixel (repetições e paleta curta).
+// Quem guarda largura, altura e formato é quem chama (ver texCache.h).
+
+// Pior caso da saída de Qoi_Codificar para 'pixels' pixels
+size_t Qoi_TamanhoMaximo(int pixels);
+
+// Codifica 'pixels' pixels de 'origem' em 'saida' (Qoi_TamanhoMaximo bytes).
+// Retorna quantos bytes foram escritos.
+size_t Qoi_Codificar(const Uint8* origem, int pixels, Uint8* saida);
+
+// Decodifica exatamente 'pixels' pixels em 'destino'. Retorna false se os
+// dados acabarem antes ou sobrarem (arquivo truncado ou corrompido).
+bool Qoi_Decodificar(const Uint8* dados, size_t tamanho, Uint8* destino, int pixels);
+
+#endif // QOI_H
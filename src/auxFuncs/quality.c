@@ -0,0 +1,110 @@
+#include "quality.h"
+#include "../config.h"
+#include "../confetti.h"
+#include <stdio.h>
+#include <string.h>
+
+#define QUALIDADE_JANELA         120   // quadros observados antes de decidir
+#define QUALIDADE_LIMIAR_PERDIDO 1.25f // quadro > alvo * isto conta como quadro perdido
+#define QUALIDADE_MAX_PERDIDOS   6     // perdidos na janela que fazem descer um nível
+#define QUALIDADE_ESPERA_DESCER  30    // quadros após uma troca antes de poder descer de novo
+#define QUALIDADE_FOLGA_SUBIR    0.55f // trabalho médio < alvo * isto permite subir
+#define QUALIDADE_JANELAS_SUBIR  3     // janelas boas seguidas antes de subir
+#define QUALIDADE_QUADRO_CARGA   250.0f // quadros maiores que isto são cargas, não contam
+
+typedef struct {
+    int  confetes;
+    bool aa;
+    bool animacao;
+    bool fundoSuave;
+} QualidadePerfil;
+
+static const QualidadePerfil s_perfis[QUALIDADE_NUM_NIVEIS] = {
+    /* MINIMA */ { CONFETTI_MAX / 32, false, false, false },
+    /* BAIXA  */ { CONFETTI_MAX / 8,  false, true,  false },
+    /* MEDIA  */ { CONFETTI_MAX / 2,  true,  true,  true  },
+    /* ALTA   */ { CONFETTI_MAX,      true,  true,  true  },
+};
+
+static const char* s_nomes[QUALIDADE_NUM_NIVEIS] = { "minima", "baixa", "media", "alta" };
+
+static QualidadeNivel s_nivel = QUALIDADE_ALTA;
+static bool           s_travado = false;
+static float          s_alvoMs = 1000.0f / 60.0f;
+
+static int   s_quadros = 0;
+static int   s_perdidos = 0;
+static float s_somaTrabalho = 0.0f;
+static int   s_janelasBoas = 0;
+
+void Quality_Init(float alvoMs) {
+    if (alvoMs > 0.0f) s_alvoMs = alvoMs;
+
+    const char* valor = Config_GetString("QUALIDADE", "auto");
+    s_travado = false;
+    s_nivel = QUALIDADE_ALTA;
+    if (strcmp(valor, "auto") != 0) {
+        for (int i = 0; i < QUALIDADE_NUM_NIVEIS; ++i) {
+            if (strcmp(valor, s_nomes[i]) == 0 || (valor[0] == '0' + i && valor[1] == '\0')) {
+                s_nivel = (QualidadeNivel)i;
+                s_travado = true;
+            }
+        }
+        if (!s_travado) printf("Aviso: QUALIDADE '%s' invalida, usando auto.\n", valor);
+    }
+    Quality_ResetWindow();
+}
+
+void Quality_ResetWindow(void) {
+    s_quadros = 0;
+    s_perdidos = 0;
+    s_somaTrabalho = 0.0f;
+}
+
+bool Quality_Update(float quadroMs, float presentMs) {
+    if (s_travado || quadroMs <= 0.0f || quadroMs > QUALIDADE_QUADRO_CARGA) return false;
+
+    // Com vsync (ou ritmo jit) o quadro nunca fica abaixo do alvo; o que mede a
+    // folga é o tempo de trabalho (quadro menos a espera).
+    float trabalho = quadroMs - presentMs;
+    if (trabalho < 0.0f) trabalho = 0.0f;
+
+    s_quadros++;
+    s_somaTrabalho += trabalho;
+    if (quadroMs > s_alvoMs * QUALIDADE_LIMIAR_PERDIDO) s_perdidos++;
+
+    // Descer é rápido: não espera a janela fechar, só dá tempo ao nível atual de fazer efeito
+    if (s_quadros >= QUALIDADE_ESPERA_DESCER && s_perdidos >= QUALIDADE_MAX_PERDIDOS && s_nivel > QUALIDADE_MINIMA) {
+        s_nivel--;
+        s_janelasBoas = 0;
+        Quality_ResetWindow();
+        return true;
+    }
+    if (s_quadros < QUALIDADE_JANELA) return false;
+
+    // Subir é lento: várias janelas seguidas sem perda e com folga
+    float mediaTrabalho = s_somaTrabalho / (float)s_quadros;
+    bool boa = s_perdidos == 0 && mediaTrabalho < s_alvoMs * QUALIDADE_FOLGA_SUBIR;
+    s_janelasBoas = boa ? s_janelasBoas + 1 : 0;
+    Quality_ResetWindow();
+
+    if (s_janelasBoas >= QUALIDADE_JANELAS_SUBIR && s_nivel < QUALIDADE_ALTA) {
+        s_nivel++;
+        s_janelasBoas = 0;
+        return true;
+    }
+    return false;
+}
+
+QualidadeNivel Quality_GetLevel(void) { return s_nivel; }
+bool           Quality_IsLocked(void) { return s_travado; }
+
+const char* Quality_LevelName(QualidadeNivel nivel) {
+    if (nivel < 0 || nivel >= QUALIDADE_NUM_NIVEIS) return "?";
+    return s_nomes[nivel];
+}
+
+int  Quality_ConfettiBudget(void)    { return s_perfis[s_nivel].confetes; }
+bool Quality_AntialiasOutlines(void) { return s_perfis[s_nivel].aa; }
+bool Quality_AnimateCharacters(void) { return s_perfis[s_nivel].animacao; }
+bool Quality_SmoothBackground(void)  { return s_perfis[s_nivel].fundoSuave; }
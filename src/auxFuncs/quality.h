@@ -0,0 +1,39 @@
+#ifndef QUALITY_H
+#define QUALITY_H
+
+#include <stdbool.h>
+
+// Governador de qualidade: observa o tempo de quadro e desce ou sobe um nível
+// por vez, com histerese (limiares diferentes para descer e subir e um tempo
+// mínimo entre trocas) para não ficar oscilando.
+typedef enum {
+    QUALIDADE_MINIMA,
+    QUALIDADE_BAIXA,
+    QUALIDADE_MEDIA,
+    QUALIDADE_ALTA,
+    QUALIDADE_NUM_NIVEIS
+} QualidadeNivel;
+
+// 'alvoMs' é a duração de um quadro na taxa do monitor.
+// Lê QUALIDADE do config: "auto" (padrão) ou um nível fixo (0-3 ou minima/baixa/media/alta).
+void Quality_Init(float alvoMs);
+
+// Recomeça a observação (ex.: depois de uma carga, cujo quadro longo não conta)
+void Quality_ResetWindow(void);
+
+// Alimenta um quadro: duração total e tempo gasto esperando (vsync no present
+// ou o sono do ritmo jit, ver Prof_LastWaitMs).
+// Retorna true se o nível mudou.
+bool Quality_Update(float quadroMs, float presentMs);
+
+QualidadeNivel Quality_GetLevel(void);
+bool           Quality_IsLocked(void);
+const char*    Quality_LevelName(QualidadeNivel nivel);
+
+// O que cada nível liga ou desliga
+int  Quality_ConfettiBudget(void);     // partículas vivas permitidas
+bool Quality_AntialiasOutlines(void);  // contorno aacircle das notas
+bool Quality_AnimateCharacters(void);  // animação dos personagens do cenário
+bool Quality_SmoothBackground(void);   // filtro linear ao escalar o fundo
+
+#endif // QUALITY_H
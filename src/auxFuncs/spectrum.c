@@ -0,0 +1,139 @@
+#include "spectrum.h"
+#include "fft.h"
+#include <SDL2/SDL_mixer.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#define SPECTRUM_MASCARA (SPECTRUM_N - 1)
+#define SPECTRUM_BANDAS  3
+
+// Limites das bandas em Hz: [grave, medio, agudo, fim)
+static const float s_limitesHz[SPECTRUM_BANDAS + 1] = { 40.0f, 160.0f, 2000.0f, 8000.0f };
+
+#define SPECTRUM_PICO_TAU_S 4.0f   // esquecimento do pico de cada banda
+#define SPECTRUM_PICO_PISO  0.02f  // abaixo disso é silêncio, não se amplifica
+#define SPECTRUM_PICO_RELATIVO 0.1f // piso de cada banda em relação à mais forte
+
+static bool  s_ativo = false;
+static int   s_canais = 0;
+static int   s_frequencia = 0;
+static Fft   s_fft;
+static float s_anel[SPECTRUM_N];        // mono, escrito em volta
+static int   s_escrita = 0;
+static float s_quadro[SPECTRUM_N];      // anel desenrolado, do mais antigo ao mais novo
+static float s_mags[SPECTRUM_N / 2 + 1];
+static int   s_binInicio[SPECTRUM_BANDAS], s_binFim[SPECTRUM_BANDAS];
+static float s_picos[SPECTRUM_BANDAS];
+
+// Publicação: seq ímpar = escrita em andamento
+static SDL_atomic_t   s_seq;
+static SpectrumBandas s_publicado;
+
+bool Spectrum_Init(int frequencia, Uint16 formato, int canais) {
+    s_ativo = false;
+    if (formato != AUDIO_S16SYS || canais < 1 || frequencia <= 0) {
+        printf("AVISO: espectro desligado (formato de audio 0x%x, %d canais)\n", formato, canais);
+        return false;
+    }
+    if (!Fft_Init(&s_fft, SPECTRUM_N)) {
+        printf("AVISO: sem memoria para o analisador de espectro\n");
+        return false;
+    }
+
+    s_canais = canais;
+    s_frequencia = frequencia;
+    memset(s_anel, 0, sizeof(s_anel));
+    s_escrita = 0;
+    for (int b = 0; b < SPECTRUM_BANDAS; ++b) {
+        int ini = (int)(s_limitesHz[b] * SPECTRUM_N / frequencia + 0.5f);
+        int fim = (int)(s_limitesHz[b + 1] * SPECTRUM_N / frequencia + 0.5f);
+        if (ini < 1) ini = 1;
+        if (fim > SPECTRUM_N / 2) fim = SPECTRUM_N / 2;
+        if (fim <= ini) fim = ini + 1;
+        s_binInicio[b] = ini;
+        s_binFim[b] = fim;
+        s_picos[b] = 0.0f;
+    }
+    memset(&s_publicado, 0, sizeof(s_publicado));
+    SDL_AtomicSet(&s_seq, 0);
+    s_ativo = true;
+    return true;
+}
+
+void Spectrum_Shutdown(void) {
+    if (!s_ativo) return;
+    s_ativo = false;
+    Fft_Free(&s_fft);
+}
+
+void Spectrum_Feed(const Uint8* stream, int len) {
+    if (!s_ativo) return;
+
+    const Sint16* pcm = (const Sint16*)stream;
+    const int quadros = len / (int)(sizeof(Sint16) * s_canais);
+    const float escala = 1.0f / (32768.0f * (float)s_canais);
+    for (int q = 0; q < quadros; ++q) {
+        int soma = 0;
+        for (int c = 0; c < s_canais; ++c) soma += pcm[q * s_canais + c];
+        s_anel[s_escrita] = (float)soma * escala;
+        s_escrita = (s_escrita + 1) & SPECTRUM_MASCARA;
+    }
+
+    // Uma FFT por callback, sobre as SPECTRUM_N amostras mais recentes
+    const int antigas = SPECTRUM_N - s_escrita;
+    memcpy(s_quadro, s_anel + s_escrita, (size_t)antigas * sizeof(float));
+    memcpy(s_quadro + antigas, s_anel, (size_t)s_escrita * sizeof(float));
+    Fft_Magnitudes(&s_fft, s_quadro, s_mags);
+
+    // Normaliza pelo pico recente, que decai com o tempo real deste bloco
+    const float decaimento = expf(-(float)quadros / ((float)s_frequencia * SPECTRUM_PICO_TAU_S));
+    float energias[SPECTRUM_BANDAS], niveis[SPECTRUM_BANDAS];
+    float maiorPico = SPECTRUM_PICO_PISO;
+    for (int b = 0; b < SPECTRUM_BANDAS; ++b) {
+        // Amplitude total da banda (não a média por bin): bandas largas e
+        // estreitas ficam comparáveis, um tom puro pesa igual em qualquer uma
+        float soma = 0.0f;
+        for (int k = s_binInicio[b]; k < s_binFim[b]; ++k) soma += s_mags[k] * s_mags[k];
+        energias[b] = sqrtf(soma);
+
+        float pico = s_picos[b] * decaimento;
+        if (pico < energias[b]) pico = energias[b];
+        s_picos[b] = pico;
+        if (maiorPico < pico) maiorPico = pico;
+    }
+    // Uma banda quase vazia (só vazamento da vizinha) não pode virar 1.0:
+    // o pico de referência nunca fica abaixo de uma fração do maior deles
+    for (int b = 0; b < SPECTRUM_BANDAS; ++b) {
+        float ref = s_picos[b];
+        if (ref < maiorPico * SPECTRUM_PICO_RELATIVO) ref = maiorPico * SPECTRUM_PICO_RELATIVO;
+        niveis[b] = energias[b] / ref;
+    }
+
+    SDL_AtomicAdd(&s_seq, 1);
+    SDL_MemoryBarrierRelease();
+    s_publicado.grave = niveis[0];
+    s_publicado.medio = niveis[1];
+    s_publicado.agudo = niveis[2];
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicAdd(&s_seq, 1);
+}
+
+bool Spectrum_Read(SpectrumBandas* bandas) {
+    if (!s_ativo) return false;
+
+    // Se o áudio publicar no meio da cópia, tenta de novo; a escrita dura
+    // nanossegundos e acontece a cada bloco, então uma repetição basta
+    for (int tentativa = 0; tentativa < 4; ++tentativa) {
+        int seq = SDL_AtomicGet(&s_seq);
+        if (seq & 1) continue;
+        SDL_MemoryBarrierAcquire();
+        SpectrumBandas copia = s_publicado;
+        SDL_MemoryBarrierAcquire();
+        if (SDL_AtomicGet(&s_seq) == seq) {
+            *bandas = copia;
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,38 @@
+#ifndef SPECTRUM_H
+#define SPECTRUM_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+// Analisador de espectro em tempo real para o cenário reagir à música.
+// Spectrum_Feed roda no post-mix do SDL_mixer (thread de áudio): mistura o
+// bloco em mono num anel pré-alocado e faz UMA FFT de SPECTRUM_N pontos sobre
+// as amostras mais recentes por callback, custo fixo e sem alocação.
+// As energias por banda são publicadas com um contador de sequência atômico:
+// o render lê a cópia mais recente sem trava e o áudio nunca espera.
+
+#define SPECTRUM_N 2048
+
+// Energia de cada banda em 0..1, relativa ao pico recente da própria banda
+typedef struct {
+    float grave;  // ~40-160 Hz: bumbo, surdo
+    float medio;  // ~160-2000 Hz: voz, cavaquinho
+    float agudo;  // ~2-8 kHz: platinelas, chocalho
+} SpectrumBandas;
+
+// Formato de saída do mixer (Mix_QuerySpec). Só AUDIO_S16SYS é analisado;
+// em outro formato o analisador fica desligado e Spectrum_Read devolve false.
+// Chamar antes de registrar o post-mix.
+bool Spectrum_Init(int frequencia, Uint16 formato, int canais);
+
+// Chamar depois de remover o post-mix
+void Spectrum_Shutdown(void);
+
+// Thread de áudio: 'stream' é o bloco já mixado
+void Spectrum_Feed(const Uint8* stream, int len);
+
+// Thread de render: última análise publicada. False se o analisador está
+// desligado ou se não deu para ler uma cópia consistente (mantenha a anterior).
+bool Spectrum_Read(SpectrumBandas* bandas);
+
+#endif // SPECTRUM_H
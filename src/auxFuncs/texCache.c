@@ -0,0 +1,158 @@
+#include "texCache.h"
+#include "assetPack.h"
+#include "qoi.h"
+#include "utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#define TC_MAGICO    "SBTX"
+#define TC_CABECALHO 48
+
+static char   s_dir[512] = "";  // vazio = sem cache
+static Uint32 s_formato = SDL_PIXELFORMAT_ARGB8888;
+
+#ifndef _WIN32
+static bool criarDiretorio(const char* caminho) {
+    struct stat st;
+    if (stat(caminho, &st) == 0) return S_ISDIR(st.st_mode);
+    return mkdir(caminho, 0755) == 0;
+}
+#endif
+
+void TexCache_Init(SDL_Renderer* renderer) {
+    // Formato de 32 bits com alfa que o renderer aceita sem converter
+    SDL_RendererInfo info;
+    if (renderer && SDL_GetRendererInfo(renderer, &info) == 0) {
+        for (Uint32 i = 0; i < info.num_texture_formats; ++i) {
+            Uint32 f = info.texture_formats[i];
+            if (f == SDL_PIXELFORMAT_ARGB8888 || f == SDL_PIXELFORMAT_ABGR8888) { s_formato = f; break; }
+        }
+    }
+
+    s_dir[0] = '\0';
+#ifdef _WIN32
+    char* pref = SDL_GetPrefPath("SambaRaiz", "texturas");
+    if (pref) {
+        snprintf(s_dir, sizeof(s_dir), "%s", pref);
+        SDL_free(pref);
+    }
+#else
+    char base[400];
+    const char* xdg = getenv("XDG_CACHE_HOME");
+    const char* home = getenv("HOME");
+    if (xdg && xdg[0])       snprintf(base, sizeof(base), "%s", xdg);
+    else if (home && home[0]) snprintf(base, sizeof(base), "%s/.cache", home);
+    else return;
+
+    char app[450];
+    snprintf(app, sizeof(app), "%s/sambaRaiz", base);
+    char dir[sizeof(s_dir)];
+    snprintf(dir, sizeof(dir), "%s/texturas/", app);
+    if (criarDiretorio(base) && criarDiretorio(app) && criarDiretorio(dir))
+        snprintf(s_dir, sizeof(s_dir), "%s", dir);
+#endif
+    if (!s_dir[0]) printf("Aviso: sem diretorio de cache; imagens serao decodificadas a cada carga.\n");
+}
+
+static void arquivoDoCache(const char* caminho, char* saida, size_t tamanho) {
+    snprintf(saida, tamanho, "%s%016llx.tex", s_dir,
+             (unsigned long long)Fnv1a64(caminho, strlen(caminho)));
+}
+
+// Superfície a partir do cache, se ele ainda corresponde à origem
+static SDL_Surface* lerCache(const char* arquivo, const char* caminho, Uint64 tamanhoFonte, Sint64 dataFonte) {
+    size_t tamanho = 0;
+    Uint8* dados = (Uint8*)SDL_LoadFile(arquivo, &tamanho);
+    if (!dados) return NULL;
+
+    SDL_Surface* surf = NULL;
+    size_t lenCaminho = strlen(caminho);
+    if (tamanho >= TC_CABECALHO && memcmp(dados, TC_MAGICO, 4) == 0 &&
+        GetU32LE(dados + 4) == TEXCACHE_VERSAO && GetU32LE(dados + 8) == s_formato &&
+        GetU64LE(dados + 20) == tamanhoFonte && (Sint64)GetU64LE(dados + 28) == dataFonte &&
+        GetU32LE(dados + 44) == lenCaminho && tamanho >= TC_CABECALHO + lenCaminho &&
+        memcmp(dados + TC_CABECALHO, caminho, lenCaminho) == 0) {
+
+        int w = (int)GetU32LE(dados + 12), h = (int)GetU32LE(dados + 16);
+        size_t bytes = GetU32LE(dados + 36);
+        const Uint8* qoi = dados + TC_CABECALHO + lenCaminho;
+        if (w > 0 && h > 0 && bytes == tamanho - TC_CABECALHO - lenCaminho &&
+            Fnv1a32(qoi, bytes) == GetU32LE(dados + 40)) {
+            surf = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, s_formato);
+            if (surf && (surf->pitch != w * 4 || !Qoi_Decodificar(qoi, bytes, (Uint8*)surf->pixels, w * h))) {
+                SDL_FreeSurface(surf);
+                surf = NULL;
+            }
+        }
+    }
+    SDL_free(dados);
+    return surf;
+}
+
+static void gravarCache(const char* arquivo, const char* caminho, Uint64 tamanhoFonte, Sint64 dataFonte, const SDL_Surface* surf) {
+    if (surf->pitch != surf->w * 4) return;
+
+    int pixels = surf->w * surf->h;
+    Uint8* qoi = (Uint8*)malloc(Qoi_TamanhoMaximo(pixels));
+    if (!qoi) return;
+    size_t bytes = Qoi_Codificar((const Uint8*)surf->pixels, pixels, qoi);
+
+    size_t lenCaminho = strlen(caminho);
+    Uint8 cab[TC_CABECALHO];
+    memset(cab, 0, sizeof(cab));
+    memcpy(cab, TC_MAGICO, 4);
+    PutU32LE(cab + 4, TEXCACHE_VERSAO);
+    PutU32LE(cab + 8, s_formato);
+    PutU32LE(cab + 12, (Uint32)surf->w);
+    PutU32LE(cab + 16, (Uint32)surf->h);
+    PutU64LE(cab + 20, tamanhoFonte);
+    PutU64LE(cab + 28, (Uint64)dataFonte);
+    PutU32LE(cab + 36, (Uint32)bytes);
+    PutU32LE(cab + 40, Fnv1a32(qoi, bytes));
+    PutU32LE(cab + 44, (Uint32)lenCaminho);
+
+    char temp[sizeof(s_dir) + 48];
+    snprintf(temp, sizeof(temp), "%s.tmp", arquivo);
+    FILE* f = fopen(temp, "wb");
+    if (f) {
+        bool ok = fwrite(cab, 1, sizeof(cab), f) == sizeof(cab) &&
+                  fwrite(caminho, 1, lenCaminho, f) == lenCaminho &&
+                  fwrite(qoi, 1, bytes, f) == bytes;
+        if (ok) CommitTempFile(f, temp, arquivo);
+        else { fclose(f); remove(temp); }
+    }
+    free(qoi);
+}
+
+SDL_Surface* TexCache_LoadSurface(const char* caminho) {
+    Uint64 tamanhoFonte = 0;
+    Sint64 dataFonte = 0;
+    bool temFonte = Asset_Stat(caminho, &tamanhoFonte, &dataFonte);
+
+    char arquivo[sizeof(s_dir) + 32];
+    if (s_dir[0] && temFonte) {
+        arquivoDoCache(caminho, arquivo, sizeof(arquivo));
+        SDL_Surface* surf = lerCache(arquivo, caminho, tamanhoFonte, dataFonte);
+        if (surf) return surf;
+    }
+
+    // Falta no cache: decodifica a origem, converte para o formato do renderer e guarda
+    SDL_Surface* origem = Asset_LoadSurface(caminho);
+    if (!origem) return NULL;
+    SDL_Surface* surf = SDL_ConvertSurfaceFormat(origem, s_formato, 0);
+    SDL_FreeSurface(origem);
+    if (!surf) return NULL;
+
+    if (s_dir[0] && temFonte) gravarCache(arquivo, caminho, tamanhoFonte, dataFonte, surf);
+    return surf;
+}
+
+SDL_Texture* TexCache_LoadTexture(SDL_Renderer* renderer, const char* caminho) {
+    SDL_Surface* surf = TexCache_LoadSurface(caminho);
+    if (!surf) return NULL;
+    SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, surf);
+    SDL_FreeSurface(surf);
+    return tex;
+}
@@ -0,0 +1,29 @@
+#ifndef TEX_CACHE_H
+#define TEX_CACHE_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+// Cache de imagens já decodificadas: a primeira carga de cada imagem decodifica
+// o PNG/JPG e guarda os pixels, no formato de 32 bits que o renderer usa, em
+// QOI (decodificar é bem mais rápido que PNG, e arte em pixel comprime muito).
+// Da segunda vez em diante a textura sobe direto do cache.
+//  - Um arquivo por imagem, no diretório de cache do usuário
+//    ($XDG_CACHE_HOME ou ~/.cache/sambaRaiz/texturas; no Windows, o SDL_GetPrefPath).
+//  - Vale enquanto o caminho, o tamanho e a data da origem (Asset_Stat) e o
+//    formato de pixel forem os mesmos; senão decodifica de novo e regrava.
+//  - Sem diretório de cache, só decodifica (como IMG_LoadTexture).
+#define TEXCACHE_VERSAO 1
+
+// Escolhe o formato nativo do renderer e prepara o diretório. Chamar uma vez,
+// depois de criar o renderer; antes disso o formato é ARGB8888.
+void TexCache_Init(SDL_Renderer* renderer);
+
+// Superfície da imagem (do cache ou decodificada e guardada). Não usa o
+// renderer: pode ser chamada de um thread de apoio.
+SDL_Surface* TexCache_LoadSurface(const char* caminho);
+
+// No lugar de IMG_LoadTexture / Asset_LoadTexture
+SDL_Texture* TexCache_LoadTexture(SDL_Renderer* renderer, const char* caminho);
+
+#endif // TEX_CACHE_H
@@ -0,0 +1,79 @@
+#include "textAtlas.h"
+#include <string.h>
+
+#define TEXT_ATLAS_TOTAL (TEXT_ATLAS_ULTIMO - TEXT_ATLAS_PRIMEIRO + 1)
+
+bool TextAtlas_Init(TextAtlas* atlas, SDL_Renderer* renderer, TTF_Font* fonte) {
+    memset(atlas, 0, sizeof(*atlas));
+    if (!fonte) return false;
+
+    SDL_Color branco = {255, 255, 255, 255};
+    SDL_Surface* glifos[TEXT_ATLAS_TOTAL] = {0};
+    int largura = 0, altura = 0;
+    for (int i = 0; i < TEXT_ATLAS_TOTAL; ++i) {
+        glifos[i] = TTF_RenderGlyph_Blended(fonte, (Uint16)(TEXT_ATLAS_PRIMEIRO + i), branco);
+        if (!glifos[i]) continue;
+        largura += glifos[i]->w;
+        if (glifos[i]->h > altura) altura = glifos[i]->h;
+    }
+
+    bool ok = false;
+    SDL_Surface* folha = (largura > 0) ? SDL_CreateRGBSurfaceWithFormat(0, largura, altura, 32, SDL_PIXELFORMAT_ARGB8888) : NULL;
+    if (folha) {
+        SDL_FillRect(folha, NULL, SDL_MapRGBA(folha->format, 255, 255, 255, 0));
+        int x = 0;
+        for (int i = 0; i < TEXT_ATLAS_TOTAL; ++i) {
+            if (!glifos[i]) continue;
+            SDL_Rect dst = { x, 0, glifos[i]->w, glifos[i]->h };
+            SDL_SetSurfaceBlendMode(glifos[i], SDL_BLENDMODE_NONE); // copia o alfa como está
+            SDL_BlitSurface(glifos[i], NULL, folha, &dst);
+            atlas->glifos[i] = dst;
+            x += glifos[i]->w;
+        }
+        atlas->textura = SDL_CreateTextureFromSurface(renderer, folha);
+        atlas->altura = altura;
+        ok = atlas->textura != NULL;
+        SDL_FreeSurface(folha);
+    }
+
+    for (int i = 0; i < TEXT_ATLAS_TOTAL; ++i) if (glifos[i]) SDL_FreeSurface(glifos[i]);
+    if (ok) SDL_SetTextureBlendMode(atlas->textura, SDL_BLENDMODE_BLEND);
+    return ok;
+}
+
+void TextAtlas_Free(TextAtlas* atlas) {
+    if (atlas->textura) SDL_DestroyTexture(atlas->textura);
+    memset(atlas, 0, sizeof(*atlas));
+}
+
+static const SDL_Rect* glifo(const TextAtlas* atlas, char c) {
+    unsigned char u = (unsigned char)c;
+    if (u < TEXT_ATLAS_PRIMEIRO || u > TEXT_ATLAS_ULTIMO) u = '?';
+    return &atlas->glifos[u - TEXT_ATLAS_PRIMEIRO];
+}
+
+int TextAtlas_Measure(const TextAtlas* atlas, const char* texto) {
+    int w = 0;
+    for (const char* p = texto; *p; ++p) w += glifo(atlas, *p)->w;
+    return w;
+}
+
+void TextAtlas_Draw(const TextAtlas* atlas, SDL_Renderer* renderer, const char* texto,
+                    int x, int y, SDL_Color cor, TextAlignment align, float escala) {
+    if (!atlas->textura || !texto) return;
+
+    int largura = (int)(TextAtlas_Measure(atlas, texto) * escala);
+    if (align == TEXT_ALIGN_CENTER)     x -= largura / 2;
+    else if (align == TEXT_ALIGN_RIGHT) x -= largura;
+
+    SDL_SetTextureColorMod(atlas->textura, cor.r, cor.g, cor.b);
+    SDL_SetTextureAlphaMod(atlas->textura, cor.a);
+
+    float cx = (float)x;
+    for (const char* p = texto; *p; ++p) {
+        const SDL_Rect* src = glifo(atlas, *p);
+        SDL_FRect dst = { cx, (float)y, src->w * escala, src->h * escala };
+        if (*p != ' ') SDL_RenderCopyF(renderer, atlas->textura, src, &dst);
+        cx += dst.w;
+    }
+}
@@ -0,0 +1,31 @@
+#ifndef TEXT_ATLAS_H
+#define TEXT_ATLAS_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <stdbool.h>
+#include "utils.h"
+
+// Os caracteres ASCII imprimíveis de uma fonte, rasterizados uma vez numa
+// única textura branca. Desenhar texto vira uma cópia por caractere com
+// color mod, sem criar superfícies nem texturas durante o jogo.
+#define TEXT_ATLAS_PRIMEIRO 32
+#define TEXT_ATLAS_ULTIMO   126
+
+typedef struct {
+    SDL_Texture* textura;
+    SDL_Rect     glifos[TEXT_ATLAS_ULTIMO - TEXT_ATLAS_PRIMEIRO + 1];
+    int          altura;
+} TextAtlas;
+
+bool TextAtlas_Init(TextAtlas* atlas, SDL_Renderer* renderer, TTF_Font* fonte);
+void TextAtlas_Free(TextAtlas* atlas);
+
+// Largura em pixels de 'texto' na escala 1
+int TextAtlas_Measure(const TextAtlas* atlas, const char* texto);
+
+// Mesmo contrato do RenderText, com escala (1.0 = tamanho da fonte).
+void TextAtlas_Draw(const TextAtlas* atlas, SDL_Renderer* renderer, const char* texto,
+                    int x, int y, SDL_Color cor, TextAlignment align, float escala);
+
+#endif // TEXT_ATLAS_H
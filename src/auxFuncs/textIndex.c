@@ -0,0 +1,193 @@
+#include "textIndex.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define TI_SIMBOLOS      37 // espaço, a-z, 0-9
+#define TI_CHAVES        (TI_SIMBOLOS * TI_SIMBOLOS * TI_SIMBOLOS)
+#define TI_MAX_PALAVRAS  16
+#define TI_PALAVRA_MAX   64
+#define TI_INICIAL       64
+
+// Letra base dos caracteres U+00C0..U+00FF (UTF-8 0xC3 0x80..0xBF); ' ' = separador
+static const char s_semAcento[64 + 1] =
+    "aaaaaaaceeeeiiiidnooooo ouuuuy s"
+    "aaaaaaaceeeeiiiidnooooo ouuuuy y";
+
+// Minúsculas sem acento, uma palavra por vez separadas por um espaço, com
+// espaço nas duas pontas (" meu lugar "). Vazio se não há nenhuma palavra.
+static int normalizar(const char* origem, char* destino, int tamanho) {
+    int n = 0;
+    bool espaco = true;
+    destino[n++] = ' ';
+    for (const unsigned char* p = (const unsigned char*)origem; *p && n < tamanho - 2; ++p) {
+        char c = ' ';
+        if (*p >= 'a' && *p <= 'z')      c = (char)*p;
+        else if (*p >= 'A' && *p <= 'Z') c = (char)(*p - 'A' + 'a');
+        else if (*p >= '0' && *p <= '9') c = (char)*p;
+        else if (*p == 0xC3 && (p[1] & 0xC0) == 0x80) c = s_semAcento[*++p & 0x3F];
+        else if (*p >= 0xC0) { while ((p[1] & 0xC0) == 0x80) ++p; } // outro caractere multibyte
+
+        if (c == ' ') {
+            if (!espaco) destino[n++] = ' ';
+            espaco = true;
+        } else {
+            destino[n++] = c;
+            espaco = false;
+        }
+    }
+    if (!espaco) destino[n++] = ' ';
+    if (n == 1) n = 0;
+    destino[n] = '\0';
+    return n;
+}
+
+static int simbolo(char c) {
+    if (c >= 'a' && c <= 'z') return 1 + (c - 'a');
+    if (c >= '0' && c <= '9') return 27 + (c - '0');
+    return 0;
+}
+
+static int chave(char a, char b, char c) {
+    return (simbolo(a) * TI_SIMBOLOS + simbolo(b)) * TI_SIMBOLOS + simbolo(c);
+}
+
+// Chaves de um texto normalizado: todos os trigramas e o começo de cada palavra
+// ("  m" para a primeira letra; " me" já é um trigrama). Pode repetir.
+static int chavesDoTexto(const char* t, int* chaves) {
+    int n = 0;
+    for (int i = 0; t[i] && t[i + 1] && t[i + 2]; ++i) {
+        chaves[n++] = chave(t[i], t[i + 1], t[i + 2]);
+        if (t[i] == ' ') chaves[n++] = chave(' ', ' ', t[i + 1]);
+    }
+    return n;
+}
+
+bool TextIndex_Add(TextIndex* indice, const char* texto) {
+    char normal[TEXTINDEX_TEXTO_MAX];
+    int tamanho = normalizar(texto, normal, sizeof(normal)) + 1;
+
+    if (indice->total == indice->capacidade) {
+        int capacidade = indice->capacidade ? indice->capacidade * 2 : TI_INICIAL;
+        int* inicios = (int*)realloc(indice->inicioTexto, capacidade * sizeof(int));
+        if (!inicios) return false;
+        indice->inicioTexto = inicios;
+        indice->capacidade = capacidade;
+    }
+    if (indice->bytesTextos + tamanho > indice->capacidadeTextos) {
+        int capacidade = indice->capacidadeTextos ? indice->capacidadeTextos * 2 : TI_INICIAL * 32;
+        while (capacidade < indice->bytesTextos + tamanho) capacidade *= 2;
+        char* textos = (char*)realloc(indice->textos, capacidade);
+        if (!textos) return false;
+        indice->textos = textos;
+        indice->capacidadeTextos = capacidade;
+    }
+
+    memcpy(indice->textos + indice->bytesTextos, normal, tamanho);
+    indice->inicioTexto[indice->total++] = indice->bytesTextos;
+    indice->bytesTextos += tamanho;
+    return true;
+}
+
+bool TextIndex_Finish(TextIndex* indice) {
+    free(indice->inicio);
+    free(indice->postagens);
+    indice->postagens = NULL;
+    indice->inicio = (int*)calloc(TI_CHAVES + 1, sizeof(int));
+    int* cursor = (int*)malloc(TI_CHAVES * sizeof(int));
+    if (!indice->inicio || !cursor) { free(cursor); return false; }
+
+    // Conta (cada texto uma vez por chave), acumula e preenche: como os ids
+    // entram em ordem, cada lista já sai ordenada
+    int chaves[2 * TEXTINDEX_TEXTO_MAX];
+    for (int k = 0; k < TI_CHAVES; ++k) cursor[k] = -1;
+    for (int id = 0; id < indice->total; ++id) {
+        int n = chavesDoTexto(indice->textos + indice->inicioTexto[id], chaves);
+        for (int i = 0; i < n; ++i) {
+            if (cursor[chaves[i]] == id) continue;
+            cursor[chaves[i]] = id;
+            indice->inicio[chaves[i] + 1]++;
+        }
+    }
+    for (int k = 0; k < TI_CHAVES; ++k) indice->inicio[k + 1] += indice->inicio[k];
+
+    indice->postagens = (int*)malloc((indice->inicio[TI_CHAVES] + 1) * sizeof(int));
+    if (!indice->postagens) { free(cursor); return false; }
+    memcpy(cursor, indice->inicio, TI_CHAVES * sizeof(int));
+    for (int id = 0; id < indice->total; ++id) {
+        int n = chavesDoTexto(indice->textos + indice->inicioTexto[id], chaves);
+        for (int i = 0; i < n; ++i) {
+            int k = chaves[i];
+            if (cursor[k] > indice->inicio[k] && indice->postagens[cursor[k] - 1] == id) continue;
+            indice->postagens[cursor[k]++] = id;
+        }
+    }
+    free(cursor);
+    return true;
+}
+
+static void menorLista(const TextIndex* indice, int k, int* inicio, int* total) {
+    int n = indice->inicio[k + 1] - indice->inicio[k];
+    if (*total < 0 || n < *total) { *total = n; *inicio = indice->inicio[k]; }
+}
+
+int TextIndex_Search(const TextIndex* indice, const char* consulta,
+                     const int* candidatos, int totalCandidatos, int* saida) {
+    char normal[TEXTINDEX_TEXTO_MAX];
+    normalizar(consulta, normal, sizeof(normal));
+    if (normal[0] && !indice->postagens) return 0; // sem TextIndex_Finish
+
+    // Padrão de cada palavra: " palavra" (começo de alguma palavra do texto)
+    char padroes[TI_MAX_PALAVRAS][TI_PALAVRA_MAX + 2];
+    int totalPalavras = 0;
+    int melhorInicio = 0, melhorTotal = -1;
+    for (const char* p = normal; *p && totalPalavras < TI_MAX_PALAVRAS; ) {
+        while (*p == ' ') ++p;
+        int len = 0;
+        while (p[len] && p[len] != ' ') ++len;
+        if (len == 0) break;
+        if (len > TI_PALAVRA_MAX) len = TI_PALAVRA_MAX;
+
+        char* padrao = padroes[totalPalavras++];
+        padrao[0] = ' ';
+        memcpy(padrao + 1, p, len);
+        padrao[len + 1] = '\0';
+
+        // Menor lista entre as chaves desta palavra: o começo e os trigramas de dentro
+        if (len == 1) menorLista(indice, chave(' ', ' ', p[0]), &melhorInicio, &melhorTotal);
+        else          menorLista(indice, chave(' ', p[0], p[1]), &melhorInicio, &melhorTotal);
+        for (int i = 0; i + 2 < len; ++i) menorLista(indice, chave(p[i], p[i + 1], p[i + 2]), &melhorInicio, &melhorTotal);
+        while (*p && *p != ' ') ++p;
+    }
+
+    if (totalPalavras == 0) {
+        if (candidatos) {
+            if (saida != candidatos) memmove(saida, candidatos, totalCandidatos * sizeof(int));
+            return totalCandidatos;
+        }
+        for (int id = 0; id < indice->total; ++id) saida[id] = id;
+        return indice->total;
+    }
+
+    const int* lista = indice->postagens + melhorInicio;
+    int total = melhorTotal;
+    if (candidatos && totalCandidatos < total) { lista = candidatos; total = totalCandidatos; }
+
+    // Confere cada candidato (a lista só garante um trigrama; saida nunca passa da leitura)
+    int n = 0;
+    for (int i = 0; i < total; ++i) {
+        int id = lista[i];
+        const char* texto = indice->textos + indice->inicioTexto[id];
+        bool bate = true;
+        for (int w = 0; w < totalPalavras && bate; ++w) bate = strstr(texto, padroes[w]) != NULL;
+        if (bate) saida[n++] = id;
+    }
+    return n;
+}
+
+void TextIndex_Free(TextIndex* indice) {
+    free(indice->textos);
+    free(indice->inicioTexto);
+    free(indice->inicio);
+    free(indice->postagens);
+    memset(indice, 0, sizeof(*indice));
+}
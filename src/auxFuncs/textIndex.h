@@ -0,0 +1,45 @@
+#ifndef TEXT_INDEX_H
+#define TEXT_INDEX_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Índice de busca por texto (nomes de músicas e artistas): cada texto é
+// normalizado (minúsculas, sem acento, só letras e dígitos) e cada trigrama
+// dele aponta para a lista, em ordem crescente, dos textos que o contêm. O
+// começo de cada palavra também entra como chave, para consultas de 1 e 2 letras.
+// Cada palavra da consulta precisa ser o começo de alguma palavra do texto
+// ("arl cru" acha "Arlindo Cruz"). A consulta parte da menor lista entre as
+// chaves das suas palavras e confere só esses candidatos: o custo acompanha
+// quantos textos batem, não o total. Como acrescentar letras só estreita o
+// resultado, a consulta seguinte pode partir do resultado da anterior.
+#define TEXTINDEX_TEXTO_MAX 256 // texto normalizado (o resto é ignorado)
+
+typedef struct {
+    char* textos;       // normalizados, " palavra palavra " com '\0' entre eles
+    int*  inicioTexto;  // [total]: onde cada texto começa em 'textos'
+    int*  inicio;       // [chaves + 1]: faixa de cada chave em 'postagens'
+    int*  postagens;    // ids dos textos
+    int   total;
+    int   capacidade;
+    int   bytesTextos;
+    int   capacidadeTextos;
+} TextIndex;
+
+// Acrescenta um texto; o id dele é a ordem de chamada (0, 1, 2...).
+bool TextIndex_Add(TextIndex* indice, const char* texto);
+
+// Monta as listas depois do último Add. Retorna false se faltou memória.
+bool TextIndex_Finish(TextIndex* indice);
+
+// Ids dos textos que batem com 'consulta', em ordem crescente, em 'saida'
+// (espaço para 'total' ids). Com 'candidatos' (ids em ordem crescente, ex.: o
+// resultado da consulta anterior quando o jogador só acrescentou uma letra),
+// confere só eles se forem menos que a menor lista. 'saida' pode ser o próprio
+// 'candidatos'. Consulta sem palavras devolve os candidatos (ou todos).
+int TextIndex_Search(const TextIndex* indice, const char* consulta,
+                     const int* candidatos, int totalCandidatos, int* saida);
+
+void TextIndex_Free(TextIndex* indice);
+
+#endif // TEXT_INDEX_H
@@ -0,0 +1,238 @@
+#include "trace.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TRACE_ANEL_TAMANHO  (1 << 16) // potência de 2
+#define TRACE_ANEL_MASCARA  (TRACE_ANEL_TAMANHO - 1)
+#define TRACE_BUFFER_ESCRITA (64 * 1024)
+#define TRACE_ESPERA_MS     2         // intervalo da thread escritora quando a fila está vazia
+
+// Tipos de evento gravados
+enum {
+    TRACE_ZONA,        // "X": zona completa (início + duração)
+    TRACE_INSTANTE,    // "i": evento pontual (quadro, entrada, callback de áudio)
+    TRACE_NOME_THREAD  // "M": metadado com o nome da thread
+};
+
+typedef struct {
+    SDL_atomic_t  seq;   // posição lógica que escreveu este slot (-1 = vazio)
+    int           tipo;
+    const char*   nome;
+    const char*   nomeArg0;
+    const char*   nomeArg1;
+    int           arg0, arg1;
+    Uint64        ticks;
+    Uint64        fim;   // só para TRACE_ZONA
+    SDL_threadID  thread;
+} TraceEvento;
+
+static TraceEvento* s_anel = NULL;
+static SDL_atomic_t s_cabeca;       // próxima posição a ser reservada
+static SDL_atomic_t s_cauda;        // próxima posição a ser escrita no disco
+static SDL_atomic_t s_descartados;
+static SDL_atomic_t s_parar;
+static bool         s_ativo = false;
+
+static FILE*       s_arquivo = NULL;
+static SDL_Thread* s_thread = NULL;
+static Uint64      s_ticksInicio = 0;
+static double      s_usPorTick = 0.0;
+
+static char s_buffer[TRACE_BUFFER_ESCRITA];
+static int  s_bufferUsado = 0;
+static bool s_primeiroEvento = true;
+
+static void Trace_Push(int tipo, const char* nome, Uint64 ticks, Uint64 fim,
+                       const char* nomeArg0, int arg0, const char* nomeArg1, int arg1) {
+    if (!s_ativo) return;
+
+    int pos;
+    do {
+        pos = SDL_AtomicGet(&s_cabeca);
+        if (pos - SDL_AtomicGet(&s_cauda) >= TRACE_ANEL_TAMANHO) {
+            SDL_AtomicAdd(&s_descartados, 1); // escritora atrasada: descarta em vez de travar o jogo
+            return;
+        }
+    } while (!SDL_AtomicCAS(&s_cabeca, pos, pos + 1));
+
+    TraceEvento* ev = &s_anel[pos & TRACE_ANEL_MASCARA];
+    ev->tipo     = tipo;
+    ev->nome     = nome;
+    ev->nomeArg0 = nomeArg0;
+    ev->nomeArg1 = nomeArg1;
+    ev->arg0     = arg0;
+    ev->arg1     = arg1;
+    ev->ticks    = ticks;
+    ev->fim      = fim;
+    ev->thread   = SDL_ThreadID();
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&ev->seq, pos);
+}
+
+static void Trace_FlushBuffer(void) {
+    if (s_bufferUsado > 0) {
+        fwrite(s_buffer, 1, s_bufferUsado, s_arquivo);
+        s_bufferUsado = 0;
+    }
+}
+
+static void Trace_Write(const TraceEvento* ev) {
+    if (s_bufferUsado > TRACE_BUFFER_ESCRITA - 512) Trace_FlushBuffer();
+
+    char* out = s_buffer + s_bufferUsado;
+    int   livre = TRACE_BUFFER_ESCRITA - s_bufferUsado;
+    const char* sep = s_primeiroEvento ? "\n" : ",\n";
+    unsigned long tid = (unsigned long)ev->thread;
+    int n;
+
+    if (ev->tipo == TRACE_NOME_THREAD) {
+        n = snprintf(out, livre,
+                     "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%lu,\"args\":{\"name\":\"%s\"}}",
+                     sep, tid, ev->nome);
+    } else {
+        double us = (double)(Sint64)(ev->ticks - s_ticksInicio) * s_usPorTick;
+        n = snprintf(out, livre, "%s{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":%lu",
+                     sep, ev->nome, ev->tipo == TRACE_ZONA ? 'X' : 'i', us, tid);
+        if (ev->tipo == TRACE_ZONA) {
+            n += snprintf(out + n, livre - n, ",\"dur\":%.3f", (double)(ev->fim - ev->ticks) * s_usPorTick);
+        } else {
+            n += snprintf(out + n, livre - n, ",\"s\":\"t\"");
+        }
+        if (ev->nomeArg0) {
+            n += snprintf(out + n, livre - n, ",\"args\":{\"%s\":%d", ev->nomeArg0, ev->arg0);
+            if (ev->nomeArg1) n += snprintf(out + n, livre - n, ",\"%s\":%d", ev->nomeArg1, ev->arg1);
+            n += snprintf(out + n, livre - n, "}");
+        }
+        n += snprintf(out + n, livre - n, "}");
+    }
+
+    s_bufferUsado += n;
+    s_primeiroEvento = false;
+}
+
+// Consome tudo que já foi publicado. Retorna quantos eventos escreveu.
+static int Trace_Drain(void) {
+    int escritos = 0;
+    int cauda = SDL_AtomicGet(&s_cauda);
+    while (cauda != SDL_AtomicGet(&s_cabeca)) {
+        TraceEvento* ev = &s_anel[cauda & TRACE_ANEL_MASCARA];
+        if (SDL_AtomicGet(&ev->seq) != cauda) break; // produtor ainda preenchendo
+        SDL_MemoryBarrierAcquire();
+        Trace_Write(ev);
+        cauda++;
+        SDL_AtomicSet(&s_cauda, cauda); // libera o slot para os produtores
+        escritos++;
+    }
+    return escritos;
+}
+
+static int Trace_WriterThread(void* dados) {
+    (void)dados;
+    for (;;) {
+        bool parar = SDL_AtomicGet(&s_parar) != 0;
+        int escritos = Trace_Drain();
+        if (parar && SDL_AtomicGet(&s_cauda) == SDL_AtomicGet(&s_cabeca)) break;
+        if (escritos == 0) {
+            Trace_FlushBuffer();
+            SDL_Delay(TRACE_ESPERA_MS);
+        }
+    }
+    Trace_FlushBuffer();
+    return 0;
+}
+
+bool Trace_Open(const char* caminho) {
+    if (s_ativo) return true;
+
+    s_arquivo = fopen(caminho, "wb");
+    if (!s_arquivo) {
+        printf("Erro: Nao foi possivel criar o arquivo de trace: %s\n", caminho);
+        return false;
+    }
+
+    s_anel = (TraceEvento*)calloc(TRACE_ANEL_TAMANHO, sizeof(TraceEvento));
+    if (!s_anel) {
+        fclose(s_arquivo); s_arquivo = NULL;
+        return false;
+    }
+    for (int i = 0; i < TRACE_ANEL_TAMANHO; ++i) SDL_AtomicSet(&s_anel[i].seq, -1);
+
+    SDL_AtomicSet(&s_cabeca, 0);
+    SDL_AtomicSet(&s_cauda, 0);
+    SDL_AtomicSet(&s_descartados, 0);
+    SDL_AtomicSet(&s_parar, 0);
+    s_ticksInicio    = SDL_GetPerformanceCounter();
+    s_usPorTick      = 1000000.0 / (double)SDL_GetPerformanceFrequency();
+    s_bufferUsado    = 0;
+    s_primeiroEvento = true;
+
+    fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", s_arquivo);
+
+    s_ativo = true;
+    s_thread = SDL_CreateThread(Trace_WriterThread, "trace", NULL);
+    if (!s_thread) {
+        s_ativo = false;
+        fclose(s_arquivo); s_arquivo = NULL;
+        free(s_anel); s_anel = NULL;
+        return false;
+    }
+
+    printf("Gravando trace em '%s'.\n", caminho);
+    return true;
+}
+
+void Trace_Close(void) {
+    if (!s_ativo) return;
+
+    // Novos eventos deixam de entrar; a escritora esvazia o que já foi reservado.
+    s_ativo = false;
+    SDL_AtomicSet(&s_parar, 1);
+    SDL_WaitThread(s_thread, NULL);
+    s_thread = NULL;
+
+    fputs("\n]}\n", s_arquivo);
+    fclose(s_arquivo);
+    s_arquivo = NULL;
+
+    int descartados = SDL_AtomicGet(&s_descartados);
+    if (descartados > 0) printf("Aviso: %d eventos de trace descartados (fila cheia).\n", descartados);
+
+    free(s_anel);
+    s_anel = NULL;
+}
+
+bool Trace_IsActive(void) { return s_ativo; }
+
+void Trace_Zone(const char* nome, Uint64 inicio, Uint64 fim) {
+    Trace_Push(TRACE_ZONA, nome, inicio, fim, NULL, 0, NULL, 0);
+}
+
+void Trace_NameThread(const char* nome) {
+    Trace_Push(TRACE_NOME_THREAD, nome, SDL_GetPerformanceCounter(), 0, NULL, 0, NULL, 0);
+}
+
+void Trace_Frame(Uint32 numeroQuadro) {
+    Trace_Push(TRACE_INSTANTE, "quadro", SDL_GetPerformanceCounter(), 0, "n", (int)numeroQuadro, NULL, 0);
+}
+
+void Trace_Input(const SDL_Event* e) {
+    if (!s_ativo) return;
+    Uint64 agora = SDL_GetPerformanceCounter();
+    switch (e->type) {
+        case SDL_KEYDOWN:
+        case SDL_KEYUP:
+            Trace_Push(TRACE_INSTANTE, e->type == SDL_KEYDOWN ? "tecla_down" : "tecla_up", agora, 0,
+                       "tecla", (int)e->key.keysym.sym, "sdl_ms", (int)e->key.timestamp);
+            break;
+        case SDL_MOUSEBUTTONDOWN:
+        case SDL_MOUSEBUTTONUP:
+            Trace_Push(TRACE_INSTANTE, e->type == SDL_MOUSEBUTTONDOWN ? "mouse_down" : "mouse_up", agora, 0,
+                       "botao", (int)e->button.button, "sdl_ms", (int)e->button.timestamp);
+            break;
+    }
+}
+
+void Trace_AudioCallback(int bytes) {
+    Trace_Push(TRACE_INSTANTE, "audio_mix", SDL_GetPerformanceCounter(), 0, "bytes", bytes, NULL, 0);
+}
@@ -0,0 +1,32 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+// Exportação de eventos no formato Chrome Trace Event (abre no Perfetto / chrome://tracing).
+// Os produtores só copiam o evento para uma fila lock-free; uma thread
+// própria formata o JSON e grava no disco.
+
+// Abre o arquivo e inicia a thread escritora. Retorna false se não conseguiu.
+bool Trace_Open(const char* caminho);
+
+// Esvazia a fila, fecha o JSON e encerra a thread escritora.
+void Trace_Close(void);
+
+bool Trace_IsActive(void);
+
+// Registra uma zona completa (começo e fim num só evento "X").
+// 'nome' precisa ser uma string estática (só o ponteiro é guardado) e os
+// tempos vêm de SDL_GetPerformanceCounter. Nunca bloqueia: com a fila cheia, o evento é descartado.
+void Trace_Zone(const char* nome, Uint64 inicio, Uint64 fim);
+
+// Dá nome à thread que chama (aparece como título da trilha no Perfetto).
+void Trace_NameThread(const char* nome);
+
+// Atalhos para os eventos do loop
+void Trace_Frame(Uint32 numeroQuadro);
+void Trace_Input(const SDL_Event* e);
+void Trace_AudioCallback(int bytes);
+
+#endif // TRACE_H
@@ -1,6 +1,10 @@
 #include "utils.h"
-#include "../leaderboard.h"
 #include <stdio.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
 
 void RenderText(SDL_Renderer* renderer, TTF_Font* font, const char* text, int x, int y, SDL_Color color, TextAlignment align) {
     if (!font || !text) return;
@@ -30,22 +34,55 @@ void RenderText(SDL_Renderer* renderer, TTF_Font* font, const char* text, int x,
     SDL_DestroyTexture(texture);
 }
 
-void Leaderboard_Load(LeaderboardData* data) {
-    FILE* file = fopen("leaderboards.dat", "rb");
-    if (file) {
-        fread(data, sizeof(LeaderboardData), 1, file);
-        fclose(file);
-    } else {
-        // Se o arquivo não existe, apenas zera a contagem
-        data->songCount = 0;
-    }
+Uint32 Fnv1a32(const void* dados, size_t tamanho) {
+    const Uint8* p = (const Uint8*)dados;
+    Uint32 h = 2166136261u;
+    for (size_t i = 0; i < tamanho; ++i) { h ^= p[i]; h *= 16777619u; }
+    return h;
 }
 
-// Salva a estrutura de placares inteira em um arquivo.
-void Leaderboard_Save(const LeaderboardData* data) {
-    FILE* file = fopen("leaderboards.dat", "wb");
-    if (file) {
-        fwrite(data, sizeof(LeaderboardData), 1, file);
-        fclose(file);
-    }
-}
\ No newline at end of file
+Uint64 Fnv1a64(const void* dados, size_t tamanho) {
+    return Fnv1a64Add(FNV1A64_INICIO, dados, tamanho);
+}
+
+Uint64 Fnv1a64Add(Uint64 h, const void* dados, size_t tamanho) {
+    const Uint8* p = (const Uint8*)dados;
+    for (size_t i = 0; i < tamanho; ++i) { h ^= p[i]; h *= 1099511628211ULL; }
+    return h;
+}
+
+void PutU32LE(Uint8* p, Uint32 v) {
+    p[0] = (Uint8)v; p[1] = (Uint8)(v >> 8); p[2] = (Uint8)(v >> 16); p[3] = (Uint8)(v >> 24);
+}
+
+Uint32 GetU32LE(const Uint8* p) {
+    return (Uint32)p[0] | ((Uint32)p[1] << 8) | ((Uint32)p[2] << 16) | ((Uint32)p[3] << 24);
+}
+
+void PutU64LE(Uint8* p, Uint64 v) {
+    PutU32LE(p, (Uint32)v);
+    PutU32LE(p + 4, (Uint32)(v >> 32));
+}
+
+Uint64 GetU64LE(const Uint8* p) {
+    return (Uint64)GetU32LE(p) | ((Uint64)GetU32LE(p + 4) << 32);
+}
+
+bool ReplaceFileAtomic(const char* origem, const char* destino) {
+#ifdef _WIN32
+    return MoveFileExA(origem, destino, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    return rename(origem, destino) == 0;
+#endif
+}
+
+bool CommitTempFile(FILE* file, const char* temp, const char* destino) {
+    bool ok = fflush(file) == 0;
+#ifndef _WIN32
+    ok = ok && fsync(fileno(file)) == 0; // o rename só pode valer depois dos dados
+#endif
+    ok = (fclose(file) == 0) && ok;
+    ok = ok && ReplaceFileAtomic(temp, destino);
+    if (!ok) remove(temp);
+    return ok;
+}
@@ -4,6 +4,7 @@
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
 #include <stdbool.h>
+#include <stdio.h>
 
 typedef enum {
     TEXT_ALIGN_LEFT,
@@ -14,4 +15,29 @@ typedef enum {
 // Declaração da função de renderização de texto compartilhada
 void RenderText(SDL_Renderer* renderer, TTF_Font* font, const char* text, int x, int y, SDL_Color color, TextAlignment align);
 
+// --- Arquivos binários (recordes, histórico) ---
+
+// Soma de verificação FNV-1a de 32 bits
+Uint32 Fnv1a32(const void* dados, size_t tamanho);
+// FNV-1a de 64 bits (chaves de busca, como os caminhos do pacote de assets)
+Uint64 Fnv1a64(const void* dados, size_t tamanho);
+// Continua um FNV-1a de 64 bits com mais bytes (começar de FNV1A64_INICIO),
+// para somar um arquivo enquanto ele é lido aos pedaços
+#define FNV1A64_INICIO 14695981039346656037ULL
+Uint64 Fnv1a64Add(Uint64 h, const void* dados, size_t tamanho);
+
+// Inteiros little-endian em buffers de bytes (o formato em disco não depende da máquina)
+void   PutU32LE(Uint8* p, Uint32 v);
+Uint32 GetU32LE(const Uint8* p);
+void   PutU64LE(Uint8* p, Uint64 v);
+Uint64 GetU64LE(const Uint8* p);
+
+// Troca 'destino' por 'origem' num passo só (rename não substitui no Windows)
+bool ReplaceFileAtomic(const char* origem, const char* destino);
+
+// Fecha um arquivo temporário já escrito, força os dados para o disco e só
+// então o coloca no lugar de 'destino'. Em qualquer falha o temporário é
+// apagado e 'destino' fica como estava.
+bool CommitTempFile(FILE* file, const char* temp, const char* destino);
+
 #endif // UTILS_H
\ No newline at end of file
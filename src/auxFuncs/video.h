@@ -0,0 +1,35 @@
+#ifndef VIDEO_H
+#define VIDEO_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+// Resolução lógica do jogo: todo o layout (defs.h, menu, HUD) é escrito nela,
+// qualquer que seja o monitor. O SDL faz o letterbox e converte as coordenadas
+// de mouse dos eventos para este espaço.
+#define LOGICAL_WIDTH  1920
+#define LOGICAL_HEIGHT 1080
+
+// Escala de renderização em % da resolução lógica (chave ESCALA_RENDER do config).
+// Abaixo de 100 a cena é desenhada num alvo menor e ampliada no present.
+#define ESCALA_RENDER_MIN    50
+#define ESCALA_RENDER_MAX    100
+#define ESCALA_RENDER_PADRAO 100
+
+// Configura o tamanho lógico e, se a escala for menor que 100%, cria o alvo
+// reduzido e já o deixa ativo. Retorna false só se o renderer recusar o tamanho lógico.
+bool Video_Init(SDL_Renderer* renderer);
+
+void Video_Shutdown(void);
+
+// Volta a desenhar na cena (alvo reduzido + escala, ou a janela direto).
+// Quem troca de alvo no meio do quadro (camadas retidas) chama isto para voltar.
+void Video_BindScene(SDL_Renderer* renderer);
+
+// Amplia a cena para a janela, apresenta e deixa a cena ativa para o próximo quadro.
+void Video_Present(SDL_Renderer* renderer);
+
+// Escala efetiva em % (100 = nativo na resolução lógica)
+int Video_GetRenderScale(void);
+
+#endif // VIDEO_H
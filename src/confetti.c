@@ -0,0 +1,186 @@
+#include "confetti.h"
+#include "defs.h"
+#include <stdlib.h>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define CONFETTI_SSE 1
+#endif
+
+#define CONFETTI_GRAVIDADE 300.0f // px/s²
+
+// Capacidade arredondada para múltiplo de 4: o laço SIMD pode passar do fim
+// das partículas vivas sem sair do array.
+#define CONFETTI_CAPACIDADE ((CONFETTI_MAX + 3) & ~3)
+
+static float*     s_x    = NULL;
+static float*     s_y    = NULL;
+static float*     s_vx   = NULL;
+static float*     s_vy   = NULL;
+static float*     s_vida = NULL;
+static float*     s_tam  = NULL;
+static SDL_Color* s_cor  = NULL;
+static int        s_vivas = 0;
+static int        s_limite = CONFETTI_MAX;
+
+static float s_emissaoAcumulada = 0.0f; // fração de partícula que sobrou do frame anterior
+static Uint32 s_semente = 1;
+
+// Geometria do lote único: 4 vértices e 6 índices por partícula.
+// Os índices não mudam, então são montados uma vez só.
+static SDL_Vertex* s_vertices = NULL;
+static int*        s_indices  = NULL;
+
+static Uint32 aleatorio(void) {
+    s_semente ^= s_semente << 13;
+    s_semente ^= s_semente >> 17;
+    s_semente ^= s_semente << 5;
+    return s_semente;
+}
+
+// 6 campos float + cor + 4 vértices e 6 índices por partícula, com folga de alinhamento
+size_t Confetti_ArenaSize(void) {
+    return CONFETTI_CAPACIDADE * (6 * sizeof(float) + sizeof(SDL_Color) + 4 * sizeof(SDL_Vertex) + 6 * sizeof(int))
+         + 9 * 16;
+}
+
+static float* alocarCampo(Arena* arena) {
+    return (float*)Arena_Alloc(arena, CONFETTI_CAPACIDADE * sizeof(float), 16);
+}
+
+bool Confetti_Init(Arena* arena) {
+    Confetti_Shutdown();
+
+    s_x    = alocarCampo(arena);
+    s_y    = alocarCampo(arena);
+    s_vx   = alocarCampo(arena);
+    s_vy   = alocarCampo(arena);
+    s_vida = alocarCampo(arena);
+    s_tam  = alocarCampo(arena);
+    s_cor      = (SDL_Color*)Arena_Alloc(arena, CONFETTI_CAPACIDADE * sizeof(SDL_Color), 16);
+    s_vertices = (SDL_Vertex*)Arena_Alloc(arena, CONFETTI_CAPACIDADE * 4 * sizeof(SDL_Vertex), 16);
+    s_indices  = (int*)Arena_Alloc(arena, CONFETTI_CAPACIDADE * 6 * sizeof(int), 16);
+
+    if (!s_x || !s_y || !s_vx || !s_vy || !s_vida || !s_tam || !s_cor || !s_vertices || !s_indices) {
+        Confetti_Shutdown();
+        return false;
+    }
+
+    for (int i = 0; i < CONFETTI_CAPACIDADE; ++i) {
+        int v = i * 4;
+        int* idx = &s_indices[i * 6];
+        idx[0] = v;     idx[1] = v + 1; idx[2] = v + 2;
+        idx[3] = v + 2; idx[4] = v + 3; idx[5] = v;
+    }
+
+    s_semente = (Uint32)rand() | 1u; // segue o srand() do jogo
+    Confetti_Clear();
+    return true;
+}
+
+void Confetti_Shutdown(void) {
+    s_x = s_y = s_vx = s_vy = s_vida = s_tam = NULL;
+    s_cor = NULL;
+    s_vertices = NULL;
+    s_indices = NULL;
+    s_vivas = 0;
+}
+
+void Confetti_Clear(void) {
+    s_vivas = 0;
+    s_emissaoAcumulada = 0.0f;
+}
+
+void Confetti_SetBudget(int limite) {
+    if (limite < 0) limite = 0;
+    if (limite > CONFETTI_MAX) limite = CONFETTI_MAX;
+    s_limite = limite;
+}
+
+void Confetti_Spawn(int quantidade) {
+    if (!s_x || s_vivas >= s_limite) return;
+    if (quantidade > s_limite - s_vivas) quantidade = s_limite - s_vivas;
+
+    for (int k = 0; k < quantidade; ++k) {
+        int i = s_vivas++;
+        bool esquerda = (aleatorio() & 1) == 0;
+        s_vida[i] = 2.0f + (aleatorio() % 100) / 100.0f;
+        s_x[i]    = esquerda ? -10.0f : SCREEN_WIDTH + 10.0f;
+        s_y[i]    = (float)(aleatorio() % SCREEN_HEIGHT);
+        s_vx[i]   = esquerda ? (100.0f + aleatorio() % 100) : (-100.0f - aleatorio() % 100);
+        s_vy[i]   = -100.0f - aleatorio() % 150;
+        s_tam[i]  = 5.0f + aleatorio() % 5;
+        s_cor[i]  = (SDL_Color){ 100 + aleatorio() % 156, 100 + aleatorio() % 156, 100 + aleatorio() % 156, 255 };
+    }
+}
+
+void Confetti_Emit(float deltaTime) {
+    s_emissaoAcumulada += CONFETTI_POR_SEGUNDO * deltaTime;
+    int quantidade = (int)s_emissaoAcumulada;
+    s_emissaoAcumulada -= (float)quantidade;
+    Confetti_Spawn(quantidade);
+}
+
+void Confetti_Update(float deltaTime) {
+    if (s_vivas == 0) return;
+
+    // 1) Integração: só aritmética sobre arrays contíguos, 4 partículas por vez
+    int fim = (s_vivas + 3) & ~3;
+    float* x    = s_x;
+    float* y    = s_y;
+    float* vx   = s_vx;
+    float* vy   = s_vy;
+    float* vida = s_vida;
+#ifdef CONFETTI_SSE
+    const __m128 dt  = _mm_set1_ps(deltaTime);
+    const __m128 gdt = _mm_set1_ps(CONFETTI_GRAVIDADE * deltaTime);
+    for (int i = 0; i < fim; i += 4) {
+        __m128 pvx = _mm_load_ps(vx + i);
+        __m128 pvy = _mm_load_ps(vy + i);
+        _mm_store_ps(x + i,    _mm_add_ps(_mm_load_ps(x + i), _mm_mul_ps(pvx, dt)));
+        _mm_store_ps(y + i,    _mm_add_ps(_mm_load_ps(y + i), _mm_mul_ps(pvy, dt)));
+        _mm_store_ps(vy + i,   _mm_add_ps(pvy, gdt));
+        _mm_store_ps(vida + i, _mm_sub_ps(_mm_load_ps(vida + i), dt));
+    }
+#else
+    const float gdt = CONFETTI_GRAVIDADE * deltaTime;
+    for (int i = 0; i < fim; ++i) {
+        x[i]    += vx[i] * deltaTime;
+        y[i]    += vy[i] * deltaTime;
+        vy[i]   += gdt;
+        vida[i] -= deltaTime;
+    }
+#endif
+
+    // 2) Remoção: a morta recebe a última viva (a ordem não importa para confete)
+    for (int i = 0; i < s_vivas; ) {
+        if (vida[i] > 0.0f) { ++i; continue; }
+        int ultima = --s_vivas;
+        x[i]     = x[ultima];
+        y[i]     = y[ultima];
+        vx[i]    = vx[ultima];
+        vy[i]    = vy[ultima];
+        vida[i]  = vida[ultima];
+        s_tam[i] = s_tam[ultima];
+        s_cor[i] = s_cor[ultima];
+    }
+}
+
+void Confetti_Render(SDL_Renderer* renderer) {
+    if (s_vivas == 0) return;
+
+    for (int i = 0; i < s_vivas; ++i) {
+        float x0 = s_x[i], y0 = s_y[i];
+        float x1 = x0 + s_tam[i], y1 = y0 + s_tam[i];
+        SDL_Vertex* v = &s_vertices[i * 4];
+        v[0].position.x = x0; v[0].position.y = y0;
+        v[1].position.x = x1; v[1].position.y = y0;
+        v[2].position.x = x1; v[2].position.y = y1;
+        v[3].position.x = x0; v[3].position.y = y1;
+        v[0].color = v[1].color = v[2].color = v[3].color = s_cor[i];
+    }
+
+    SDL_RenderGeometry(renderer, NULL, s_vertices, s_vivas * 4, s_indices, s_vivas * 6);
+}
+
+int Confetti_Count(void) { return s_vivas; }
@@ -0,0 +1,45 @@
+#ifndef CONFETTI_H
+#define CONFETTI_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "auxFuncs/arena.h"
+
+// Sistema de partículas do especial.
+// As partículas vivas ficam compactadas no começo de arrays separados por campo
+// (x[], y[], vx[], ...): nascer é escrever no fim, morrer é trocar com a última.
+
+#define CONFETTI_MAX         8192    // orçamento de partículas vivas
+#define CONFETTI_POR_SEGUNDO 3000.0f // taxa de emissão durante o especial
+
+// Bytes que Confetti_Init vai pedir à arena
+size_t Confetti_ArenaSize(void);
+
+// Tira os arrays da arena da sessão (chamar na carga). Retorna false se não coube.
+bool Confetti_Init(Arena* arena);
+
+// Esquece os arrays; a memória volta junto com a arena.
+void Confetti_Shutdown(void);
+
+// Remove todas as partículas vivas
+void Confetti_Clear(void);
+
+// Emite partículas na taxa CONFETTI_POR_SEGUNDO, independente do FPS
+void Confetti_Emit(float deltaTime);
+
+// Limita as partículas vivas (governador de qualidade); nunca passa de CONFETTI_MAX.
+// As que já existem acima do novo limite terminam a vida normalmente.
+void Confetti_SetBudget(int limite);
+
+// Cria 'quantidade' partículas (cada uma em O(1)); as que não couberem no orçamento são ignoradas
+void Confetti_Spawn(int quantidade);
+
+void Confetti_Update(float deltaTime);
+
+// Desenha todas as partículas vivas com uma única chamada SDL_RenderGeometry
+void Confetti_Render(SDL_Renderer* renderer);
+
+int Confetti_Count(void);
+
+#endif // CONFETTI_H
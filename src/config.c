@@ -0,0 +1,73 @@
+#include "config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#define CONFIG_MAX_ENTRADAS 64
+
+typedef struct {
+    char chave[64];
+    char valor[192];
+} ConfigEntrada;
+
+static ConfigEntrada s_entradas[CONFIG_MAX_ENTRADAS];
+static int           s_totalEntradas = 0;
+
+// Remove espaços e quebras de linha do fim
+static void aparar(char* s) {
+    size_t n = strlen(s);
+    while (n > 0 && isspace((unsigned char)s[n - 1])) s[--n] = '\0';
+}
+
+void Config_Load(const char* caminho) {
+    s_totalEntradas = 0;
+
+    FILE* file = fopen(caminho, "r");
+    if (!file) return; // sem arquivo: tudo no padrão
+
+    char linha[256];
+    char chave[64];
+    char valor[192];
+    while (fgets(linha, sizeof(linha), file)) {
+        if (linha[0] == '#' || linha[0] == '\n') continue;
+        if (sscanf(linha, " %63[^:]:%191[^\n]", chave, valor) != 2) continue;
+        aparar(chave);
+        aparar(valor);
+
+        char* v = valor;
+        while (isspace((unsigned char)*v)) v++;
+
+        // Chave repetida: vale a última
+        int i = 0;
+        while (i < s_totalEntradas && strcmp(s_entradas[i].chave, chave) != 0) i++;
+        if (i == s_totalEntradas) {
+            if (s_totalEntradas >= CONFIG_MAX_ENTRADAS) continue;
+            s_totalEntradas++;
+        }
+        snprintf(s_entradas[i].chave, sizeof(s_entradas[i].chave), "%s", chave);
+        snprintf(s_entradas[i].valor, sizeof(s_entradas[i].valor), "%s", v);
+    }
+    fclose(file);
+    printf("Configuracao '%s' carregada (%d chaves).\n", caminho, s_totalEntradas);
+}
+
+const char* Config_GetString(const char* chave, const char* padrao) {
+    for (int i = 0; i < s_totalEntradas; ++i) {
+        if (strcmp(s_entradas[i].chave, chave) == 0) return s_entradas[i].valor;
+    }
+    return padrao;
+}
+
+int Config_GetInt(const char* chave, int padrao) {
+    const char* valor = Config_GetString(chave, NULL);
+    if (!valor) return padrao;
+    char* fim;
+    long n = strtol(valor, &fim, 10);
+    if (fim == valor) return padrao;
+    return (int)n;
+}
+
+bool Config_Has(const char* chave) {
+    return Config_GetString(chave, NULL) != NULL;
+}
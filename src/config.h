@@ -0,0 +1,34 @@
+#ifndef CONFIG_H
+#define CONFIG_H
+
+#include <stdbool.h>
+
+// Arquivo de configuração do jogador, no mesmo formato do cabeçalho dos .samba:
+//   # comentário
+//   CHAVE:valor
+// Chaves desconhecidas são ignoradas; chaves ausentes usam o padrão de quem lê.
+//
+// Chaves conhecidas:
+//   QUALIDADE       auto (padrão) | minima | baixa | media | alta | 0-3 (nível fixo)
+//   ESCALA_RENDER   50-100: % da resolução lógica em que a cena é desenhada (padrão 100)
+//   OFFSET_MS       atraso (ms) descontado de cada toque no julgamento; positivo = jogador toca tarde.
+//                   A tela de resultados sugere um valor a partir do histórico.
+//   HI_SPEED        25-400: % da velocidade das notas (padrão 100). Muda só o espaçamento na
+//                   pista; o momento de acertar cada nota continua o mesmo.
+//   SINCRONIA       vsync (padrão) | jit: sem vsync, cada quadro lê a entrada o mais perto
+//                   possível do vblank (menos latência, pode rasgar a imagem). Ver pacing.h.
+//   JIT_FOLGA_US    200-8000: margem (µs) antes do vblank previsto no modo jit (padrão 1500)
+#define CONFIG_PATH "config.txt"
+
+// Lê o arquivo (ausente = tudo no padrão). Pode ser chamado de novo para recarregar.
+void Config_Load(const char* caminho);
+
+// Valor cru da chave, ou 'padrao' se ela não existe
+const char* Config_GetString(const char* chave, const char* padrao);
+
+// Valor inteiro da chave, ou 'padrao' se ela não existe ou não é um número
+int Config_GetInt(const char* chave, int padrao);
+
+bool Config_Has(const char* chave);
+
+#endif // CONFIG_H
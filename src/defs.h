@@ -2,11 +2,13 @@
 #define DEFS_H
 
 // --- Configurações da Janela ---
+// Tamanho lógico da tela (LOGICAL_WIDTH x LOGICAL_HEIGHT em auxFuncs/video.h),
+// não o do monitor: o layout abaixo é sempre escrito nesse espaço.
 extern int SCREEN_WIDTH;
 extern int SCREEN_HEIGHT;
 
 // --- Pista de Ritmo ---
-#define RHYTHM_TRACK_WIDTH 1920 // Largura da sua imagem de pista
+#define RHYTHM_TRACK_WIDTH (SCREEN_WIDTH) // A pista ocupa a largura lógica toda
 #define RHYTHM_TRACK_HEIGHT 150 // Altura da sua imagem de pista
 #define RHYTHM_TRACK_POS_X (0) // Quase na direita
 #define RHYTHM_TRACK_POS_Y (SCREEN_HEIGHT - RHYTHM_TRACK_HEIGHT - 50) // Perto do fundo
@@ -39,4 +41,10 @@ extern int SCREEN_HEIGHT;
 #define HIT_WINDOW_BOM 25 // Janela para acerto "Bom"
 #define HIT_WINDOW_OTIMO 12 // Janela mais apertada para "Ótimo"
 
+// As mesmas janelas em ms, na velocidade base. O julgamento é por tempo, então
+// elas não mudam com a velocidade de rolagem do chart nem com o hi-speed.
+#define HIT_WINDOW_OK_MS    (HIT_WINDOW_OK    * 1000.0f / NOTE_SPEED)
+#define HIT_WINDOW_BOM_MS   (HIT_WINDOW_BOM   * 1000.0f / NOTE_SPEED)
+#define HIT_WINDOW_OTIMO_MS (HIT_WINDOW_OTIMO * 1000.0f / NOTE_SPEED)
+
 #endif // DEFS_H
\ No newline at end of file
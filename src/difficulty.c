@@ -0,0 +1,94 @@
+#include "difficulty.h"
+#include <math.h>
+#include <stdlib.h>
+
+#define DIF_PISTAS        3
+#define DIF_TAU_MS        300.0  // a tensão cai a 1/e nesse tempo sem notas
+#define DIF_SECAO_MS      400    // janela de cada pico
+#define DIF_PESO_PICO     0.90   // o pico k (em ordem decrescente) pesa 0.9^k
+#define DIF_JACK_MS       250.0  // abaixo disso, repetir a pista começa a pesar
+#define DIF_JACK          0.8    // esforço extra num jack colado
+#define DIF_ACORDE        0.5    // esforço de cada nota a mais no mesmo instante
+#define DIF_SEGURANDO     0.25   // fração extra por nota longa presa em outra pista
+#define DIF_LONGA         0.4    // a soltura de uma nota longa também é julgada
+#define DIF_ESCALA        1.3    // leva a soma ponderada para a escala exibida
+
+static int pistaDe(SDL_Keycode tecla) {
+    switch (tecla) {
+        case SDLK_z: return 0;
+        case SDLK_x: return 1;
+        case SDLK_c: return 2;
+    }
+    return -1;
+}
+
+static int compararDecrescente(const void* a, const void* b) {
+    float fa = *(const float*)a, fb = *(const float*)b;
+    return (fa < fb) - (fa > fb);
+}
+
+float Difficulty_Rate(const Nota* notas, int total) {
+    if (total <= 0) return 0.0f;
+
+    const Uint32 fimChart = notas[total - 1].hitTime;
+    const int secoes = (int)(fimChart / DIF_SECAO_MS) + 1;
+    float* picos = (float*)calloc((size_t)secoes, sizeof(float));
+    if (!picos) return 0.0f;
+
+    double tensao = 0.0;
+    double anterior = notas[0].hitTime;
+    double ultimaNaPista[DIF_PISTAS] = { -1e9, -1e9, -1e9 };
+    double fimLonga[DIF_PISTAS] = { 0.0, 0.0, 0.0 };
+    int acorde = 0;
+
+    // Uma passada: cada nota decai a tensão até o seu tempo e soma o seu esforço
+    for (int i = 0; i < total; ++i) {
+        const Nota* n = &notas[i];
+        int pista = pistaDe(n->tecla);
+        if (pista < 0) continue;
+        double t = n->hitTime;
+
+        double dt = t - anterior;
+        acorde = (dt <= 0.0 && i > 0) ? acorde + 1 : 0;
+        if (dt > 0.0) tensao *= exp(-dt / DIF_TAU_MS);
+        anterior = t;
+
+        // Nota a mais de um acorde: menos que uma nota solta, é o mesmo movimento
+        double esforco = acorde > 0 ? DIF_ACORDE : 1.0;
+        double dtPista = t - ultimaNaPista[pista];
+        if (dtPista < DIF_JACK_MS) esforco += DIF_JACK * (DIF_JACK_MS - dtPista) / DIF_JACK_MS;
+
+        int presas = 0;
+        for (int p = 0; p < DIF_PISTAS; ++p) if (p != pista && fimLonga[p] > t) ++presas;
+        esforco *= 1.0 + DIF_SEGURANDO * presas;
+
+        if (n->duration > 0) {
+            esforco += DIF_LONGA;
+            fimLonga[pista] = t + n->duration;
+        }
+        ultimaNaPista[pista] = t;
+
+        tensao += esforco;
+        int secao = (int)(n->hitTime / DIF_SECAO_MS);
+        if (tensao > picos[secao]) picos[secao] = (float)tensao;
+    }
+
+    // Só os picos são ordenados (um por janela, não por nota)
+    qsort(picos, (size_t)secoes, sizeof(float), compararDecrescente);
+    double soma = 0.0, peso = 1.0;
+    for (int s = 0; s < secoes && picos[s] > 0.0f; ++s, peso *= DIF_PESO_PICO) soma += picos[s] * peso;
+    free(picos);
+
+    return (float)(soma * (1.0 - DIF_PESO_PICO) * DIF_ESCALA);
+}
+
+DificuldadeFaixa Difficulty_Faixa(float dificuldade) {
+    if (dificuldade < 2.5f) return DIFICULDADE_FACIL;
+    if (dificuldade < 4.5f) return DIFICULDADE_MEDIA;
+    return DIFICULDADE_DIFICIL;
+}
+
+const char* Difficulty_FaixaNome(DificuldadeFaixa faixa) {
+    static const char* nomes[DIFICULDADE_NUM_FAIXAS] = { "Facil", "Medio", "Dificil" };
+    return (faixa >= 0 && faixa < DIFICULDADE_NUM_FAIXAS) ? nomes[faixa] : "?";
+}
@@ -0,0 +1,25 @@
+#ifndef DIFFICULTY_H
+#define DIFFICULTY_H
+
+#include "note.h"
+
+// Dificuldade estimada de um chart, a partir só das notas (em ordem de hitTime).
+// Cada nota soma um esforço numa tensão que decai com o tempo: mais nos jacks
+// (mesma pista em seguida), nos acordes e em tocar segurando notas longas.
+// Os picos da tensão em janelas curtas são ordenados e somados com peso
+// decrescente, então o trecho mais difícil pesa mais que a média da música.
+// Escala aberta: ~1 tranquilo, ~3 médio, 5+ pesado; 0 = sem notas.
+float Difficulty_Rate(const Nota* notas, int total);
+
+// Faixa para filtro e exibição
+typedef enum {
+    DIFICULDADE_FACIL,
+    DIFICULDADE_MEDIA,
+    DIFICULDADE_DIFICIL,
+    DIFICULDADE_NUM_FAIXAS
+} DificuldadeFaixa;
+
+DificuldadeFaixa Difficulty_Faixa(float dificuldade);
+const char*      Difficulty_FaixaNome(DificuldadeFaixa faixa);
+
+#endif // DIFFICULTY_H
@@ -4,8 +4,26 @@
 #include "stage.h"
 #include "note.h"
 #include "leaderboard.h"
+#include "history.h"
+#include "timing.h"
+#include "config.h"
 #include "app.h"
 #include "auxFuncs/utils.h"
+#include "autoplay.h"
+#include "playlist.h"
+#include "confetti.h"
+#include "auxFuncs/profiler.h"
+#include "auxFuncs/trace.h"
+#include "auxFuncs/arena.h"
+#include "auxFuncs/textAtlas.h"
+#include "auxFuncs/allocCounter.h"
+#include "auxFuncs/quality.h"
+#include "auxFuncs/video.h"
+#include "auxFuncs/spectrum.h"
+#include "auxFuncs/fileWatch.h"
+#include "auxFuncs/assetPack.h"
+#include "auxFuncs/texCache.h"
+#include "auxFuncs/pacing.h"
 
 #include <stdio.h>
 #include <time.h>
@@ -25,14 +43,16 @@
 
 #define PANDEIRISTA_PATH       "assets/image/parallax/projeto danilo-Sheet.png"
 #define PANDEIRISTA_FRAMES     8
-#define PANDEIRISTA_FPS        6.0f
+#define PANDEIRISTA_POR_BEAT   4.0f       // ciclo de 8 quadros = 2 beats
+#define PANDEIRISTA_FPS        6.0f       // charts sem BPM
 #define PANDEIRISTA_SCALE      0.40f
 #define PAN_X_OFFSET           (-200.0f)   // posição base levemente à esquerda
 #define PAN_Y_OFFSET           (-15.0f)
 
 #define VELHO_PATH             "assets/image/parallax/velho mesa-Sheet.png"
 #define VELHO_FRAMES           4
-#define VELHO_FPS              4.0f
+#define VELHO_POR_BEAT         2.0f       // ciclo de 4 quadros = 2 beats
+#define VELHO_FPS              4.0f       // charts sem BPM
 #define VELHO_SCALE            0.30f
 #define VELHO_FACE_LEFT        1          // 1 = espelha horizontalmente
 #define VELHO_OFFSET_X         (-60.0f)  
@@ -41,6 +61,13 @@
 // “chão” onde os personagens se ancoram
 #define STREET_LINE_Y          (RHYTHM_TRACK_POS_Y - 64)
 
+// Reação à música (bandas do analisador de espectro, 0..1)
+#define REACAO_SUBIDA_S        0.03f   // constante de tempo ao subir (ataque)
+#define REACAO_DESCIDA_S       0.25f   // ao descer: o pulso se apaga devagar
+#define BG_ZOOM_GRAVE          0.025f  // zoom extra do fundo no grave máximo
+#define PAN_PULO_AGUDO         0.06f   // escala extra do pandeirista no agudo
+#define VELHO_BALANCO_MEDIO    5.0f    // px que o velho sobe no médio (voz, cavaquinho)
+
 /* =========================
    Estruturas de sprites
    ========================= */
@@ -48,7 +75,9 @@ typedef struct {
     SDL_Texture* tex;
     int   frameW, frameH;
     int   frames, current;
-    float fps, timer, scale;
+    float porBeat;  // quadros por beat, quando o chart tem BPM
+    float fps;      // senão, quadros por segundo
+    float scale;
     SDL_FPoint pos; // canto sup-esq do destino após escala
 } AnimatedSprite;
 
@@ -75,6 +104,9 @@ static AnimatedSprite   g_velhoMesa   = {0};
 static VelhoState       g_velhoState  = VELHO_STATE_IDLE;
 static bool             g_velhoStarted= false;
 
+// Bandas suavizadas no render; zeradas quando a qualidade não anima o cenário
+static SpectrumBandas   g_reacao      = {0};
+
 /* =========================
    Render helpers
    ========================= */
@@ -85,10 +117,14 @@ static void DrawCityBackground(SDL_Renderer* r) {
     SDL_QueryTexture(g_bgCity, NULL, NULL, &tw, &th);
     if (tw <= 0 || th <= 0) return;
 
-    float scaleW = (float)SCREEN_WIDTH / (float)tw;
-    int dstW = SCREEN_WIDTH;
+    // Grave: o fundo "respira" (só zoom), ancorado na base (acima da pista).
+    // Sem reação (grave 0) fica exatamente como antes, sem color mod.
+    float zoom = 1.0f + BG_ZOOM_GRAVE * g_reacao.grave;
+
+    float scaleW = (float)SCREEN_WIDTH / (float)tw * zoom;
+    int dstW = (int)(SCREEN_WIDTH * zoom);
     int dstH = (int)(th * scaleW);
-    int dstX = 0;
+    int dstX = (SCREEN_WIDTH - dstW) / 2;
     int dstY = RHYTHM_TRACK_POS_Y - dstH;
 
     SDL_Rect dst = { dstX, dstY, dstW, dstH };
@@ -105,9 +141,17 @@ static void DrawPandeirista(SDL_Renderer* r) {
         g_pandeirista.current * g_pandeirista.frameW, 0,
         g_pandeirista.frameW, g_pandeirista.frameH
     };
-    int w = (int)(g_pandeirista.frameW * g_pandeirista.scale);
-    int h = (int)(g_pandeirista.frameH * g_pandeirista.scale);
-    SDL_Rect dst = { (int)g_pandeirista.pos.x, (int)g_pandeirista.pos.y, w, h };
+    // Agudo (platinelas): cresce um pouco, com os pés no mesmo lugar
+    float baseW = g_pandeirista.frameW * g_pandeirista.scale;
+    float baseH = g_pandeirista.frameH * g_pandeirista.scale;
+    float pulo  = 1.0f + PAN_PULO_AGUDO * g_reacao.agudo;
+    int w = (int)(baseW * pulo);
+    int h = (int)(baseH * pulo);
+    SDL_Rect dst = {
+        (int)(g_pandeirista.pos.x - (w - baseW) * 0.5f),
+        (int)(g_pandeirista.pos.y - (h - baseH)),
+        w, h
+    };
     SDL_RenderCopy(r, g_pandeirista.tex, &src, &dst);
 }
 
@@ -125,7 +169,7 @@ static void DrawVelhoMesa(SDL_Renderer* r) {
     int h = (int)(g_velhoMesa.frameH * g_velhoMesa.scale);
     SDL_Rect dst = {
         (int)(g_velhoMesa.pos.x + VELHO_OFFSET_X),
-        (int)(g_velhoMesa.pos.y + VELHO_OFFSET_Y),
+        (int)(g_velhoMesa.pos.y + VELHO_OFFSET_Y - VELHO_BALANCO_MEDIO * g_reacao.medio),
         w, h
     };
     SDL_RendererFlip flip = VELHO_FACE_LEFT ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE;
@@ -135,13 +179,12 @@ static void DrawVelhoMesa(SDL_Renderer* r) {
 /* =========================
    (Resto do estado do jogo)
    ========================= */
-#define MAX_CONFETTI 200
 #define SPECIAL_DURATION 10.0f
 #define MAX_FEEDBACK_TEXTS 5
-
-#define MAX_LEADERBOARD_ENTRIES 10
-#define MAX_SONGS_IN_LEADERBOARD 50
-#define SONG_NAME_MAX_LEN 64
+#define ATTRACT_DURATION_MS 45000 // quanto tempo o attract do menu fica tocando
+#define ARENA_FOLGA 4096             // bytes extras na arena da sessão (alinhamentos)
+#define PREAQUECIMENTO_NOTAS 128     // notas longas desenhadas no quadro de aquecimento
+#define PREAQUECIMENTO_EVENTOS 64    // eventos empurrados/retirados para aquecer a fila do SDL
 
 typedef enum {
     STATE_PLAYING,
@@ -152,22 +195,12 @@ typedef enum {
     STATE_GAMEOVER
 } GameFlowState;
 
-typedef struct { char text[64]; SDL_Texture* texture; int w, h; } CachedTexture;
-
 typedef struct {
     SDL_Keycode tecla;
     SDL_Rect rect;
     float isPressedTimer;
 } Checker;
 
-typedef struct {
-    bool isActive;
-    SDL_FRect pos;
-    SDL_FPoint velocity;
-    SDL_Color color;
-    float lifetime;
-} ConfettiParticle;
-
 typedef struct {
     bool isActive;
     int type; // 0: Otimo, 1: Bom, 2: Ok
@@ -195,60 +228,144 @@ typedef struct {
     bool isSpecialActive;
     float specialTimer;
 
-    ConfettiParticle* confetti;
     FeedbackText* feedbackTexts;
 
+    Arena arena;              // memória da sessão (confetes, feedback, autoplay)
+    TextAtlas textAtlas;      // glifos da fonte do jogo para os textos que mudam em jogo
+
     Mix_Chunk* failSound;
     Uint32 musicStartTime;
     Uint32 pauseStartTime;
 
-    CachedTexture scoreTexture;
-    CachedTexture comboTexture;
     SDL_Texture* feedbackTextures[3];
-    int cachedScore;
-    int cachedCombo;
 
     int   finalScore;
     int   displayedScore;
     int   notesHit;
+    int   judgements[HISTORY_NUM_JULGAMENTOS]; // para o histórico de partidas
+    int   maxCombo;                // da maratona inteira (tela de resultados)
+    int   maxComboMusica;          // só da música atual (histórico)
+    int   elosMusica;              // acertos que somaram combo na música atual
+    float offsetMs;                // OFFSET_MS do config: atraso do jogador/sistema descontado no julgamento
+    float escalaRolagem;           // px por unidade da tabela de rolagem (NOTE_SPEED/1000 * HI_SPEED)
+    TimingResumo timing;           // erros de tempo de todas as músicas jogadas (a maratona inteira)
     float accuracy;
     int   newHighscoreRank;
     SongLeaderboard* currentSongLeaderboard;
+    SongLeaderboard* proximoRanking;   // maratona: ranking da próxima música, achado antes da troca
+    bool             proximoRankingPronto;
     char  currentName[4];
     int   nameEntryCharIndex;
     int   selectedButtonIndex;
     bool  needsRestart;
 
+    // Tela de resultados retida: a parte fixa é desenhada uma vez numa textura
+    // alvo e só o placar animado, o piscar das letras e os botões mudam por quadro.
+    SDL_Texture*  resultsLayer;
+    GameFlowState resultsLayerState; // estado para o qual a camada foi montada
+    bool          resultsLayerDirty;
+
     ApplicationState nextApplicationState;
 
+    AutoplayMode autoplay;
+    bool attract;             // demo do menu: qualquer tecla volta ao menu
+    SDL_Texture* autoplayTex;
+
+    bool      charting;       // --charting: recarrega o chart ao salvar
+    FileWatch chartWatch;
+    char      caminhoChart[256];
+    int       reservaNotas;   // notas que os buffers da arena comportam
+
+    // Maratona (playlist): placar e combo seguem de uma música para a outra;
+    // os "antes" separam o que é da música atual para o histórico
+    bool maratona;
+    int  scoreAntes, acertosAntes, notasAntes;
+    bool saidaIniciada;       // fade da música que está acabando já disparado
+    bool trocaPendente;       // Game_Update pediu a próxima música ao Game_Run
+    SDL_Texture* playlistTex; // "Maratona 2/5"
+    float playlistTimer;
+
     bool debug;
 } GameState;
 
 static GameState s_gameState;
-static LeaderboardData s_leaderboardData;
+
+// Quadro do sprite no tempo 'tempoMusica': pela grade de beats do chart
+// (o mesmo relógio do julgamento, descontado OFFSET_MS) ou, sem BPM, pelo fps.
+static int Game_QuadroNoTempo(const AnimatedSprite* s, Uint32 tempoMusica) {
+    Sint64 msChart = (Sint64)tempoMusica - (Sint64)s_gameState.offsetMs;
+    if (msChart < 0) msChart = 0;
+
+    Sint64 quadro;
+    const TempoMap* tempo = &s_gameState.faseAtual->tempo;
+    if (TempoMap_Definido(tempo)) {
+        Sint64 tick = TempoMap_TickDoMs(tempo, (Uint32)msChart);
+        quadro = (Sint64)floor((double)tick * s->porBeat / TEMPO_PPQ);
+    } else {
+        quadro = (Sint64)((double)msChart * s->fps / 1000.0);
+    }
+    quadro %= s->frames;
+    return (int)(quadro < 0 ? quadro + s->frames : quadro);
+}
+
+// Autoplay pedido pela linha de comando (vale para todas as partidas)
+static AutoplayMode s_autoplayPadrao = AUTOPLAY_DESLIGADO;
+// Demo pedida pelo menu (vale só para o próximo Game_Run)
+static AutoplayMode s_demoModo       = AUTOPLAY_DESLIGADO;
+static bool         s_demoAttract    = false;
+static bool         s_demoPendente   = false;
+// Modo de charting (linha de comando)
+static bool         s_chartingPadrao = false;
+
+// Notas a mais reservadas no charting: o chart pode crescer durante a partida
+#define CHARTING_FOLGA_NOTAS 1024
+
+// Maratona: a música que acaba sai em fade, a próxima entra em fade curto
+#define PLAYLIST_SAIDA_MS   1500
+#define PLAYLIST_ENTRADA_MS 300
+#define PLAYLIST_AVISO_S    2.5f  // tempo do aviso "Maratona n/N" na tela
+
+#define HI_SPEED_MIN    25  // % de NOTE_SPEED
+#define HI_SPEED_MAX    400
+#define HI_SPEED_PADRAO 100
 
 /* =========================
    Protótipos
    ========================= */
-static void FindOrCreateCurrentSongLeaderboard(const char* songName);
-static void SpawnConfettiParticle();
 static void SpawnFeedbackText(int type, SDL_Rect checkerRect);
-static void UpdateTextureCache(SDL_Renderer* renderer);
+static void Game_ReloadChart(void);
+static bool Game_ReservarBuffers(void);
+static void Game_AbrirRecordes(const char* songFilePath);
+static void Game_PrepararProxima(SDL_Renderer* renderer);
+static void Game_CriarAvisoPlaylist(SDL_Renderer* renderer);
+static void Game_AvancarPlaylist(SDL_Renderer* renderer);
+static void Game_EntrarResultados(void);
+static void Game_RecordPlay(bool cleared, bool abandoned);
+static void Game_Draw(SDL_Renderer* renderer);
+static void Game_PrewarmRenderer(SDL_Renderer* renderer);
+static void Game_ApplyQuality(void);
+static void Game_DrawResultsStatic(SDL_Renderer* renderer);
+static void Game_BuildResultsLayer(SDL_Renderer* renderer);
+static bool Game_FilterAutoplayInput(SDL_Event* e);
 
 /* =========================
    Inicialização
    ========================= */
 int Game_Init(SDL_Renderer* renderer, const char* songFilePath) {
     memset(&s_gameState, 0, sizeof(GameState));
+    Uint64 profCarga = Prof_Begin(PROF_ZONA_CARGA);
 
     s_gameState.health           = 100.0f;
     s_gameState.gameIsRunning    = true;
     s_gameState.needsRestart     = false;
     s_gameState.gameFlowState    = STATE_PLAYING;
     s_gameState.notesHit         = 0;
+    s_gameState.offsetMs         = (float)Config_GetInt("OFFSET_MS", 0);
 
-    s_gameState.cachedScore      = -1;
-    s_gameState.cachedCombo      = -1;
+    int hiSpeed = Config_GetInt("HI_SPEED", HI_SPEED_PADRAO);
+    if (hiSpeed < HI_SPEED_MIN) hiSpeed = HI_SPEED_MIN;
+    if (hiSpeed > HI_SPEED_MAX) hiSpeed = HI_SPEED_MAX;
+    s_gameState.escalaRolagem    = NOTE_SPEED / 1000.0f * (hiSpeed / 100.0f);
 
     s_gameState.specialMeter     = 0.0f;
     s_gameState.isSpecialActive  = false;
@@ -256,29 +373,28 @@ int Game_Init(SDL_Renderer* renderer, const char* songFilePath) {
 
     s_gameState.nextApplicationState = APP_STATE_MENU;
 
-    srand((unsigned)time(NULL));
+    s_gameState.autoplay = s_demoPendente ? s_demoModo : s_autoplayPadrao;
+    s_gameState.attract  = s_demoPendente && s_demoAttract;
+    s_gameState.maratona = Playlist_Ativa() && !s_gameState.attract;
+    s_gameState.charting = s_chartingPadrao && !s_gameState.attract && !s_gameState.maratona;
+    snprintf(s_gameState.caminhoChart, sizeof(s_gameState.caminhoChart), "%s", songFilePath);
 
-    s_gameState.confetti      = (ConfettiParticle*)calloc(MAX_CONFETTI, sizeof(ConfettiParticle));
-    s_gameState.feedbackTexts = (FeedbackText*)calloc(MAX_FEEDBACK_TEXTS, sizeof(FeedbackText));
-    if (!s_gameState.confetti || !s_gameState.feedbackTexts) {
-        printf("Erro ao alocar memoria para particulas/feedback!\n");
-        return 0;
-    }
+    srand((unsigned)time(NULL));
 
-    s_gameState.failSound = Mix_LoadWAV("assets/sound/failBoo.mp3");
+    s_gameState.failSound = Asset_LoadWAV("assets/sound/failBoo.mp3");
     if (!s_gameState.failSound) {
         printf("Aviso: Nao foi possivel carregar o som de gameOver: %s\n", Mix_GetError());
     }
 
-    s_gameState.hitSpritesheet = IMG_LoadTexture(renderer, "assets/image/hitNotesSpriteSheet.png");
+    s_gameState.hitSpritesheet = TexCache_LoadTexture(renderer, "assets/image/hitNotesSpriteSheet.png");
     if (!s_gameState.hitSpritesheet) {
         printf("Erro ao carregar a sprite sheet de acerto: %s\n", IMG_GetError());
         return 0;
     }
 
-    s_gameState.checkerContornoTex[0] = IMG_LoadTexture(renderer, "assets/image/redContorno.png");
-    s_gameState.checkerContornoTex[1] = IMG_LoadTexture(renderer, "assets/image/greenContorno.png");
-    s_gameState.checkerContornoTex[2] = IMG_LoadTexture(renderer, "assets/image/blueContorno.png");
+    s_gameState.checkerContornoTex[0] = TexCache_LoadTexture(renderer, "assets/image/redContorno.png");
+    s_gameState.checkerContornoTex[1] = TexCache_LoadTexture(renderer, "assets/image/greenContorno.png");
+    s_gameState.checkerContornoTex[2] = TexCache_LoadTexture(renderer, "assets/image/blueContorno.png");
     if (!s_gameState.checkerContornoTex[0] || !s_gameState.checkerContornoTex[1] || !s_gameState.checkerContornoTex[2]) {
         printf("Erro ao carregar uma ou mais texturas de contorno: %s\n", IMG_GetError());
         return 0;
@@ -287,14 +403,38 @@ int Game_Init(SDL_Renderer* renderer, const char* songFilePath) {
     s_gameState.faseAtual = Fase_CarregarDeArquivo(renderer, songFilePath);
     if (!s_gameState.faseAtual) return 0;
 
+    Note_SortBySpawn(s_gameState.faseAtual->beatmap, s_gameState.faseAtual->totalNotas, s_gameState.escalaRolagem);
+
+    // Tudo que a partida usa por nota/partícula sai de um único bloco, dimensionado agora
+    // (no charting, com folga para as notas que o chart ganhar durante a partida;
+    // na maratona, para a maior música da lista)
+    int reservaNotas = s_gameState.faseAtual->totalNotas;
+    if (s_gameState.charting) reservaNotas = 2 * reservaNotas + CHARTING_FOLGA_NOTAS;
+    if (s_gameState.maratona && Playlist_MaxNotas() > reservaNotas) reservaNotas = Playlist_MaxNotas();
+    s_gameState.reservaNotas = reservaNotas;
+    size_t tamanhoArena = Confetti_ArenaSize()
+                        + MAX_FEEDBACK_TEXTS * sizeof(FeedbackText)
+                        + (size_t)reservaNotas // marcas do autoplay
+                        + Timing_ArenaSize(2 * reservaNotas) // cabeça + cauda de cada nota
+                        + ARENA_FOLGA;
+    if (!Arena_Init(&s_gameState.arena, tamanhoArena)) {
+        printf("Erro ao alocar a memoria da partida!\n");
+        return 0;
+    }
+    if (!Game_ReservarBuffers()) {
+        printf("Erro ao alocar memoria para particulas/feedback!\n");
+        return 0;
+    }
+
     // Background
-    g_bgCity = IMG_LoadTexture(renderer, BG_PATH);
+    g_reacao = (SpectrumBandas){0};
+    g_bgCity = TexCache_LoadTexture(renderer, BG_PATH);
     if (!g_bgCity) {
         SDL_Log("Falha ao carregar background '%s': %s", BG_PATH, IMG_GetError());
     }
 
     // Pandeirista
-    g_pandeirista.tex = IMG_LoadTexture(renderer, PANDEIRISTA_PATH);
+    g_pandeirista.tex = TexCache_LoadTexture(renderer, PANDEIRISTA_PATH);
     if (!g_pandeirista.tex) {
         SDL_Log("Falha ao carregar sprite do pandeirista: %s", IMG_GetError());
     } else {
@@ -303,8 +443,8 @@ int Game_Init(SDL_Renderer* renderer, const char* songFilePath) {
         g_pandeirista.frameW  = tw / PANDEIRISTA_FRAMES;
         g_pandeirista.frameH  = th;
         g_pandeirista.current = PANDEIRISTA_FRAMES - 1; // idle no último frame
+        g_pandeirista.porBeat = PANDEIRISTA_POR_BEAT;
         g_pandeirista.fps     = PANDEIRISTA_FPS;
-        g_pandeirista.timer   = 0.0f;
         g_pandeirista.scale   = PANDEIRISTA_SCALE;
 
         float w = g_pandeirista.frameW * g_pandeirista.scale;
@@ -317,7 +457,7 @@ int Game_Init(SDL_Renderer* renderer, const char* songFilePath) {
     }
 
     // Velho na mesa
-    g_velhoMesa.tex = IMG_LoadTexture(renderer, VELHO_PATH);
+    g_velhoMesa.tex = TexCache_LoadTexture(renderer, VELHO_PATH);
     if (!g_velhoMesa.tex) {
         SDL_Log("Falha ao carregar sprite do velho: %s", IMG_GetError());
     } else {
@@ -326,8 +466,8 @@ int Game_Init(SDL_Renderer* renderer, const char* songFilePath) {
         g_velhoMesa.frameW  = tw / VELHO_FRAMES;
         g_velhoMesa.frameH  = th;
         g_velhoMesa.current = VELHO_FRAMES - 1; // idle no último frame
+        g_velhoMesa.porBeat = VELHO_POR_BEAT;
         g_velhoMesa.fps     = VELHO_FPS;
-        g_velhoMesa.timer   = 0.0f;
         g_velhoMesa.scale   = VELHO_SCALE;
 
         float w = g_velhoMesa.frameW * g_velhoMesa.scale;
@@ -339,29 +479,23 @@ int Game_Init(SDL_Renderer* renderer, const char* songFilePath) {
         g_velhoStarted = false;
     }
 
-    Leaderboard_Load(&s_leaderboardData);
-
-    const char* simpleName = strrchr(songFilePath, '/');
-    if (simpleName) simpleName++; else simpleName = songFilePath;
-
-    char cleanName[SONG_NAME_MAX_LEN];
-    strncpy(cleanName, simpleName, SONG_NAME_MAX_LEN - 1);
-    cleanName[SONG_NAME_MAX_LEN - 1] = '\0';
-    char* dot = strrchr(cleanName, '.');
-    if (dot) *dot = '\0';
-
-    FindOrCreateCurrentSongLeaderboard(cleanName);
+    Game_AbrirRecordes(songFilePath);
 
     s_gameState.checkers[0] = (Checker){SDLK_z, (SDL_Rect){CHECKER_Z_X, CHECKER_Y, NOTE_WIDTH, NOTE_HEIGHT}, 0.0f};
     s_gameState.checkers[1] = (Checker){SDLK_x, (SDL_Rect){CHECKER_X_X, CHECKER_Y, NOTE_WIDTH, NOTE_HEIGHT}, 0.0f};
     s_gameState.checkers[2] = (Checker){SDLK_c, (SDL_Rect){CHECKER_C_X, CHECKER_Y, NOTE_WIDTH, NOTE_HEIGHT}, 0.0f};
 
-    s_gameState.font = TTF_OpenFont("assets/font/pixelFont.ttf", 48);
+    s_gameState.font = Asset_OpenFont("assets/font/pixelFont.ttf", 48);
     if (!s_gameState.font) {
         printf("Erro ao abrir fonte: %s\n", TTF_GetError());
         return 0;
     }
 
+    if (!TextAtlas_Init(&s_gameState.textAtlas, renderer, s_gameState.font)) {
+        printf("Erro ao montar o atlas de texto: %s\n", TTF_GetError());
+        return 0;
+    }
+
     SDL_Color black = {0, 0, 0, 255};
     const char* keys[] = {"Z", "X", "C"};
     for (int i = 0; i < 3; ++i) {
@@ -382,8 +516,30 @@ int Game_Init(SDL_Renderer* renderer, const char* songFilePath) {
     s_gameState.feedbackTextures[2] = SDL_CreateTextureFromSurface(renderer, surfOk);
     SDL_FreeSurface(surfOk);
 
+    if (s_gameState.autoplay != AUTOPLAY_DESLIGADO || s_gameState.charting) {
+        const char* label = s_gameState.attract ? "DEMO" : s_gameState.charting ? "CHARTING" : "AUTOPLAY";
+        SDL_Surface* surfAuto = TTF_RenderText_Blended(s_gameState.font, label, (SDL_Color){255, 223, 0, 255});
+        if (surfAuto) {
+            s_gameState.autoplayTex = SDL_CreateTextureFromSurface(renderer, surfAuto);
+            SDL_FreeSurface(surfAuto);
+        }
+    }
+    if (s_gameState.maratona) Game_CriarAvisoPlaylist(renderer);
+    Prof_End(PROF_ZONA_CARGA, profCarga);
+
+    if (s_gameState.charting) {
+        FileWatch_Open(&s_gameState.chartWatch, songFilePath);
+        printf("Charting: '%s' sera recarregado a cada gravacao.\n", songFilePath);
+    }
+
+    Game_ApplyQuality();
+    Game_PrewarmRenderer(renderer);
+
     Mix_PlayMusic(s_gameState.faseAtual->musica, 0);
     s_gameState.musicStartTime = SDL_GetTicks();
+    if (s_gameState.maratona) Playlist_PreCarregarProxima();
+    AllocCounter_Begin(); // daqui até os resultados, nenhuma alocação
+    Quality_ResetWindow();
 
     s_gameState.debug = false;
     if (s_gameState.debug){
@@ -398,9 +554,21 @@ int Game_Init(SDL_Renderer* renderer, const char* songFilePath) {
 /* =========================
    Eventos
    ========================= */
+// Acerto que soma combo. Na maratona o combo vem da música anterior: para o
+// histórico vale só a corrente desta música (no máximo os elos dela).
+static void Game_ContarCombo(void) {
+    s_gameState.combo++;
+    s_gameState.elosMusica++;
+    if (s_gameState.combo > s_gameState.maxCombo) s_gameState.maxCombo = s_gameState.combo;
+    int daMusica = s_gameState.combo < s_gameState.elosMusica ? s_gameState.combo : s_gameState.elosMusica;
+    if (daMusica > s_gameState.maxComboMusica) s_gameState.maxComboMusica = daMusica;
+}
+
 void Game_HandleEvent(SDL_Event* e) {
     if (e->type == SDL_QUIT) { s_gameState.gameIsRunning = false; return; }
+    if (e->type == SDL_RENDER_TARGETS_RESET) { s_gameState.resultsLayerDirty = true; return; }
     if (e->type == SDL_KEYDOWN && e->key.keysym.sym == SDLK_ESCAPE) { s_gameState.gameIsRunning = false; return; }
+    if (e->type == SDL_KEYDOWN && e->key.keysym.sym == SDLK_F3 && e->key.repeat == 0) { Prof_ToggleOverlay(); return; }
 
     switch (s_gameState.gameFlowState) {
         case STATE_PLAYING: {
@@ -441,23 +609,28 @@ void Game_HandleEvent(SDL_Event* e) {
                     Checker* checker = &s_gameState.checkers[checkerIndex];
                     checker->isPressedTimer = 0.15f;
                     bool acertouNota = false;
+                    // Julga pelo instante do evento, não pelo frame: vale igual com qualquer velocidade de rolagem
+                    float agoraMs = (float)((Sint64)e->key.timestamp - (Sint64)s_gameState.musicStartTime);
 
                     for (int i = 0; i < s_gameState.faseAtual->totalNotas; ++i) {
                         Nota* nota = &s_gameState.faseAtual->beatmap[i];
                         if (nota->estado != NOTA_ATIVA || nota->tecla != checker->tecla) continue;
 
-                        float dist = fabsf(nota->pos.x - checker->rect.x);
-                        if (dist <= HIT_WINDOW_OK) {
+                        // Erro com sinal, já sem o offset: negativo = antes do alvo (cedo)
+                        float erroMs = agoraMs - (float)nota->hitTime - s_gameState.offsetMs;
+                        float dist = fabsf(erroMs);
+                        if (dist <= HIT_WINDOW_OK_MS) {
+                            Timing_Add(erroMs);
                             s_gameState.notesHit++;
                             acertouNota = true;
-                            s_gameState.combo++;
+                            Game_ContarCombo();
                             if (s_gameState.combo > 0 && s_gameState.combo % 50 == 0) s_gameState.comboPulseTimer = 0.3f;
 
                             int points = 0; int feedbackType = 0;
-                            if (dist <= HIT_WINDOW_OTIMO) {
+                            if (dist <= HIT_WINDOW_OTIMO_MS) {
                                 points = 20; feedbackType = 0; s_gameState.health += 2.0f;
                                 if (!s_gameState.isSpecialActive) s_gameState.specialMeter += 0.75f + (s_gameState.combo * 0.1f);
-                            } else if (dist <= HIT_WINDOW_BOM) {
+                            } else if (dist <= HIT_WINDOW_BOM_MS) {
                                 points = 10; feedbackType = 1; s_gameState.health += 1.0f;
                                 if (!s_gameState.isSpecialActive) s_gameState.specialMeter += 0.5f + (s_gameState.combo * 0.1f);
                             } else {
@@ -466,6 +639,7 @@ void Game_HandleEvent(SDL_Event* e) {
                             }
 
                             SpawnFeedbackText(feedbackType, checker->rect);
+                            if (nota->duration == 0) s_gameState.judgements[feedbackType]++; // longa: julgada no fim
 
                             if (nota->duration > 0) {
                                 nota->estado = NOTA_SEGURANDO;
@@ -493,28 +667,31 @@ void Game_HandleEvent(SDL_Event* e) {
                     int checkerIndex = -1;
                     if (teclaSolta == SDLK_z) checkerIndex = 0; else if (teclaSolta == SDLK_x) checkerIndex = 1; else if (teclaSolta == SDLK_c) checkerIndex = 2; else break;
                     Checker* checker = &s_gameState.checkers[checkerIndex];
+                    float agoraMs = (float)((Sint64)e->key.timestamp - (Sint64)s_gameState.musicStartTime);
 
                     for (int i = 0; i < s_gameState.faseAtual->totalNotas; ++i) {
                         Nota* nota = &s_gameState.faseAtual->beatmap[i];
                         if (nota->estado == NOTA_SEGURANDO && nota->tecla == teclaSolta) {
-                            float bodyLength = NOTE_SPEED * (nota->duration / 1000.0f);
-                            float tail_pos_x = nota->pos.x + bodyLength;
-                            float dist = fabsf(tail_pos_x - checker->rect.x);
+                            float erroMs = agoraMs - (float)(nota->hitTime + nota->duration) - s_gameState.offsetMs;
+                            float dist = fabsf(erroMs);
 
-                            if (dist <= HIT_WINDOW_OK) {
-                                nota->estado = NOTA_ATINGIDA; s_gameState.combo++;
+                            if (dist <= HIT_WINDOW_OK_MS) {
+                                Timing_Add(erroMs);
+                                nota->estado = NOTA_ATINGIDA; Game_ContarCombo();
                                 int points = 0; int feedbackType = 0;
-                                if (dist <= HIT_WINDOW_OTIMO) { points = 40; feedbackType = 0; }
-                                else if (dist <= HIT_WINDOW_BOM) { points = 20; feedbackType = 1; }
+                                if (dist <= HIT_WINDOW_OTIMO_MS) { points = 40; feedbackType = 0; }
+                                else if (dist <= HIT_WINDOW_BOM_MS) { points = 20; feedbackType = 1; }
                                 else { points = 5;  feedbackType = 2; }
 
                                 points *= (s_gameState.combo > 0 ? s_gameState.combo : 1);
                                 if (s_gameState.isSpecialActive) points *= 2;
                                 s_gameState.score += points;
                                 SpawnFeedbackText(feedbackType, checker->rect);
+                                s_gameState.judgements[feedbackType]++;
                             } else {
                                 nota->estado = NOTA_QUEBRADA; nota->despawnTimer = 0.5f;
                                 s_gameState.combo = 0; s_gameState.health -= 2.0f;
+                                s_gameState.judgements[HISTORY_JULG_ERRO]++;
                             }
                             break;
                         }
@@ -547,14 +724,11 @@ void Game_HandleEvent(SDL_Event* e) {
                     s_gameState.nameEntryCharIndex = (s_gameState.nameEntryCharIndex - 1 + 3) % 3;
                 } else if (key == SDLK_RETURN || key == SDLK_KP_ENTER) {
                     if (s_gameState.currentSongLeaderboard) {
-                        for (int i = MAX_LEADERBOARD_ENTRIES - 1; i > s_gameState.newHighscoreRank; --i) {
-                            s_gameState.currentSongLeaderboard->scores[i] = s_gameState.currentSongLeaderboard->scores[i - 1];
-                        }
-                        strcpy(s_gameState.currentSongLeaderboard->scores[s_gameState.newHighscoreRank].name, s_gameState.currentName);
-                        s_gameState.currentSongLeaderboard->scores[s_gameState.newHighscoreRank].score = s_gameState.finalScore;
-                        Leaderboard_Save(&s_leaderboardData);
+                        // Acrescenta um registro no arquivo; o resto do ranking não é regravado
+                        Leaderboard_Insert(s_gameState.currentSongLeaderboard, s_gameState.currentName, s_gameState.finalScore);
                     }
                     s_gameState.gameFlowState = STATE_RESULTS_LEADERBOARD;
+                    s_gameState.resultsLayerDirty = true; // o ranking mudou
                 }
             }
         } break;
@@ -597,21 +771,24 @@ void Game_HandleEvent(SDL_Event* e) {
    Update
    ========================= */
 void Game_Update(float deltaTime) {
-    if (s_gameState.debug) s_gameState.health = 100;
+    if (s_gameState.debug || s_gameState.charting) s_gameState.health = 100;
+
+    /* -------- Charting: chart regravado entra na partida em andamento -------- */
+    if (s_gameState.charting &&
+        (s_gameState.gameFlowState == STATE_PLAYING || s_gameState.gameFlowState == STATE_PAUSE) &&
+        FileWatch_Poll(&s_gameState.chartWatch)) {
+        Game_ReloadChart();
+    }
 
     /* -------- Disparador comum (primeiro contato com contorno) -------- */
+    // Mesma janela em ms do julgamento: em pixels ela mudaria com o hi-speed e o SV
     bool firstContactNow = false;
     if (s_gameState.gameFlowState == STATE_PLAYING) {
+        float agoraMs = (float)(SDL_GetTicks() - s_gameState.musicStartTime) - s_gameState.offsetMs;
         for (int i = 0; i < s_gameState.faseAtual->totalNotas; ++i) {
             Nota* n = &s_gameState.faseAtual->beatmap[i];
             if (n->estado != NOTA_ATIVA) continue;
-
-            float cx = 0.f;
-            if      (n->tecla == SDLK_z) cx = s_gameState.checkers[0].rect.x;
-            else if (n->tecla == SDLK_x) cx = s_gameState.checkers[1].rect.x;
-            else if (n->tecla == SDLK_c) cx = s_gameState.checkers[2].rect.x;
-
-            if (fabsf(n->pos.x - cx) <= HIT_WINDOW_OK) { firstContactNow = true; break; }
+            if (fabsf(agoraMs - (float)n->hitTime) <= HIT_WINDOW_OK_MS) { firstContactNow = true; break; }
         }
     }
     if (firstContactNow) {
@@ -619,26 +796,33 @@ void Game_Update(float deltaTime) {
         if (!g_velhoStarted) { g_velhoStarted = true; g_velhoState = VELHO_STATE_PLAY; }
     }
 
-    /* -------- Avanço de quadros (somente jogando) -------- */
-    if (s_gameState.gameFlowState == STATE_PLAYING) {
-        // pandeirista só anima em PLAY
-        if (g_pandeirista.tex && g_panState == PAN_STATE_PLAY) {
-            g_pandeirista.timer += deltaTime;
-            const float frameTime = 1.0f / g_pandeirista.fps;
-            while (g_pandeirista.timer >= frameTime) {
-                g_pandeirista.timer -= frameTime;
-                g_pandeirista.current = (g_pandeirista.current + 1) % g_pandeirista.frames;
-            }
-        }
-        // velho idem
-        if (g_velhoMesa.tex && g_velhoState == VELHO_STATE_PLAY) {
-            g_velhoMesa.timer += deltaTime;
-            const float frameTime = 1.0f / g_velhoMesa.fps;
-            while (g_velhoMesa.timer >= frameTime) {
-                g_velhoMesa.timer -= frameTime;
-                g_velhoMesa.current = (g_velhoMesa.current + 1) % g_velhoMesa.frames;
+    /* -------- Reação à música: ataque rápido, descida lenta -------- */
+    if (Quality_AnimateCharacters()) {
+        SpectrumBandas bandas;
+        if (Spectrum_Read(&bandas)) {
+            float* atual[3]  = { &g_reacao.grave, &g_reacao.medio, &g_reacao.agudo };
+            float  alvo[3]   = { bandas.grave, bandas.medio, bandas.agudo };
+            float  subida    = 1.0f - expf(-deltaTime / REACAO_SUBIDA_S);
+            float  descida   = 1.0f - expf(-deltaTime / REACAO_DESCIDA_S);
+            for (int i = 0; i < 3; ++i) {
+                float k = alvo[i] > *atual[i] ? subida : descida;
+                *atual[i] += (alvo[i] - *atual[i]) * k;
             }
         }
+    } else {
+        g_reacao = (SpectrumBandas){0};
+    }
+
+    /* -------- Quadros dos personagens (somente jogando, e se a qualidade permite) -------- */
+    if (s_gameState.gameFlowState == STATE_PLAYING && Quality_AnimateCharacters()) {
+        // Quadro = função do tempo da música: presos ao beat, sem acumular
+        // deltaTime, então a pausa (que desloca musicStartTime) e o pulo de
+        // depuração (pularParaSegundos) não tiram ninguém do compasso
+        Uint32 tempoMusica = SDL_GetTicks() - s_gameState.musicStartTime;
+        if (g_pandeirista.tex && g_panState == PAN_STATE_PLAY)
+            g_pandeirista.current = Game_QuadroNoTempo(&g_pandeirista, tempoMusica);
+        if (g_velhoMesa.tex && g_velhoState == VELHO_STATE_PLAY)
+            g_velhoMesa.current = Game_QuadroNoTempo(&g_velhoMesa, tempoMusica);
     }
     // Demais estados (PAUSE/RESULTS/GAMEOVER): não avançam — frames ficam “congelados”.
 
@@ -650,61 +834,30 @@ void Game_Update(float deltaTime) {
             if (s_gameState.isSpecialActive) {
                 s_gameState.specialTimer -= deltaTime;
                 s_gameState.specialMeter = (s_gameState.specialTimer / SPECIAL_DURATION) * 100.0f;
-                SpawnConfettiParticle();
-                SpawnConfettiParticle();
+                Confetti_Emit(deltaTime);
                 if (s_gameState.specialTimer <= 0) { s_gameState.isSpecialActive = false; s_gameState.specialMeter = 0; }
             }
 
-            for (int i = 0; i < MAX_CONFETTI; ++i) {
-                if (s_gameState.confetti[i].isActive) {
-                    ConfettiParticle* p = &s_gameState.confetti[i];
-                    p->lifetime -= deltaTime;
-                    if (p->lifetime <= 0) { p->isActive = false; continue; }
-                    p->pos.x += p->velocity.x * deltaTime;
-                    p->pos.y += p->velocity.y * deltaTime;
-                    p->velocity.y += 300.0f * deltaTime;
-                }
-            }
-
-            if (s_gameState.faseAtual->proximaNotaIndex < s_gameState.faseAtual->totalNotas) {
-                Nota* proxima = &s_gameState.faseAtual->beatmap[s_gameState.faseAtual->proximaNotaIndex];
-                if (tempoAtual >= proxima->spawnTime) {
-                    proxima->estado = NOTA_ATIVA;
-                    s_gameState.faseAtual->proximaNotaIndex++;
-                }
-            }
-
-            for (int i = 0; i < s_gameState.faseAtual->totalNotas; ++i) {
-                Nota* nota = &s_gameState.faseAtual->beatmap[i];
-                if (nota->estado == NOTA_ATIVA || nota->estado == NOTA_SEGURANDO) {
-                    Note_Update(nota, deltaTime);
-                }
-
-                float checker_pos_x = 0;
-                for (int j=0; j<3; ++j) if (s_gameState.checkers[j].tecla == nota->tecla) { checker_pos_x = s_gameState.checkers[j].rect.x; break; }
-
-                if (nota->estado == NOTA_ATIVA) {
-                    if (nota->pos.x < (checker_pos_x - HIT_WINDOW_OK)) {
-                        nota->estado = NOTA_INATIVA; s_gameState.combo = 0; s_gameState.health -= 5.0f;
-                    }
-                } else if (nota->estado == NOTA_SEGURANDO) {
-                    float bodyLength = NOTE_SPEED * (nota->duration / 1000.0f);
-                    float tail_pos_x = nota->pos.x + bodyLength;
-                    if (tail_pos_x < (checker_pos_x - HIT_WINDOW_OK)) {
-                        nota->estado = NOTA_INATIVA; s_gameState.combo = 0; s_gameState.health -= 2.0f;
-                    }
-                }
-
-                if (nota->despawnTimer > 0) {
-                    nota->despawnTimer -= deltaTime;
-                    if (nota->despawnTimer <= 0) nota->estado = NOTA_INATIVA;
-                }
+            Confetti_Update(deltaTime);
+
+            // Uma busca na tabela de rolagem por frame; cada nota é só uma conta a partir dela
+            Fase* fase = s_gameState.faseAtual;
+            double distAgora = ScrollMap_Dist(&fase->rolagem, tempoAtual);
+            NotasPerdidas perdidas;
+            Note_AdvanceFrame(fase->beatmap, fase->totalNotas, &fase->proximaNotaIndex, distAgora,
+                              s_gameState.escalaRolagem, tempoAtual, s_gameState.offsetMs, deltaTime, &perdidas);
+            if (perdidas.toques + perdidas.longas > 0) {
+                s_gameState.combo = 0;
+                s_gameState.health -= 5.0f * perdidas.toques + 2.0f * perdidas.longas;
+                s_gameState.judgements[HISTORY_JULG_ERRO] += perdidas.toques + perdidas.longas;
             }
 
             for (int i = 0; i < 3; ++i)
                 if (s_gameState.checkers[i].isPressedTimer > 0)
                     s_gameState.checkers[i].isPressedTimer -= deltaTime;
 
+            if (s_gameState.playlistTimer > 0) s_gameState.playlistTimer -= deltaTime;
+
             if (s_gameState.comboPulseTimer > 0) s_gameState.comboPulseTimer -= deltaTime;
 
             for (int i = 0; i < MAX_FEEDBACK_TEXTS; ++i) {
@@ -716,30 +869,44 @@ void Game_Update(float deltaTime) {
                 }
             }
 
+            // Maratona: a música que termina sai em fade enquanto a próxima já está na memória
+            const bool temProxima = s_gameState.maratona && Playlist_TemProxima();
+            if (temProxima && !s_gameState.saidaIniciada &&
+                tempoAtual + PLAYLIST_SAIDA_MS >= s_gameState.faseAtual->durationMs) {
+                Mix_FadeOutMusic(PLAYLIST_SAIDA_MS);
+                s_gameState.saidaIniciada = true;
+            }
+
             if (tempoAtual >= s_gameState.faseAtual->durationMs) {
-                s_gameState.gameFlowState = STATE_RESULTS_ANIMATING;
-                s_gameState.finalScore = s_gameState.score;
-                s_gameState.displayedScore = 0;
-                if (s_gameState.faseAtual->totalNotas > 0)
-                    s_gameState.accuracy = ((float)s_gameState.notesHit / (float)s_gameState.faseAtual->totalNotas) * 100.0f;
-
-                s_gameState.newHighscoreRank = -1;
-                if (s_gameState.currentSongLeaderboard)
-                    for (int i = 0; i < MAX_LEADERBOARD_ENTRIES; ++i)
-                        if (s_gameState.finalScore > s_gameState.currentSongLeaderboard->scores[i].score) { s_gameState.newHighscoreRank = i; break; }
+                if (temProxima) s_gameState.trocaPendente = true; // o Game_Run troca (precisa do renderer)
+                else            Game_EntrarResultados();
             }
 
             if (s_gameState.health <= 0) {
+                AllocCounter_End("fim de jogo");
                 s_gameState.gameFlowState = STATE_GAMEOVER;
+                int notas = s_gameState.notasAntes + s_gameState.faseAtual->totalNotas;
+                if (notas > 0)
+                    s_gameState.accuracy = ((float)s_gameState.notesHit / (float)notas) * 100.0f;
+                Game_RecordPlay(false, false);
                 Mix_HaltMusic();
                 if (s_gameState.failSound) Mix_PlayChannel(-1, s_gameState.failSound, 0);
                 s_gameState.selectedButtonIndex = 0;
             }
 
             if (s_gameState.health < 0.0f) s_gameState.health = 0.0f;
+
+            if (s_gameState.gameFlowState == STATE_PLAYING)
+                Autoplay_Update(s_gameState.faseAtual, tempoAtual, deltaTime);
+
+            if (s_gameState.attract && tempoAtual >= ATTRACT_DURATION_MS) {
+                s_gameState.nextApplicationState = APP_STATE_MENU;
+                s_gameState.gameIsRunning = false;
+            }
         } break;
 
         case STATE_RESULTS_ANIMATING: {
+            if (s_gameState.attract) { s_gameState.gameIsRunning = false; break; }
             if (s_gameState.displayedScore < s_gameState.finalScore) {
                 int increment = (int)((s_gameState.finalScore / 2.0f) * deltaTime) + 1;
                 s_gameState.displayedScore += increment;
@@ -769,22 +936,37 @@ void Game_Update(float deltaTime) {
    Render
    ========================= */
 void Game_Render(SDL_Renderer* renderer) {
+    Game_Draw(renderer);
+
+    Uint64 prof = Prof_Begin(PROF_ZONA_PRESENT);
+    Video_Present(renderer);
+    Prof_End(PROF_ZONA_PRESENT, prof);
+}
+
+static void Game_Draw(SDL_Renderer* renderer) {
+    Uint64 prof = Prof_Begin(PROF_ZONA_FUNDO);
     SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
     SDL_RenderClear(renderer);
 
     // 1) Fundo
     DrawCityBackground(renderer);
+    Prof_End(PROF_ZONA_FUNDO, prof);
 
     // 2) Personagens
+    prof = Prof_Begin(PROF_ZONA_SPRITES);
     DrawPandeirista(renderer);
     DrawVelhoMesa(renderer);
+    Prof_End(PROF_ZONA_SPRITES, prof);
 
     // 3) Pista
+    prof = Prof_Begin(PROF_ZONA_PISTA);
     SDL_Rect trackRect = {RHYTHM_TRACK_POS_X, RHYTHM_TRACK_POS_Y, RHYTHM_TRACK_WIDTH, RHYTHM_TRACK_HEIGHT};
     SDL_RenderCopy(renderer, s_gameState.faseAtual->rhythmTrack, NULL, &trackRect);
     rectangleRGBA(renderer, trackRect.x, trackRect.y, trackRect.x + trackRect.w, trackRect.y + trackRect.h, 255, 255, 255, 180);
+    Prof_End(PROF_ZONA_PISTA, prof);
 
     // 4) Checkers
+    prof = Prof_Begin(PROF_ZONA_CHECKERS);
     for (int i = 0; i < 3; ++i) {
         Checker* checker = &s_gameState.checkers[i];
         Sint16 centerX = checker->rect.x + (checker->rect.w / 2);
@@ -804,22 +986,26 @@ void Game_Render(SDL_Renderer* renderer) {
         }
     }
 
+    Prof_End(PROF_ZONA_CHECKERS, prof);
+
     // 5) Notas
+    prof = Prof_Begin(PROF_ZONA_NOTAS);
     for (int i = 0; i < s_gameState.faseAtual->totalNotas; ++i) {
         Nota* nota = &s_gameState.faseAtual->beatmap[i];
         float checker_pos_x = (nota->tecla == SDLK_z) ? CHECKER_Z_X : (nota->tecla == SDLK_x) ? CHECKER_X_X : CHECKER_C_X;
         Note_Render(nota, renderer, checker_pos_x);
     }
 
+    Prof_End(PROF_ZONA_NOTAS, prof);
+
     // 6) Confetes
-    for (int i = 0; i < MAX_CONFETTI; ++i) {
-        if (s_gameState.confetti[i].isActive) {
-            ConfettiParticle* p = &s_gameState.confetti[i];
-            boxRGBA(renderer, (Sint16)p->pos.x, (Sint16)p->pos.y, (Sint16)(p->pos.x + p->pos.w), (Sint16)(p->pos.y + p->pos.h), p->color.r, p->color.g, p->color.b, p->color.a);
-        }
-    }
+    prof = Prof_Begin(PROF_ZONA_CONFETES);
+    Confetti_Render(renderer);
+
+    Prof_End(PROF_ZONA_CONFETES, prof);
 
     // 7) Feedback
+    prof = Prof_Begin(PROF_ZONA_TEXTO);
     for (int i = 0; i < MAX_FEEDBACK_TEXTS; ++i) {
         if (s_gameState.feedbackTexts[i].isActive) {
             FeedbackText* ft = &s_gameState.feedbackTexts[i];
@@ -835,18 +1021,27 @@ void Game_Render(SDL_Renderer* renderer) {
         }
     }
 
-    // 8) Score/Combo
-    UpdateTextureCache(renderer);
-    if (s_gameState.scoreTexture.texture) {
-        SDL_Rect dst = {20, 20, s_gameState.scoreTexture.w, s_gameState.scoreTexture.h};
-        SDL_RenderCopy(renderer, s_gameState.scoreTexture.texture, NULL, &dst);
-    }
-    if (s_gameState.combo > 1 && s_gameState.comboTexture.texture) {
+    // 8) Score/Combo (direto do atlas: nada é criado quando os números mudam)
+    char hudBuffer[32];
+    snprintf(hudBuffer, sizeof(hudBuffer), "Pontos: %d", s_gameState.score);
+    TextAtlas_Draw(&s_gameState.textAtlas, renderer, hudBuffer, 20, 20, (SDL_Color){255, 255, 255, 255}, TEXT_ALIGN_LEFT, 1.0f);
+    if (s_gameState.combo > 1) {
         float scale = (s_gameState.comboPulseTimer > 0) ? 1.0f + 0.5f * (s_gameState.comboPulseTimer / 0.3f) : 1.0f;
-        int w = (int)(s_gameState.comboTexture.w * scale);
-        int h = (int)(s_gameState.comboTexture.h * scale);
-        SDL_Rect dst = { SCREEN_WIDTH / 2 - w / 2, 100, w, h };
-        SDL_RenderCopy(renderer, s_gameState.comboTexture.texture, NULL, &dst);
+        snprintf(hudBuffer, sizeof(hudBuffer), "Combo: %d", s_gameState.combo);
+        TextAtlas_Draw(&s_gameState.textAtlas, renderer, hudBuffer, SCREEN_WIDTH / 2, 100, (SDL_Color){255, 223, 0, 255}, TEXT_ALIGN_CENTER, scale);
+    }
+
+    if (s_gameState.autoplayTex) {
+        int w, h; SDL_QueryTexture(s_gameState.autoplayTex, NULL, NULL, &w, &h);
+        SDL_Rect dst = { SCREEN_WIDTH - w - 20, 20, w, h };
+        SDL_RenderCopy(renderer, s_gameState.autoplayTex, NULL, &dst);
+    }
+    if (s_gameState.playlistTex && s_gameState.playlistTimer > 0.0f) {
+        float a = s_gameState.playlistTimer < 1.0f ? s_gameState.playlistTimer : 1.0f; // some no último segundo
+        int w, h; SDL_QueryTexture(s_gameState.playlistTex, NULL, NULL, &w, &h);
+        SDL_Rect dst = { (SCREEN_WIDTH - w) / 2, 120, w, h };
+        SDL_SetTextureAlphaMod(s_gameState.playlistTex, (Uint8)(a * 255.0f));
+        SDL_RenderCopy(renderer, s_gameState.playlistTex, NULL, &dst);
     }
 
     // 9) Barras
@@ -869,78 +1064,193 @@ void Game_Render(SDL_Renderer* renderer) {
     rectangleRGBA(renderer, specialBarX, specialBarY, specialBarX + specialBarWidth, specialBarY + specialBarHeight, 255, 255, 255, 255);
 
     // 10) Telas de Pause/GameOver/Resultados
-    if (s_gameState.gameFlowState == STATE_GAMEOVER && s_gameState.font) {
+    SDL_Color white = {255, 255, 255, 255};
+    SDL_Color gold  = {255, 223, 0, 255};
+    const TextAtlas* atlas = &s_gameState.textAtlas;
+
+    if (s_gameState.gameFlowState == STATE_GAMEOVER) {
         boxRGBA(renderer, 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, 0, 0, 0, 200);
-        RenderText(renderer, s_gameState.font, "FIM DE JOGO", SCREEN_WIDTH / 2, SCREEN_HEIGHT / 3, (SDL_Color){255, 0, 0, 255}, true);
+        TextAtlas_Draw(atlas, renderer, "FIM DE JOGO", SCREEN_WIDTH / 2, SCREEN_HEIGHT / 3, (SDL_Color){255, 0, 0, 255}, TEXT_ALIGN_CENTER, 1.0f);
         const char* buttonLabels[] = {"Recomecar", "Voltar ao Menu", "Sair"};
-        SDL_Color selectedColor = {255, 223, 0, 255};
-        SDL_Color normalColor   = {255, 255, 255, 255};
         for (int i = 0; i < 3; ++i) {
-            SDL_Color color = (i == s_gameState.selectedButtonIndex) ? selectedColor : normalColor;
-            RenderText(renderer, s_gameState.font, buttonLabels[i], SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 + 50 + i * 60, color, true);
+            SDL_Color color = (i == s_gameState.selectedButtonIndex) ? gold : white;
+            TextAtlas_Draw(atlas, renderer, buttonLabels[i], SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 + 50 + i * 60, color, TEXT_ALIGN_CENTER, 1.0f);
         }
     }
 
-    if ((s_gameState.gameFlowState == STATE_PAUSE) && s_gameState.font) {
+    if (s_gameState.gameFlowState == STATE_PAUSE) {
         boxRGBA(renderer, 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, 0, 0, 0, 150);
-        SDL_Color white = {255,255,255,255};
-        SDL_Surface* surfPause = TTF_RenderText_Blended(s_gameState.font, "PAUSE", white);
-        if (surfPause) {
-            SDL_Texture* texPause = SDL_CreateTextureFromSurface(renderer, surfPause);
-            SDL_Rect dstPause = { SCREEN_WIDTH/2 - surfPause->w/2, SCREEN_HEIGHT/2 - surfPause->h/2, surfPause->w, surfPause->h };
-            SDL_RenderCopy(renderer, texPause, NULL, &dstPause);
-            SDL_FreeSurface(surfPause);
-            SDL_DestroyTexture(texPause);
-        }
+        TextAtlas_Draw(atlas, renderer, "PAUSE", SCREEN_WIDTH / 2,
+                       SCREEN_HEIGHT / 2 - atlas->altura / 2, white, TEXT_ALIGN_CENTER, 1.0f);
     }
 
     if ((s_gameState.gameFlowState >= STATE_RESULTS_ANIMATING) && (s_gameState.gameFlowState != STATE_GAMEOVER)) {
         boxRGBA(renderer, 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, 0, 0, 0, 200);
-        char buffer[128];
-        SDL_Color white = {255, 255, 255, 255};
-        SDL_Color gold  = {255, 223, 0, 255};
-        sprintf(buffer, "%d", s_gameState.displayedScore);
-        RenderText(renderer, s_gameState.font,"Placar Final", SCREEN_WIDTH / 2, 100, white, true);
-        RenderText(renderer, s_gameState.font, buffer,          SCREEN_WIDTH / 2, 150, gold,  true);
-        sprintf(buffer, "Precisao: %.2f%%", s_gameState.accuracy);
-        RenderText(renderer, s_gameState.font, buffer,          SCREEN_WIDTH / 2, 200, white, true);
+
+        if (s_gameState.resultsLayerDirty || s_gameState.resultsLayerState != s_gameState.gameFlowState)
+            Game_BuildResultsLayer(renderer);
+        if (s_gameState.resultsLayer) SDL_RenderCopy(renderer, s_gameState.resultsLayer, NULL, NULL);
+        else                          Game_DrawResultsStatic(renderer); // sem suporte a textura alvo
+
+        char buffer[32];
+        snprintf(buffer, sizeof(buffer), "%d", s_gameState.displayedScore);
+        TextAtlas_Draw(atlas, renderer, buffer, SCREEN_WIDTH / 2, 150, gold, TEXT_ALIGN_CENTER, 1.0f);
 
         if (s_gameState.gameFlowState == STATE_RESULTS_NAME_ENTRY) {
-            RenderText(renderer, s_gameState.font, "NOVO RECORDE!", SCREEN_WIDTH / 2, 300, gold, true);
-            RenderText(renderer, s_gameState.font, "Insira seu nome:", SCREEN_WIDTH / 2, 350, white, true);
             for (int i = 0; i < 3; ++i) {
                 char letterStr[2] = {s_gameState.currentName[i], '\0'};
                 int x_pos = SCREEN_WIDTH / 2 + (i - 1) * 60;
-                int y_pos = 420;
                 bool showChar = !(i == s_gameState.nameEntryCharIndex && (SDL_GetTicks() / 400) % 2 == 0);
-                if (showChar) RenderText(renderer, s_gameState.font, letterStr, x_pos, 420, white, true);
-                int underline_y = y_pos + 55;
-                boxRGBA(renderer, x_pos - 25, underline_y, x_pos + 25, underline_y + 2, 255, 255, 255, 255);
+                if (showChar) TextAtlas_Draw(atlas, renderer, letterStr, x_pos, 420, white, TEXT_ALIGN_CENTER, 1.0f);
             }
         } else if (s_gameState.gameFlowState == STATE_RESULTS_LEADERBOARD) {
-            const char* title = (s_gameState.newHighscoreRank != -1) ? "Parabens!" : "Ranking da Musica";
-            RenderText(renderer, s_gameState.font, title, SCREEN_WIDTH / 2, 60, gold, true);
-            for (int i = 0; i < 5; ++i) {
-                sprintf(buffer, "%2d. %s", i + 1, s_gameState.currentSongLeaderboard->scores[i].name);
-                RenderText(renderer, s_gameState.font, buffer, SCREEN_WIDTH / 4, 280 + i * 40, white, false);
-                sprintf(buffer, "%d", s_gameState.currentSongLeaderboard->scores[i].score);
-                RenderText(renderer, s_gameState.font, buffer, SCREEN_WIDTH / 4 + 200, 280 + i * 40, white, false);
-
-                sprintf(buffer, "%2d. %s", i + 6, s_gameState.currentSongLeaderboard->scores[i+5].name);
-                RenderText(renderer, s_gameState.font, buffer, SCREEN_WIDTH / 2 + 100, 280 + i * 40, white, false);
-                sprintf(buffer, "%d", s_gameState.currentSongLeaderboard->scores[i+5].score);
-                RenderText(renderer, s_gameState.font, buffer, SCREEN_WIDTH / 2 + 300, 280 + i * 40, white, false);
-            }
             const char* buttonLabels[] = {"Jogar Novamente", "Voltar ao Menu", "Sair"};
-            SDL_Color selectedColor = {255,223,0,255}, normalColor = {255,255,255,255};
             for (int i = 0; i < 3; ++i) {
-                SDL_Color color = (i == s_gameState.selectedButtonIndex) ? selectedColor : normalColor;
-                RenderText(renderer, s_gameState.font, buttonLabels[i], SCREEN_WIDTH / 2, 550 + i * 50, color, true);
+                SDL_Color color = (i == s_gameState.selectedButtonIndex) ? gold : white;
+                TextAtlas_Draw(atlas, renderer, buttonLabels[i], SCREEN_WIDTH / 2, 550 + i * 50, color, TEXT_ALIGN_CENTER, 1.0f);
             }
         }
     }
 
-    SDL_RenderPresent(renderer);
+    Prof_RenderOverlay(renderer);
+    Prof_End(PROF_ZONA_TEXTO, prof);
+}
+
+// Repassa o nível atual do governador de qualidade para os efeitos
+static void Game_ApplyQuality(void) {
+    Confetti_SetBudget(Quality_ConfettiBudget());
+    Note_SetOutlineAA(Quality_AntialiasOutlines());
+    if (g_bgCity) SDL_SetTextureScaleMode(g_bgCity, Quality_SmoothBackground() ? SDL_ScaleModeLinear : SDL_ScaleModeNearest);
+}
+
+// Histograma cedo/tarde da partida (na maratona, de todas as músicas), centrado em SCREEN_WIDTH/2 a partir de 'topo'
+static void Game_DrawTimingGraph(SDL_Renderer* renderer, int topo) {
+    const TimingResumo* t = &s_gameState.timing;
+    const TextAtlas* atlas = &s_gameState.textAtlas;
+    SDL_Color white = {255, 255, 255, 255};
+    char buffer[128];
+    if (t->amostras == 0) return;
+
+    const int larguraBarra = 30, alturaMax = 140;
+    const int esquerda = SCREEN_WIDTH / 2 - (TIMING_BALDES * larguraBarra) / 2;
+    const int base = topo + alturaMax;
+    const int centro = TIMING_BALDES / 2;
+    for (int b = 0; b < TIMING_BALDES; ++b) {
+        int h = t->maiorBalde ? t->histograma[b] * alturaMax / t->maiorBalde : 0;
+        if (h == 0) continue;
+        int x = esquerda + b * larguraBarra;
+        if (b < centro)      boxRGBA(renderer, x + 2, base - h, x + larguraBarra - 2, base, 80, 160, 255, 255);  // cedo
+        else if (b > centro) boxRGBA(renderer, x + 2, base - h, x + larguraBarra - 2, base, 255, 150, 60, 255);  // tarde
+        else                 boxRGBA(renderer, x + 2, base - h, x + larguraBarra - 2, base, 90, 220, 110, 255);
+    }
+    boxRGBA(renderer, esquerda, base, esquerda + TIMING_BALDES * larguraBarra, base + 1, 255, 255, 255, 255);
+    TextAtlas_Draw(atlas, renderer, "Cedo", esquerda, base + 8, white, TEXT_ALIGN_LEFT, 0.5f);
+    TextAtlas_Draw(atlas, renderer, "Tarde", esquerda + TIMING_BALDES * larguraBarra, base + 8, white, TEXT_ALIGN_RIGHT, 0.5f);
+
+    snprintf(buffer, sizeof(buffer), "Media %+.1f ms   Desvio %.1f ms   Cedo %d / Tarde %d",
+             t->mediaMs, t->desvioMs, t->cedo, t->tarde);
+    TextAtlas_Draw(atlas, renderer, buffer, SCREEN_WIDTH / 2, base + 40, white, TEXT_ALIGN_CENTER, 0.5f);
+
+    float sugestao; int amostras;
+    if (History_SuggestOffset(&sugestao, &amostras) && fabsf(sugestao - s_gameState.offsetMs) >= 3.0f) {
+        snprintf(buffer, sizeof(buffer), "Sugestao: OFFSET_MS:%d no config.txt (%d notas)", (int)lroundf(sugestao), amostras);
+        TextAtlas_Draw(atlas, renderer, buffer, SCREEN_WIDTH / 2, base + 75, (SDL_Color){255, 223, 0, 255}, TEXT_ALIGN_CENTER, 0.5f);
+    }
+}
+
+// Parte fixa da tela de resultados do estado atual: títulos, precisão,
+// sublinhados do nome, a tabela do ranking e o histograma de tempo.
+static void Game_DrawResultsStatic(SDL_Renderer* renderer) {
+    char buffer[128];
+    SDL_Color white = {255, 255, 255, 255};
+    SDL_Color gold  = {255, 223, 0, 255};
+    RenderText(renderer, s_gameState.font, "Placar Final", SCREEN_WIDTH / 2, 100, white, TEXT_ALIGN_CENTER);
+    sprintf(buffer, "Precisao: %.2f%%", s_gameState.accuracy);
+    RenderText(renderer, s_gameState.font, buffer, SCREEN_WIDTH / 2, 200, white, TEXT_ALIGN_CENTER);
+    Game_DrawTimingGraph(renderer, 720);
+
+    if (s_gameState.gameFlowState == STATE_RESULTS_NAME_ENTRY) {
+        RenderText(renderer, s_gameState.font, "NOVO RECORDE!", SCREEN_WIDTH / 2, 300, gold, TEXT_ALIGN_CENTER);
+        RenderText(renderer, s_gameState.font, "Insira seu nome:", SCREEN_WIDTH / 2, 350, white, TEXT_ALIGN_CENTER);
+        for (int i = 0; i < 3; ++i) {
+            int x_pos = SCREEN_WIDTH / 2 + (i - 1) * 60;
+            int underline_y = 420 + 55;
+            boxRGBA(renderer, x_pos - 25, underline_y, x_pos + 25, underline_y + 2, 255, 255, 255, 255);
+        }
+    } else if (s_gameState.gameFlowState == STATE_RESULTS_LEADERBOARD) {
+        const char* title = (s_gameState.newHighscoreRank != -1) ? "Parabens!" : "Ranking da Musica";
+        RenderText(renderer, s_gameState.font, title, SCREEN_WIDTH / 2, 60, gold, TEXT_ALIGN_CENTER);
+        const SongLeaderboard* lb = s_gameState.currentSongLeaderboard;
+        for (int i = 0; lb && i < LEADERBOARD_VISIBLE_ENTRIES / 2; ++i) {
+            HighScore esq = Leaderboard_Entry(lb, i);
+            HighScore dir = Leaderboard_Entry(lb, i + LEADERBOARD_VISIBLE_ENTRIES / 2);
+            sprintf(buffer, "%2d. %s", i + 1, esq.name);
+            RenderText(renderer, s_gameState.font, buffer, SCREEN_WIDTH / 4, 280 + i * 40, white, TEXT_ALIGN_LEFT);
+            sprintf(buffer, "%d", esq.score);
+            RenderText(renderer, s_gameState.font, buffer, SCREEN_WIDTH / 4 + 200, 280 + i * 40, white, TEXT_ALIGN_LEFT);
+
+            sprintf(buffer, "%2d. %s", i + 1 + LEADERBOARD_VISIBLE_ENTRIES / 2, dir.name);
+            RenderText(renderer, s_gameState.font, buffer, SCREEN_WIDTH / 2 + 100, 280 + i * 40, white, TEXT_ALIGN_LEFT);
+            sprintf(buffer, "%d", dir.score);
+            RenderText(renderer, s_gameState.font, buffer, SCREEN_WIDTH / 2 + 300, 280 + i * 40, white, TEXT_ALIGN_LEFT);
+        }
+    }
+}
+
+// (Re)monta a camada retida. Só roda ao entrar num estado de resultados,
+// quando o ranking muda ou quando o driver perde as texturas alvo.
+static void Game_BuildResultsLayer(SDL_Renderer* renderer) {
+    s_gameState.resultsLayerState = s_gameState.gameFlowState;
+    s_gameState.resultsLayerDirty = false;
+
+    if (!s_gameState.resultsLayer && SDL_RenderTargetSupported(renderer)) {
+        s_gameState.resultsLayer = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
+                                                     SCREEN_WIDTH, SCREEN_HEIGHT);
+        if (s_gameState.resultsLayer) SDL_SetTextureBlendMode(s_gameState.resultsLayer, SDL_BLENDMODE_BLEND);
+    }
+    if (!s_gameState.resultsLayer) return;
+
+    SDL_SetRenderTarget(renderer, s_gameState.resultsLayer);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    SDL_RenderClear(renderer);
+    Game_DrawResultsStatic(renderer);
+    Video_BindScene(renderer);
+}
+
+// Quadro de aquecimento, desenhado e descartado antes da música: confetes no
+// orçamento, notas longas pela pista toda e a tela de pause. Assim o driver
+// cresce seus buffers de comandos/vértices na carga, e não no primeiro especial.
+static void Game_PrewarmRenderer(SDL_Renderer* renderer) {
+    static const SDL_Keycode teclas[3] = { SDLK_z, SDLK_x, SDLK_c };
+    static const float checkers[3] = { CHECKER_Z_X, CHECKER_X_X, CHECKER_C_X };
+
+    GameFlowState estado = s_gameState.gameFlowState;
+    int combo = s_gameState.combo;
+    s_gameState.gameFlowState = STATE_PAUSE;
+    s_gameState.combo = 999999;
+    Confetti_SetBudget(CONFETTI_MAX); // o governador pode subir o orçamento no meio da música
+    Confetti_Spawn(CONFETTI_MAX);
+
+    Game_Draw(renderer);
+    for (int i = 0; i < PREAQUECIMENTO_NOTAS; ++i) {
+        Nota n = Note_CreateLong(teclas[i % 3], 0, 500);
+        n.estado = NOTA_SEGURANDO;
+        n.pos.x = CHECKER_Z_X + (float)i * (RHYTHM_TRACK_WIDTH / (float)PREAQUECIMENTO_NOTAS);
+        Note_Render(&n, renderer, checkers[i % 3]);
+    }
+    SDL_RenderFlush(renderer);
+
+    Confetti_Clear();
+    Confetti_SetBudget(Quality_ConfettiBudget());
+    s_gameState.combo = combo;
+    s_gameState.gameFlowState = estado;
+
+    // A fila de eventos do SDL também guarda suas entradas livres para reuso
+    SDL_Event e;
+    SDL_zero(e);
+    e.type = SDL_USEREVENT;
+    for (int i = 0; i < PREAQUECIMENTO_EVENTOS; ++i) SDL_PushEvent(&e);
+    SDL_FlushEvent(SDL_USEREVENT);
 }
 
 /* =========================
@@ -950,100 +1260,353 @@ ApplicationState Game_Run(SDL_Renderer* renderer, const char* songFilePath) {
     bool restart = false;
     do {
         restart = false;
-        if (!Game_Init(renderer, songFilePath)) return APP_STATE_MENU;
+        if (!Game_Init(renderer, songFilePath)) {
+            Playlist_Limpar();
+            return APP_STATE_MENU;
+        }
 
         Uint32 lastFrameTime = SDL_GetTicks();
 
         while (Game_IsRunning()) {
+            Pacing_WaitForFrame();
+            Uint64 prof = Prof_Begin(PROF_ZONA_EVENTOS);
             SDL_Event e;
-            while (SDL_PollEvent(&e) != 0) Game_HandleEvent(&e);
+            while (SDL_PollEvent(&e) != 0) {
+                Trace_Input(&e);
+                if (s_gameState.autoplay != AUTOPLAY_DESLIGADO && Game_FilterAutoplayInput(&e)) continue;
+                Game_HandleEvent(&e);
+            }
+            while (Autoplay_PollEvent(&e) != 0) { Trace_Input(&e); Game_HandleEvent(&e); }
+            Prof_End(PROF_ZONA_EVENTOS, prof);
 
             Uint32 currentFrameTime = SDL_GetTicks();
             float deltaTime = (currentFrameTime - lastFrameTime) / 1000.0f;
             lastFrameTime = currentFrameTime;
             if (deltaTime > 0.1f) deltaTime = 0.1f;
 
+            prof = Prof_Begin(PROF_ZONA_UPDATE);
             Game_Update(deltaTime);
+            Prof_End(PROF_ZONA_UPDATE, prof);
+            if (s_gameState.trocaPendente) Game_AvancarPlaylist(renderer);
+            else if (s_gameState.maratona && s_gameState.gameFlowState == STATE_PLAYING) Game_PrepararProxima(renderer);
+
             Game_Render(renderer);
+            Prof_EndFrame();
+            if (Quality_Update(Prof_LastFrameMs(), Prof_LastWaitMs())) Game_ApplyQuality();
+        }
+
+        // Saiu com a música tocando (ESC, menu da pausa, janela fechada): também é
+        // uma partida. O attract não conta, é só a demo do menu interrompida.
+        if ((s_gameState.gameFlowState == STATE_PLAYING || s_gameState.gameFlowState == STATE_PAUSE) &&
+            !s_gameState.attract) {
+            Game_RecordPlay(false, true);
         }
 
         restart = Game_NeedsRestart();
+        bool maratona = s_gameState.maratona;
         Game_Shutdown();
+        // "Tentar de novo" numa maratona recomeça a lista toda
+        if (restart && maratona) {
+            Playlist_Reiniciar();
+            songFilePath = Playlist_Atual();
+        }
     } while (restart);
 
+    Playlist_Limpar();
+    s_demoPendente = false;
     return s_gameState.nextApplicationState;
 }
 
-/* =========================
-   UI cache
-   ========================= */
-static void UpdateTextureCache(SDL_Renderer* renderer) {
-    if (s_gameState.score != s_gameState.cachedScore) {
-        s_gameState.cachedScore = s_gameState.score;
-        char buffer[64]; sprintf(buffer, "Pontos: %d", s_gameState.score);
-        SDL_Color white = {255,255,255,255};
-        SDL_Surface* surf = TTF_RenderText_Blended(s_gameState.font, buffer, white);
-        if (surf) {
-            if (s_gameState.scoreTexture.texture) SDL_DestroyTexture(s_gameState.scoreTexture.texture);
-            s_gameState.scoreTexture.texture = SDL_CreateTextureFromSurface(renderer, surf);
-            s_gameState.scoreTexture.w = surf->w; s_gameState.scoreTexture.h = surf->h;
-            SDL_FreeSurface(surf);
-        }
+void Game_SetAutoplay(AutoplayMode mode) {
+    s_autoplayPadrao = mode;
+}
+
+void Game_SetCharting(bool ligado) {
+    s_chartingPadrao = ligado;
+}
+
+void Game_QueueDemo(AutoplayMode mode, bool attract) {
+    s_demoModo     = mode;
+    s_demoAttract  = attract;
+    s_demoPendente = true;
+}
+
+// Com o bot tocando, as teclas de jogo do jogador são ignoradas.
+// No attract, qualquer tecla ou clique devolve o jogador ao menu.
+// Retorna true se o evento foi consumido aqui.
+static bool Game_FilterAutoplayInput(SDL_Event* e) {
+    bool isPress = (e->type == SDL_KEYDOWN || e->type == SDL_MOUSEBUTTONDOWN);
+    if (s_gameState.attract && isPress) {
+        s_gameState.nextApplicationState = APP_STATE_MENU;
+        s_gameState.gameIsRunning = false;
+        return true;
     }
-    if (s_gameState.combo != s_gameState.cachedCombo) {
-        s_gameState.cachedCombo = s_gameState.combo;
-        char buffer[64]; sprintf(buffer, "Combo: %d", s_gameState.combo);
-        SDL_Color gold = {255,223,0,255};
-        SDL_Surface* surf = TTF_RenderText_Blended(s_gameState.font, buffer, gold);
-        if (surf) {
-            if (s_gameState.comboTexture.texture) SDL_DestroyTexture(s_gameState.comboTexture.texture);
-            s_gameState.comboTexture.texture = SDL_CreateTextureFromSurface(renderer, surf);
-            s_gameState.comboTexture.w = surf->w; s_gameState.comboTexture.h = surf->h;
-            SDL_FreeSurface(surf);
-        }
+    if ((e->type == SDL_KEYDOWN || e->type == SDL_KEYUP) && s_gameState.gameFlowState == STATE_PLAYING) {
+        SDL_Keycode k = e->key.keysym.sym;
+        if (k == SDLK_z || k == SDLK_x || k == SDLK_c) return true;
     }
+    return false;
 }
 
 /* =========================
    Helpers
    ========================= */
-static void SpawnConfettiParticle() {
-    for (int i = 0; i < MAX_CONFETTI; ++i) {
-        if (!s_gameState.confetti[i].isActive) {
-            ConfettiParticle* p = &s_gameState.confetti[i];
-            p->isActive = true;
-            p->lifetime = 2.0f + (rand() % 100) / 100.0f;
-            p->pos.x = (rand() % 2 == 0) ? -10.0f : SCREEN_WIDTH + 10.0f;
-            p->velocity.x = (p->pos.x < 0) ? (100 + (rand() % 100)) : (-100 - (rand() % 100));
-            p->pos.y = rand() % SCREEN_HEIGHT;
-            p->velocity.y = -100 - (rand() % 150);
-            p->pos.w = 5 + (rand() % 5);
-            p->pos.h = p->pos.w;
-            p->color = (SDL_Color){100 + rand() % 156, 100 + rand() % 156, 100 + rand() % 156, 255};
-            break;
-        }
+// Grava a partida no histórico (resultados, fim de jogo ou saída no meio da música)
+static void Game_RecordPlay(bool cleared, bool abandoned) {
+    if (s_gameState.charting) return; // o chart mudou no meio da partida: resultado não vale
+    // Na maratona, só a parte desta música
+    const int notas   = s_gameState.faseAtual->totalNotas;
+    const int acertos = s_gameState.notesHit - s_gameState.acertosAntes;
+
+    PlayRecord partida;
+    memset(&partida, 0, sizeof(partida));
+    partida.chartId   = s_gameState.faseAtual->chartId;
+    partida.timestamp = (Sint64)time(NULL);
+    partida.score     = s_gameState.score - s_gameState.scoreAntes;
+    partida.accuracy  = notas > 0 ? (float)acertos / (float)notas * 100.0f : 0.0f;
+    memcpy(partida.judgements, s_gameState.judgements, sizeof(partida.judgements));
+    partida.maxCombo  = s_gameState.maxComboMusica;
+    partida.mods      = s_gameState.autoplay != AUTOPLAY_DESLIGADO ? HISTORY_MOD_AUTOPLAY : 0;
+    partida.cleared   = cleared;
+    partida.abandoned = abandoned;
+
+    // Histórico: só esta música. Resultados: somada às anteriores da maratona,
+    // como placar, precisão e combo
+    TimingResumo musica;
+    Timing_Summarize(&musica);
+    partida.timingAmostras = musica.amostras;
+    partida.timingMediaMs  = musica.amostras ? musica.mediaMs + s_gameState.offsetMs : 0.0f;
+    Timing_Merge(&s_gameState.timing, &musica);
+    History_Record(&partida);
+}
+
+// Buffers da partida tirados da arena; na maratona, refeitos a cada música
+// (a arena já comporta a maior da lista)
+static bool Game_ReservarBuffers(void) {
+    s_gameState.feedbackTexts = (FeedbackText*)Arena_Alloc(&s_gameState.arena, MAX_FEEDBACK_TEXTS * sizeof(FeedbackText), 8);
+    if (!Confetti_Init(&s_gameState.arena) || !s_gameState.feedbackTexts ||
+        !Timing_Init(&s_gameState.arena, 2 * s_gameState.reservaNotas)) {
+        return false;
     }
+    // Semente fixa: duas execuções do mesmo chart geram exatamente os mesmos toques
+    Autoplay_Reset(s_gameState.autoplay, 0x53414D42u, s_gameState.reservaNotas, &s_gameState.arena);
+    return true;
 }
 
-static void FindOrCreateCurrentSongLeaderboard(const char* songName) {
-    for (int i = 0; i < s_leaderboardData.songCount; ++i) {
-        if (strcmp(s_leaderboardData.songLeaderboards[i].songName, songName) == 0) {
-            s_gameState.currentSongLeaderboard = &s_leaderboardData.songLeaderboards[i];
-            return;
-        }
+// Recordes do chart (o nome-base do arquivo é a chave antiga)
+static SongLeaderboard* Game_BuscarRecordes(const char* songFilePath, Uint64 chartId) {
+    const char* simpleName = strrchr(songFilePath, '/');
+    if (simpleName) simpleName++; else simpleName = songFilePath;
+
+    char cleanName[SONG_NAME_MAX_LEN];
+    strncpy(cleanName, simpleName, SONG_NAME_MAX_LEN - 1);
+    cleanName[SONG_NAME_MAX_LEN - 1] = '\0';
+    char* dot = strrchr(cleanName, '.');
+    if (dot) *dot = '\0';
+
+    return Leaderboard_FindOrCreate(Leaderboard_Get(), chartId, cleanName);
+}
+
+static void Game_AbrirRecordes(const char* songFilePath) {
+    s_gameState.currentSongLeaderboard = Game_BuscarRecordes(songFilePath, s_gameState.faseAtual->chartId);
+}
+
+// Maratona, a cada quadro da música: sobe as texturas da próxima aos poucos e
+// acha o ranking dela assim que o chart estiver lido, para a troca não ter
+// nada disso no mesmo quadro.
+static void Game_PrepararProxima(SDL_Renderer* renderer) {
+    Playlist_Preparar(renderer);
+    if (s_gameState.proximoRankingPronto) return;
+
+    const char* caminho;
+    const Fase* proxima = Playlist_ProximaPronta(&caminho);
+    if (!proxima) return;
+    s_gameState.proximoRanking = Game_BuscarRecordes(caminho, proxima->chartId);
+    // Criar o ranking novo pode ter realocado os recordes: acha o atual de novo
+    Game_AbrirRecordes(s_gameState.caminhoChart);
+    s_gameState.proximoRankingPronto = true;
+}
+
+static void Game_CriarAvisoPlaylist(SDL_Renderer* renderer) {
+    if (s_gameState.playlistTex) SDL_DestroyTexture(s_gameState.playlistTex);
+    s_gameState.playlistTex = NULL;
+
+    char texto[32];
+    snprintf(texto, sizeof(texto), "Maratona %d/%d", Playlist_Posicao() + 1, Playlist_Total());
+    SDL_Surface* surf = TTF_RenderText_Blended(s_gameState.font, texto, (SDL_Color){255, 223, 0, 255});
+    if (surf) {
+        s_gameState.playlistTex = SDL_CreateTextureFromSurface(renderer, surf);
+        SDL_FreeSurface(surf);
     }
-    if (s_leaderboardData.songCount < MAX_SONGS_IN_LEADERBOARD) {
-        int newIndex = s_leaderboardData.songCount;
-        s_gameState.currentSongLeaderboard = &s_leaderboardData.songLeaderboards[newIndex];
-        strcpy(s_gameState.currentSongLeaderboard->songName, songName);
-        for (int i = 0; i < MAX_LEADERBOARD_ENTRIES; ++i) {
-            strcpy(s_gameState.currentSongLeaderboard->scores[i].name, "---");
-            s_gameState.currentSongLeaderboard->scores[i].score = 0;
+    s_gameState.playlistTimer = PLAYLIST_AVISO_S;
+}
+
+// Fim da música (ou da maratona): placar final e tela de resultados
+static void Game_EntrarResultados(void) {
+    AllocCounter_End("resultados");
+    s_gameState.gameFlowState = STATE_RESULTS_ANIMATING;
+    s_gameState.finalScore = s_gameState.score;
+    s_gameState.displayedScore = 0;
+    int notas = s_gameState.notasAntes + s_gameState.faseAtual->totalNotas;
+    if (notas > 0)
+        s_gameState.accuracy = ((float)s_gameState.notesHit / (float)notas) * 100.0f;
+    Game_RecordPlay(true, false);
+
+    // O placar da maratona soma várias músicas: não entra nos recordes de nenhuma
+    s_gameState.newHighscoreRank = -1;
+    if (s_gameState.currentSongLeaderboard && s_gameState.autoplay == AUTOPLAY_DESLIGADO &&
+        !s_gameState.charting && !s_gameState.maratona && s_gameState.finalScore > 0) {
+        int rank = Leaderboard_RankFor(s_gameState.currentSongLeaderboard, s_gameState.finalScore);
+        if (rank < LEADERBOARD_VISIBLE_ENTRIES) s_gameState.newHighscoreRank = rank;
+    }
+}
+
+// Maratona: troca a música no lugar, sem Game_Shutdown/Game_Init. A próxima já
+// foi lida pelo thread da playlist e preparada por Game_PrepararProxima (texturas
+// e ranking); aqui os buffers da partida são refeitos na mesma arena.
+static void Game_AvancarPlaylist(SDL_Renderer* renderer) {
+    s_gameState.trocaPendente = false;
+    AllocCounter_End("troca de musica");
+
+    Fase* proxima = Playlist_TomarProxima(renderer);
+    if (!proxima) { // a próxima não carregou: a maratona acaba nesta música
+        Playlist_Limpar();
+        Game_EntrarResultados();
+        return;
+    }
+    Game_RecordPlay(true, false);
+
+    Mix_HaltMusic(); // o fade de saída já deve ter terminado
+    s_gameState.scoreAntes   = s_gameState.score;
+    s_gameState.acertosAntes = s_gameState.notesHit;
+    s_gameState.maxComboMusica = 0;
+    s_gameState.elosMusica     = 0;
+    s_gameState.notasAntes  += s_gameState.faseAtual->totalNotas;
+    memset(s_gameState.judgements, 0, sizeof(s_gameState.judgements));
+
+    Fase_Liberar(s_gameState.faseAtual);
+    s_gameState.faseAtual = proxima;
+    snprintf(s_gameState.caminhoChart, sizeof(s_gameState.caminhoChart), "%s", Playlist_Atual());
+    Note_SortBySpawn(proxima->beatmap, proxima->totalNotas, s_gameState.escalaRolagem);
+    if (s_gameState.proximoRankingPronto) s_gameState.currentSongLeaderboard = s_gameState.proximoRanking;
+    else                                  Game_AbrirRecordes(s_gameState.caminhoChart); // pré-carga sem thread
+    s_gameState.proximoRankingPronto = false;
+
+    Arena_Reset(&s_gameState.arena);
+    if (!Game_ReservarBuffers()) { // não acontece: a arena foi medida para a maior música
+        printf("Erro ao refazer os buffers da partida!\n");
+        s_gameState.gameIsRunning = false;
+        return;
+    }
+    Game_CriarAvisoPlaylist(renderer);
+    s_gameState.saidaIniciada = false;
+
+    Mix_FadeInMusic(proxima->musica, 0, PLAYLIST_ENTRADA_MS);
+    s_gameState.musicStartTime = SDL_GetTicks();
+    Playlist_PreCarregarProxima();
+    AllocCounter_Begin();
+}
+
+// Identidade de uma nota entre duas versões do chart: pista, alvo e duração
+static int Game_CompararChave(const void* a, const void* b) {
+    const Nota* na = (const Nota*)a;
+    const Nota* nb = (const Nota*)b;
+    if (na->hitTime != nb->hitTime) return na->hitTime < nb->hitTime ? -1 : 1;
+    if (na->tecla   != nb->tecla)   return na->tecla   < nb->tecla   ? -1 : 1;
+    if (na->duration != nb->duration) return na->duration < nb->duration ? -1 : 1;
+    return 0;
+}
+
+// Charting: relê só o chart (sem música nem texturas, ~1 ms) e troca o beatmap
+// da partida sem parar o áudio. Notas que continuam iguais levam o estado da
+// partida (acertada, segurando, na tela); só o trecho que mudou entra como novo.
+static void Game_ReloadChart(void) {
+    Uint32 inicio = SDL_GetTicks();
+    AllocCounter_End("recarga do chart");
+
+    Fase* nova = Fase_CarregarChart(s_gameState.caminhoChart);
+    if (!nova) {
+        printf("Charting: chart com erro; a versao anterior continua valendo.\n");
+        AllocCounter_Begin();
+        return;
+    }
+    Fase* fase = s_gameState.faseAtual;
+    if (nova->totalNotas > s_gameState.reservaNotas) {
+        printf("Charting: %d notas passam da reserva da partida; reinicie a fase.\n", nova->totalNotas);
+        Fase_Liberar(nova);
+        AllocCounter_Begin();
+        return;
+    }
+    if (strcmp(nova->caminhoMusica, fase->caminhoMusica) != 0)
+        printf("Charting: MUSICA mudou; vale ao reiniciar a fase.\n");
+
+    // Andamento e rolagem novos já valem para o tempo de agora
+    TempoMap  tempo   = fase->tempo;   fase->tempo   = nova->tempo;   nova->tempo   = tempo;
+    ScrollMap rolagem = fase->rolagem; fase->rolagem = nova->rolagem; nova->rolagem = rolagem;
+    if (nova->durationMs) fase->durationMs = nova->durationMs;
+
+    Uint32 agora = (s_gameState.gameFlowState == STATE_PAUSE ? s_gameState.pauseStartTime : SDL_GetTicks())
+                 - s_gameState.musicStartTime;
+    double distAgora = ScrollMap_Dist(&fase->rolagem, agora);
+    float  limiteMs  = (float)agora - s_gameState.offsetMs - HIT_WINDOW_OK_MS;
+
+    // As duas listas em ordem de chave; uma passada casa as notas que ficaram
+    Nota* antigas = fase->beatmap;
+    Nota* novas   = nova->beatmap;
+    qsort(antigas, (size_t)fase->totalNotas, sizeof(Nota), Game_CompararChave);
+    qsort(novas,   (size_t)nova->totalNotas, sizeof(Nota), Game_CompararChave);
+
+    int ia = 0, in = 0, mantidas = 0, removidas = 0, inseridas = 0;
+    Uint32 trechoIni = UINT32_MAX, trechoFim = 0;
+    while (ia < fase->totalNotas || in < nova->totalNotas) {
+        int c = ia >= fase->totalNotas ? 1
+              : in >= nova->totalNotas ? -1
+              : Game_CompararChave(&antigas[ia], &novas[in]);
+        const Nota* mudou = NULL;
+        if (c == 0) {
+            // Mesma nota: posição de rolagem nova, estado da partida antigo
+            novas[in].estado       = antigas[ia].estado;
+            novas[in].pos          = antigas[ia].pos;
+            novas[in].bodyLength   = antigas[ia].bodyLength;
+            novas[in].despawnTimer = antigas[ia].despawnTimer;
+            ++mantidas; ++ia; ++in;
+        } else if (c < 0) {
+            mudou = &antigas[ia++]; ++removidas;
+        } else {
+            // Nota nova que já devia estar na tela entra direto; a que já passou fica de fora
+            Nota* n = &novas[in++]; ++inseridas;
+            if (distAgora >= Note_SpawnDist(n, s_gameState.escalaRolagem) && (float)n->hitTime >= limiteMs) {
+                n->estado = NOTA_ATIVA;
+                Note_Update(n, distAgora, s_gameState.escalaRolagem);
+            }
+            mudou = n;
+        }
+        if (mudou) {
+            if (mudou->hitTime < trechoIni) trechoIni = mudou->hitTime;
+            if (mudou->hitTime + mudou->duration > trechoFim) trechoFim = mudou->hitTime + mudou->duration;
         }
-        s_leaderboardData.songCount++;
-    } else {
-        s_gameState.currentSongLeaderboard = NULL;
     }
+
+    // De volta à ordem de surgimento; o spawn continua da primeira nota ainda por vir
+    Note_SortBySpawn(novas, nova->totalNotas, s_gameState.escalaRolagem);
+    int proxima = 0;
+    while (proxima < nova->totalNotas && distAgora >= Note_SpawnDist(&novas[proxima], s_gameState.escalaRolagem)) ++proxima;
+
+    fase->beatmap         = novas;
+    fase->totalNotas      = nova->totalNotas;
+    fase->capacidadeNotas = nova->capacidadeNotas;
+    fase->proximaNotaIndex = proxima;
+    nova->beatmap = antigas; // a casca leva embora o beatmap e os mapas antigos
+    Fase_Liberar(nova);
+
+    Autoplay_Resync(fase);
+    AllocCounter_Begin();
+
+    if (removidas + inseridas == 0)
+        printf("Charting: chart recarregado, nenhuma nota mudou (%u ms).\n", SDL_GetTicks() - inicio);
+    else
+        printf("Charting: +%d -%d notas entre %u e %u ms; %d mantidas (%u ms).\n",
+               inseridas, removidas, trechoIni, trechoFim, mantidas, SDL_GetTicks() - inicio);
 }
 
 static void SpawnFeedbackText(int type, SDL_Rect checkerRect) {
@@ -1074,6 +1637,9 @@ static void SpawnFeedbackText(int type, SDL_Rect checkerRect) {
    Shutdown
    ========================= */
 void Game_Shutdown() {
+    AllocCounter_End("saida");
+    if (s_gameState.charting) FileWatch_Close(&s_gameState.chartWatch);
+    s_gameState.trocaPendente = false;
     Fase_Liberar(s_gameState.faseAtual);
 
     for (int i = 0; i < 3; i++) {
@@ -1085,11 +1651,17 @@ void Game_Shutdown() {
     if (s_gameState.hitSpritesheet) SDL_DestroyTexture(s_gameState.hitSpritesheet);
     if (s_gameState.failSound)      Mix_FreeChunk(s_gameState.failSound);
 
-    if (s_gameState.scoreTexture.texture) SDL_DestroyTexture(s_gameState.scoreTexture.texture);
-    if (s_gameState.comboTexture.texture) SDL_DestroyTexture(s_gameState.comboTexture.texture);
+    if (s_gameState.autoplayTex)          SDL_DestroyTexture(s_gameState.autoplayTex);
+    if (s_gameState.playlistTex)          SDL_DestroyTexture(s_gameState.playlistTex);
+    if (s_gameState.resultsLayer)         SDL_DestroyTexture(s_gameState.resultsLayer);
+    TextAtlas_Free(&s_gameState.textAtlas);
+
+    Confetti_Shutdown();
+    Timing_Shutdown();
+    s_gameState.feedbackTexts = NULL;
+    Arena_Free(&s_gameState.arena);
 
-    free(s_gameState.confetti);
-    free(s_gameState.feedbackTexts);
+    s_gameState.currentSongLeaderboard = NULL; // os recordes em si ficam carregados para o menu
 
     if (g_pandeirista.tex) { SDL_DestroyTexture(g_pandeirista.tex); g_pandeirista.tex = NULL; }
     if (g_velhoMesa.tex)    { SDL_DestroyTexture(g_velhoMesa.tex);  g_velhoMesa.tex = NULL; }
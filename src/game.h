@@ -4,6 +4,7 @@
 #include <SDL2/SDL.h>
 #include <stdbool.h>
 #include "app.h" 
+#include "autoplay.h"
 
 // Inicializa o estado do jogo, carrega recursos, etc.
 // Retorna 1 em caso de sucesso, 0 em caso de falha.
@@ -29,5 +30,16 @@ bool Game_NeedsRestart();
 
 ApplicationState Game_Run(SDL_Renderer* renderer, const char* songFilePath);
 
+// Define o autoplay de todas as partidas (ex.: --autoplay na linha de comando).
+void Game_SetAutoplay(AutoplayMode mode);
+
+// Modo de charting: o .samba em jogo é observado e recarregado a cada
+// gravação, com a música tocando; sem fim de jogo nem registro de recordes.
+void Game_SetCharting(bool ligado);
+
+// Pede que apenas o próximo Game_Run seja uma demo tocada pelo bot.
+// Com 'attract' = true, qualquer tecla encerra a demo e volta ao menu.
+void Game_QueueDemo(AutoplayMode mode, bool attract);
+
 
 #endif // GAME_H
\ No newline at end of file
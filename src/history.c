@@ -0,0 +1,347 @@
+#include "history.h"
+#include "auxFuncs/utils.h"
+#include "auxFuncs/idIndex.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Log (inteiros em little-endian):
+//   cabeçalho: "SBHL" | versão u32 | tamanho do registro u32 | FNV-1a u32 dos 12 bytes anteriores
+//   registro:  chartId u64 | timestamp s64 | pontos s32 | precisão em centésimos u32 |
+//              julgamentos u32[4] | maior combo u32 | mods u32 | flags u32 |
+//              erro médio em centésimos de ms s32 | amostras de tempo u32 | FNV-1a u32
+// Índice:
+//   "SBHI" | versão u32 | músicas u32 | bytes do log já contados u64 |
+//   amostras de tempo u64 | soma dos erros em centésimos de ms s64 |
+//   músicas x (chartId u64 | jogadas u32 | clears u32 | melhor precisão u32 | melhor pontuação s32 | última s64) |
+//   FNV-1a u32 de tudo antes
+#define HIST_LOG_MAGIA     "SBHL"
+#define HIST_IDX_MAGIA     "SBHI"
+#define HIST_VERSAO        1
+#define HIST_CABECALHO     16
+#define HIST_REGISTRO      (8 + 8 + 4 + 4 + 4 * HISTORY_NUM_JULGAMENTOS + 4 + 4 + 4 + 4 + 4 + 4)
+#define HIST_IDX_CABECALHO 36
+#define HIST_IDX_ENTRADA   32
+#define HIST_FLAG_CLEAR    1u
+#define HIST_FLAG_ABANDONO 2u
+#define HIST_SUGESTAO_MIN_AMOSTRAS 200 // notas julgadas antes de arriscar uma sugestão de offset
+
+static SongStats* s_stats = NULL;
+static int        s_total = 0;
+static int        s_capacidade = 0;
+static IdIndex    s_indice;
+static Uint64     s_bytesLog = 0; // até onde o log já entrou nos agregados (0 = log ainda sem cabeçalho)
+static bool       s_logTravado = false; // log em formato que não dá para estender: não grava nesta sessão
+
+// Tempo de todas as partidas (sem autoplay), para a sugestão de offset
+static Uint64     s_amostrasTempo = 0;
+static Sint64     s_somaErroCentesimos = 0;
+
+static void montarCabecalhoLog(Uint8* out, Uint32 versao, Uint32 tamanhoRegistro) {
+    memcpy(out, HIST_LOG_MAGIA, 4);
+    PutU32LE(out + 4, versao);
+    PutU32LE(out + 8, tamanhoRegistro);
+    PutU32LE(out + 12, Fnv1a32(out, 12));
+}
+
+static Sint32 centesimos(float ms) {
+    return (Sint32)(ms >= 0.0f ? ms * 100.0f + 0.5f : ms * 100.0f - 0.5f);
+}
+
+static void montarRegistro(Uint8* out, const PlayRecord* r) {
+    Uint8* p = out;
+    PutU64LE(p, r->chartId);                       p += 8;
+    PutU64LE(p, (Uint64)r->timestamp);             p += 8;
+    PutU32LE(p, (Uint32)r->score);                 p += 4;
+    PutU32LE(p, (Uint32)(r->accuracy * 100.0f + 0.5f)); p += 4;
+    for (int i = 0; i < HISTORY_NUM_JULGAMENTOS; ++i) { PutU32LE(p, (Uint32)r->judgements[i]); p += 4; }
+    PutU32LE(p, (Uint32)r->maxCombo);              p += 4;
+    PutU32LE(p, r->mods);                          p += 4;
+    PutU32LE(p, (r->cleared ? HIST_FLAG_CLEAR : 0) | (r->abandoned ? HIST_FLAG_ABANDONO : 0)); p += 4;
+    PutU32LE(p, (Uint32)centesimos(r->timingMediaMs)); p += 4;
+    PutU32LE(p, (Uint32)r->timingAmostras);        p += 4;
+    PutU32LE(p, Fnv1a32(out, HIST_REGISTRO - 4));
+}
+
+static bool lerRegistro(const Uint8* in, PlayRecord* r) {
+    if (GetU32LE(in + HIST_REGISTRO - 4) != Fnv1a32(in, HIST_REGISTRO - 4)) return false;
+    memset(r, 0, sizeof(*r));
+    const Uint8* p = in;
+    r->chartId   = GetU64LE(p);                    p += 8;
+    r->timestamp = (Sint64)GetU64LE(p);            p += 8;
+    r->score     = (int)GetU32LE(p);               p += 4;
+    r->accuracy  = GetU32LE(p) / 100.0f;           p += 4;
+    for (int i = 0; i < HISTORY_NUM_JULGAMENTOS; ++i) { r->judgements[i] = (int)GetU32LE(p); p += 4; }
+    r->maxCombo  = (int)GetU32LE(p);               p += 4;
+    r->mods      = GetU32LE(p);                    p += 4;
+    r->cleared   = (GetU32LE(p) & HIST_FLAG_CLEAR) != 0;
+    r->abandoned = (GetU32LE(p) & HIST_FLAG_ABANDONO) != 0; p += 4;
+    r->timingMediaMs  = (Sint32)GetU32LE(p) / 100.0f; p += 4;
+    r->timingAmostras = (int)GetU32LE(p);
+    return true;
+}
+
+static void esquecerAgregados(void) {
+    free(s_stats);
+    s_stats = NULL;
+    s_total = s_capacidade = 0;
+    IdIndex_Free(&s_indice);
+    s_bytesLog = 0;
+    s_amostrasTempo = 0;
+    s_somaErroCentesimos = 0;
+}
+
+static SongStats* statsDe(Uint64 chartId, bool criar) {
+    int posicao = IdIndex_Get(&s_indice, chartId);
+    if (posicao >= 0) return &s_stats[posicao];
+    if (!criar || chartId == 0) return NULL;
+
+    if (s_total == s_capacidade) {
+        int novaCapacidade = s_capacidade ? s_capacidade * 2 : 64;
+        SongStats* novo = (SongStats*)realloc(s_stats, novaCapacidade * sizeof(SongStats));
+        if (!novo) return NULL;
+        s_stats = novo;
+        s_capacidade = novaCapacidade;
+    }
+    if (!IdIndex_Put(&s_indice, chartId, s_total)) return NULL;
+
+    SongStats* st = &s_stats[s_total++];
+    memset(st, 0, sizeof(*st));
+    st->chartId = chartId;
+    return st;
+}
+
+// Soma uma partida aos agregados
+static void agregar(const PlayRecord* r) {
+    if (r->mods & HISTORY_MOD_AUTOPLAY) return;
+    SongStats* st = statsDe(r->chartId, true);
+    if (!st) return;
+
+    st->plays++;
+    if (r->cleared) {
+        st->clears++;
+        if (r->accuracy > st->bestAccuracy) st->bestAccuracy = r->accuracy;
+    }
+    if (r->score > st->bestScore && !r->abandoned) st->bestScore = r->score; // parcial não é recorde
+    if (r->timestamp > st->lastPlayed) st->lastPlayed = r->timestamp;
+
+    s_amostrasTempo      += (Uint64)r->timingAmostras;
+    s_somaErroCentesimos += (Sint64)centesimos(r->timingMediaMs) * r->timingAmostras;
+}
+
+/* =========================
+   Índice
+   ========================= */
+static void History_SaveIndex(void) {
+    size_t tamanho = HIST_IDX_CABECALHO + (size_t)s_total * HIST_IDX_ENTRADA + 4;
+    Uint8* buf = (Uint8*)malloc(tamanho);
+    if (!buf) return;
+
+    memcpy(buf, HIST_IDX_MAGIA, 4);
+    PutU32LE(buf + 4, HIST_VERSAO);
+    PutU32LE(buf + 8, (Uint32)s_total);
+    PutU64LE(buf + 12, s_bytesLog);
+    PutU64LE(buf + 20, s_amostrasTempo);
+    PutU64LE(buf + 28, (Uint64)s_somaErroCentesimos);
+    Uint8* p = buf + HIST_IDX_CABECALHO;
+    for (int i = 0; i < s_total; ++i, p += HIST_IDX_ENTRADA) {
+        const SongStats* st = &s_stats[i];
+        PutU64LE(p,      st->chartId);
+        PutU32LE(p + 8,  (Uint32)st->plays);
+        PutU32LE(p + 12, (Uint32)st->clears);
+        PutU32LE(p + 16, (Uint32)(st->bestAccuracy * 100.0f + 0.5f));
+        PutU32LE(p + 20, (Uint32)st->bestScore);
+        PutU64LE(p + 24, (Uint64)st->lastPlayed);
+    }
+    PutU32LE(p, Fnv1a32(buf, tamanho - 4));
+
+    char temp[256];
+    snprintf(temp, sizeof(temp), "%s.tmp", HISTORY_INDEX_PATH);
+    FILE* file = fopen(temp, "wb");
+    bool ok = file && fwrite(buf, 1, tamanho, file) == tamanho;
+    if (file && !ok) { fclose(file); remove(temp); }
+    if (!ok || !CommitTempFile(file, temp, HISTORY_INDEX_PATH))
+        printf("Aviso: Nao foi possivel gravar '%s' (sera refeito pelo log).\n", HISTORY_INDEX_PATH);
+    free(buf);
+}
+
+// Carrega os agregados salvos. Retorna false (e deixa tudo vazio) se o índice não serve.
+static bool History_LoadIndex(void) {
+    FILE* file = fopen(HISTORY_INDEX_PATH, "rb");
+    if (!file) return false;
+
+    Uint8 cab[HIST_IDX_CABECALHO];
+    bool ok = fread(cab, 1, HIST_IDX_CABECALHO, file) == HIST_IDX_CABECALHO &&
+              memcmp(cab, HIST_IDX_MAGIA, 4) == 0 && GetU32LE(cab + 4) == HIST_VERSAO;
+    Uint32 total = ok ? GetU32LE(cab + 8) : 0;
+    size_t tamanho = HIST_IDX_CABECALHO + (size_t)total * HIST_IDX_ENTRADA + 4;
+    Uint8* buf = ok ? (Uint8*)malloc(tamanho) : NULL;
+    if (buf) {
+        memcpy(buf, cab, HIST_IDX_CABECALHO);
+        ok = fread(buf + HIST_IDX_CABECALHO, 1, tamanho - HIST_IDX_CABECALHO, file) == tamanho - HIST_IDX_CABECALHO &&
+             GetU32LE(buf + tamanho - 4) == Fnv1a32(buf, tamanho - 4);
+    } else {
+        ok = false;
+    }
+    fclose(file);
+
+    const Uint8* p = buf ? buf + HIST_IDX_CABECALHO : NULL;
+    for (Uint32 i = 0; ok && i < total; ++i, p += HIST_IDX_ENTRADA) {
+        SongStats* st = statsDe(GetU64LE(p), true);
+        if (!st) { ok = false; break; }
+        st->plays        = (int)GetU32LE(p + 8);
+        st->clears       = (int)GetU32LE(p + 12);
+        st->bestAccuracy = GetU32LE(p + 16) / 100.0f;
+        st->bestScore    = (int)GetU32LE(p + 20);
+        st->lastPlayed   = (Sint64)GetU64LE(p + 24);
+    }
+    if (ok) {
+        s_bytesLog           = GetU64LE(buf + 12);
+        s_amostrasTempo      = GetU64LE(buf + 20);
+        s_somaErroCentesimos = (Sint64)GetU64LE(buf + 28);
+    }
+    free(buf);
+
+    if (!ok) esquecerAgregados();
+    return ok;
+}
+
+/* =========================
+   Log
+   ========================= */
+
+// Reescreve o log só com os primeiros 'bytes' (tira um registro cortado do fim)
+static void History_TruncateLog(Uint64 bytes) {
+    FILE* origem = fopen(HISTORY_LOG_PATH, "rb");
+    if (!origem) return;
+    char temp[256];
+    snprintf(temp, sizeof(temp), "%s.tmp", HISTORY_LOG_PATH);
+    FILE* destino = fopen(temp, "wb");
+    if (!destino) { fclose(origem); return; }
+
+    Uint8 bloco[4096];
+    Uint64 faltam = bytes;
+    bool ok = true;
+    while (ok && faltam > 0) {
+        size_t pedir = faltam < sizeof(bloco) ? (size_t)faltam : sizeof(bloco);
+        ok = fread(bloco, 1, pedir, origem) == pedir && fwrite(bloco, 1, pedir, destino) == pedir;
+        faltam -= pedir;
+    }
+    fclose(origem);
+    if (!ok) { fclose(destino); remove(temp); return; }
+    CommitTempFile(destino, temp, HISTORY_LOG_PATH);
+}
+
+// Tira o log do caminho (preservado em HISTORY_LOG_PATH + sufixo) e recomeça
+// vazio: o próximo registro abre um log novo com o cabeçalho atual. Se nem
+// mover der, a sessão não grava (acrescentar ali estragaria o log).
+static void History_MoveLogAside(const char* sufixo, const char* motivo) {
+    char destino[256];
+    snprintf(destino, sizeof(destino), "%s%s", HISTORY_LOG_PATH, sufixo);
+    if (ReplaceFileAtomic(HISTORY_LOG_PATH, destino)) {
+        printf("Aviso: '%s' %s; movido para '%s'.\n", HISTORY_LOG_PATH, motivo, destino);
+    } else {
+        printf("Erro: '%s' %s e nao pode ser movido; partidas desta sessao nao serao gravadas.\n",
+               HISTORY_LOG_PATH, motivo);
+        s_logTravado = true;
+    }
+    esquecerAgregados();
+    History_SaveIndex();
+}
+
+// Soma aos agregados o que foi acrescentado no log depois do último índice
+static void History_CatchUp(void) {
+    FILE* file = fopen(HISTORY_LOG_PATH, "rb");
+    if (!file) {
+        if (s_bytesLog != 0) { esquecerAgregados(); History_SaveIndex(); } // log apagado
+        return;
+    }
+
+    fseek(file, 0, SEEK_END);
+    Uint64 tamanho = (Uint64)ftell(file);
+    if (tamanho < s_bytesLog) esquecerAgregados(); // log trocado: o índice não vale mais
+
+    Uint64 inicio = s_bytesLog;
+    Uint8 buf[HIST_REGISTRO];
+    if (s_bytesLog == 0) {
+        Uint8 atual[HIST_CABECALHO];
+        montarCabecalhoLog(atual, HIST_VERSAO, HIST_REGISTRO);
+        fseek(file, 0, SEEK_SET);
+        bool lido = fread(buf, 1, HIST_CABECALHO, file) == HIST_CABECALHO;
+        if (!lido || memcmp(buf, atual, HIST_CABECALHO) != 0) {
+            fclose(file);
+            History_MoveLogAside(".corrompido", "invalido");
+            return;
+        }
+        s_bytesLog = HIST_CABECALHO;
+    }
+
+    fseek(file, (long)s_bytesLog, SEEK_SET);
+    int novos = 0, invalidos = 0;
+    size_t lidos;
+    while ((lidos = fread(buf, 1, HIST_REGISTRO, file)) == HIST_REGISTRO) {
+        PlayRecord r;
+        if (lerRegistro(buf, &r)) { agregar(&r); novos++; }
+        else invalidos++;
+        s_bytesLog += HIST_REGISTRO;
+    }
+    fclose(file);
+
+    if (invalidos > 0) printf("Aviso: %d partida(s) invalida(s) em '%s' ignoradas.\n", invalidos, HISTORY_LOG_PATH);
+    if (lidos > 0) History_TruncateLog(s_bytesLog); // gravação interrompida no meio de um registro
+    if (s_bytesLog != inicio) {
+        printf("Historico: %d partida(s) nova(s) somadas ao indice.\n", novos);
+        History_SaveIndex();
+    }
+}
+
+void History_Init(void) {
+    s_logTravado = false;
+    esquecerAgregados();
+    History_LoadIndex();
+    History_CatchUp();
+}
+
+void History_Shutdown(void) {
+    esquecerAgregados();
+}
+
+void History_Record(const PlayRecord* partida) {
+    if (s_logTravado) return;
+    FILE* file = fopen(HISTORY_LOG_PATH, "ab");
+    if (!file) {
+        printf("Erro: Nao foi possivel gravar a partida em '%s'.\n", HISTORY_LOG_PATH);
+        return;
+    }
+
+    Uint8 buf[HIST_REGISTRO];
+    fseek(file, 0, SEEK_END);
+    bool ok = true;
+    if (ftell(file) == 0) {
+        montarCabecalhoLog(buf, HIST_VERSAO, HIST_REGISTRO);
+        ok = fwrite(buf, 1, HIST_CABECALHO, file) == HIST_CABECALHO;
+    }
+    montarRegistro(buf, partida);
+    ok = ok && fwrite(buf, 1, HIST_REGISTRO, file) == HIST_REGISTRO;
+    Uint64 fim = (Uint64)ftell(file);
+    ok = (fclose(file) == 0) && ok;
+    if (!ok) return; // o que chegou ao disco é recuperado no próximo History_Init
+
+    // Só avança o índice se ele já cobria todo o log antes deste registro
+    Uint64 esperado = (s_bytesLog == 0 ? HIST_CABECALHO : s_bytesLog) + HIST_REGISTRO;
+    if (fim == esperado) {
+        agregar(partida);
+        s_bytesLog = esperado;
+        History_SaveIndex();
+    }
+}
+
+const SongStats* History_GetStats(Uint64 chartId) {
+    return statsDe(chartId, false);
+}
+
+bool History_SuggestOffset(float* offsetMs, int* amostras) {
+    *amostras = (int)s_amostrasTempo;
+    *offsetMs = s_amostrasTempo ? (float)((double)s_somaErroCentesimos / (double)s_amostrasTempo / 100.0) : 0.0f;
+    return s_amostrasTempo >= HIST_SUGESTAO_MIN_AMOSTRAS;
+}
@@ -0,0 +1,69 @@
+#ifndef HISTORY_H
+#define HISTORY_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+// Histórico de partidas.
+//  - historico.sbh: log só de acréscimo, um registro de tamanho fixo (com soma
+//    de verificação) por partida jogada, terminada ou não.
+//  - historico.idx: agregados por chart (jogadas, clears, melhor precisão...)
+//    e até que byte do log eles já contam. Na carga só o trecho do log depois
+//    desse ponto é relido; sem índice válido, o log inteiro é reprocessado.
+#define HISTORY_LOG_PATH   "historico.sbh"
+#define HISTORY_INDEX_PATH "historico.idx"
+
+// Um julgamento por nota: a soma nunca passa do total de notas do chart (só
+// fica abaixo numa partida que não chegou ao fim). A nota longa é julgada uma
+// vez, no fim: pela soltura, ou erro se foi solta fora da janela, segurada
+// além do fim ou se a cabeça passou sem toque. O acerto da cabeça vale pontos
+// e combo, mas não entra na contagem.
+typedef enum {
+    HISTORY_JULG_OTIMO,
+    HISTORY_JULG_BOM,
+    HISTORY_JULG_OK,
+    HISTORY_JULG_ERRO,
+    HISTORY_NUM_JULGAMENTOS
+} HistoryJulgamento;
+
+// Modificadores ativos na partida (bits)
+#define HISTORY_MOD_AUTOPLAY (1u << 0) // o bot jogou; não conta nos agregados
+
+typedef struct {
+    Uint64 chartId;
+    Sint64 timestamp;  // time(NULL) no fim da partida
+    int    score;
+    float  accuracy;   // 0-100
+    int    judgements[HISTORY_NUM_JULGAMENTOS];
+    int    maxCombo;
+    Uint32 mods;
+    bool   cleared;    // chegou aos resultados (false = fim de jogo ou abandonada)
+    bool   abandoned;  // saiu no meio da música (ESC, menu, fechar a janela)
+    float  timingMediaMs;  // erro médio de tempo sem o OFFSET_MS do config (negativo = cedo)
+    int    timingAmostras; // notas julgadas que entraram na média
+} PlayRecord;
+
+typedef struct {
+    Uint64 chartId;
+    int    plays;
+    int    clears;
+    float  bestAccuracy; // entre as partidas terminadas
+    int    bestScore;
+    Sint64 lastPlayed;
+} SongStats;
+
+// Lê o índice e alcança o log. Chamar uma vez na inicialização.
+void History_Init(void);
+void History_Shutdown(void);
+
+// Acrescenta a partida no log e atualiza os agregados (e o índice em disco)
+void History_Record(const PlayRecord* partida);
+
+// Agregados do chart, ou NULL se ele nunca foi jogado
+const SongStats* History_GetStats(Uint64 chartId);
+
+// Erro médio de todas as partidas, ponderado pelas notas julgadas: é o OFFSET_MS
+// que centraria os toques do jogador. Retorna false se ainda há poucas amostras.
+bool History_SuggestOffset(float* offsetMs, int* amostras);
+
+#endif // HISTORY_H
@@ -0,0 +1,331 @@
+#include "leaderboard.h"
+#include "auxFuncs/utils.h"
+#include <SDL2/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Formato em disco (inteiros em little-endian):
+//   cabeçalho: "SBLB" | versão u32 | tamanho do registro u32 | FNV-1a u32 dos 12 bytes anteriores
+//   registro:  chartId u64 | música char[64] | nome char[4] | pontuação s32 | FNV-1a u32 dos bytes anteriores
+// A versão 1 não tinha o chartId; é lida e regravada na versão atual.
+#define LB_MAGIA          "SBLB"
+#define LB_VERSAO         2
+#define LB_CABECALHO      16
+#define LB_REGISTRO_V1    (SONG_NAME_MAX_LEN + 4 + 4 + 4)
+#define LB_REGISTRO       (8 + LB_REGISTRO_V1)
+#define LB_TEMP_SUFIXO    ".tmp"
+#define LB_RUIM_SUFIXO    ".corrompido"
+
+// Layout do leaderboards.dat antigo (fread/fwrite da struct inteira)
+#define LB_LEGADO_ENTRADAS 10
+#define LB_LEGADO_MUSICAS  50
+typedef struct {
+    char songName[SONG_NAME_MAX_LEN];
+    HighScore scores[LB_LEGADO_ENTRADAS];
+} LegadoMusica;
+typedef struct {
+    int songCount;
+    LegadoMusica songLeaderboards[LB_LEGADO_MUSICAS];
+} LegadoDados;
+
+static void montarCabecalho(Uint8* out, Uint32 versao, Uint32 tamanhoRegistro) {
+    memcpy(out, LB_MAGIA, 4);
+    PutU32LE(out + 4, versao);
+    PutU32LE(out + 8, tamanhoRegistro);
+    PutU32LE(out + 12, Fnv1a32(out, 12));
+}
+
+static void montarRegistro(Uint8* out, const SongLeaderboard* lb, const HighScore* hs) {
+    memset(out, 0, LB_REGISTRO);
+    PutU64LE(out, lb->chartId);
+    Uint8* p = out + 8;
+    strncpy((char*)p, lb->songName, SONG_NAME_MAX_LEN - 1);
+    memcpy(p + SONG_NAME_MAX_LEN, hs->name, 3);
+    PutU32LE(p + SONG_NAME_MAX_LEN + 4, (Uint32)hs->score);
+    PutU32LE(out + LB_REGISTRO - 4, Fnv1a32(out, LB_REGISTRO - 4));
+}
+
+/* =========================
+   Memória
+   ========================= */
+static LeaderboardData s_dados;
+static bool            s_carregado = false;
+
+static SongLeaderboard* buscarPorId(LeaderboardData* data, Uint64 chartId) {
+    int posicao = IdIndex_Get(&data->indice, chartId);
+    return posicao >= 0 ? &data->songs[posicao] : NULL;
+}
+
+// Recordes antigos, gravados antes do chartId, só podem ser achados pelo nome.
+// Nunca crescem (toda música nova já nasce com id), então a varredura é limitada.
+static SongLeaderboard* buscarLegado(LeaderboardData* data, const char* songName) {
+    if (data->legados == 0 || !songName) return NULL;
+    for (int i = 0; i < data->songCount; ++i) {
+        if (data->songs[i].chartId == 0 && strcmp(data->songs[i].songName, songName) == 0) return &data->songs[i];
+    }
+    return NULL;
+}
+
+static SongLeaderboard* criar(LeaderboardData* data, Uint64 chartId, const char* songName) {
+    if (data->songCount == data->songCapacity) {
+        int novaCapacidade = data->songCapacity ? data->songCapacity * 2 : 16;
+        SongLeaderboard* novo = (SongLeaderboard*)realloc(data->songs, novaCapacidade * sizeof(SongLeaderboard));
+        if (!novo) return NULL;
+        data->songs = novo;
+        data->songCapacity = novaCapacidade;
+    }
+    int posicao = data->songCount;
+    if (chartId != 0 && !IdIndex_Put(&data->indice, chartId, posicao)) return NULL;
+    if (chartId == 0) data->legados++;
+
+    data->songCount++;
+    SongLeaderboard* lb = &data->songs[posicao];
+    memset(lb, 0, sizeof(*lb));
+    lb->chartId = chartId;
+    snprintf(lb->songName, sizeof(lb->songName), "%s", songName ? songName : "");
+    return lb;
+}
+
+// Busca usada pela carga: sem adoção e sem regravar
+static SongLeaderboard* buscarOuCriarRegistro(LeaderboardData* data, Uint64 chartId, const char* songName) {
+    SongLeaderboard* lb = chartId != 0 ? buscarPorId(data, chartId) : buscarLegado(data, songName);
+    return lb ? lb : criar(data, chartId, songName);
+}
+
+SongLeaderboard* Leaderboard_Find(LeaderboardData* data, Uint64 chartId, const char* songName) {
+    // Só leitura: um recorde antigo ainda não adotado é achado pelo nome, sem regravar nada
+    SongLeaderboard* lb = buscarPorId(data, chartId);
+    return lb || chartId == 0 ? lb : buscarLegado(data, songName);
+}
+
+bool Leaderboard_Adopt(LeaderboardData* data, Uint64 chartId, const char* songName) {
+    if (chartId == 0 || buscarPorId(data, chartId)) return false;
+
+    SongLeaderboard* lb = buscarLegado(data, songName);
+    if (!lb || !IdIndex_Put(&data->indice, chartId, (int)(lb - data->songs))) return false;
+
+    // Daqui em diante ele é achado pelo id
+    lb->chartId = chartId;
+    data->legados--;
+    return true;
+}
+
+SongLeaderboard* Leaderboard_FindOrCreate(LeaderboardData* data, Uint64 chartId, const char* songName) {
+    SongLeaderboard* lb = Leaderboard_Find(data, chartId, songName);
+    return lb ? lb : criar(data, chartId, songName);
+}
+
+int Leaderboard_RankFor(const SongLeaderboard* lb, int score) {
+    // Lista decrescente: busca binária pela primeira pontuação menor que 'score'
+    int lo = 0, hi = lb ? lb->scoreCount : 0;
+    while (lo < hi) {
+        int meio = (lo + hi) / 2;
+        if (lb->scores[meio].score >= score) lo = meio + 1; else hi = meio;
+    }
+    return lo;
+}
+
+HighScore Leaderboard_Entry(const SongLeaderboard* lb, int rank) {
+    if (lb && rank >= 0 && rank < lb->scoreCount) return lb->scores[rank];
+    HighScore vazio = { "---", 0 };
+    return vazio;
+}
+
+// Só a parte em memória da inserção (usada também pela carga)
+static int inserirEmMemoria(SongLeaderboard* lb, const char* name, int score) {
+    if (lb->scoreCount == lb->scoreCapacity) {
+        int novaCapacidade = lb->scoreCapacity ? lb->scoreCapacity * 2 : 16;
+        HighScore* novo = (HighScore*)realloc(lb->scores, novaCapacidade * sizeof(HighScore));
+        if (!novo) return -1;
+        lb->scores = novo;
+        lb->scoreCapacity = novaCapacidade;
+    }
+
+    int rank = Leaderboard_RankFor(lb, score);
+    memmove(&lb->scores[rank + 1], &lb->scores[rank], (lb->scoreCount - rank) * sizeof(HighScore));
+    HighScore* hs = &lb->scores[rank];
+    memset(hs->name, 0, sizeof(hs->name));
+    strncpy(hs->name, name, sizeof(hs->name) - 1);
+    hs->score = score;
+    lb->scoreCount++;
+    return rank;
+}
+
+static void Leaderboard_Free(LeaderboardData* data) {
+    for (int i = 0; i < data->songCount; ++i) free(data->songs[i].scores);
+    free(data->songs);
+    IdIndex_Free(&data->indice);
+    memset(data, 0, sizeof(*data));
+}
+
+/* =========================
+   Disco
+   ========================= */
+
+// Reescreve o arquivo inteiro com o conteúdo em memória, via temporário + rename.
+// Só roda na migração ou depois de achar registros inválidos; salvar um recorde não passa aqui.
+bool Leaderboard_WriteAll(const LeaderboardData* data) {
+    char temp[256];
+    snprintf(temp, sizeof(temp), "%s%s", LEADERBOARD_PATH, LB_TEMP_SUFIXO);
+
+    FILE* file = fopen(temp, "wb");
+    if (!file) {
+        printf("Erro: Nao foi possivel criar '%s'.\n", temp);
+        return false;
+    }
+
+    Uint8 buf[LB_REGISTRO];
+    montarCabecalho(buf, LB_VERSAO, LB_REGISTRO);
+    bool ok = fwrite(buf, 1, LB_CABECALHO, file) == LB_CABECALHO;
+
+    // Em ordem de ranking: na recarga cada empate entra abaixo do anterior, como agora
+    for (int i = 0; ok && i < data->songCount; ++i) {
+        const SongLeaderboard* lb = &data->songs[i];
+        for (int j = 0; ok && j < lb->scoreCount; ++j) {
+            montarRegistro(buf, lb, &lb->scores[j]);
+            ok = fwrite(buf, 1, LB_REGISTRO, file) == LB_REGISTRO;
+        }
+    }
+
+    if (!ok) {
+        fclose(file);
+        remove(temp);
+    }
+    if (!ok || !CommitTempFile(file, temp, LEADERBOARD_PATH)) {
+        printf("Erro: Falha ao gravar '%s'; o arquivo anterior foi mantido.\n", LEADERBOARD_PATH);
+        return false;
+    }
+    return true;
+}
+
+// Converte o despejo antigo da struct fixa. Retorna false se não havia um válido.
+static bool Leaderboard_MigrateLegacy(LeaderboardData* data) {
+    FILE* file = fopen(LEADERBOARD_LEGACY_PATH, "rb");
+    if (!file) return false;
+
+    LegadoDados* legado = (LegadoDados*)malloc(sizeof(LegadoDados));
+    bool ok = legado && fread(legado, sizeof(LegadoDados), 1, file) == 1;
+    fclose(file);
+
+    if (ok && (legado->songCount < 0 || legado->songCount > LB_LEGADO_MUSICAS)) ok = false;
+    for (int i = 0; ok && i < legado->songCount; ++i) {
+        LegadoMusica* m = &legado->songLeaderboards[i];
+        m->songName[SONG_NAME_MAX_LEN - 1] = '\0';
+        SongLeaderboard* lb = buscarOuCriarRegistro(data, 0, m->songName);
+        if (!lb) { ok = false; break; }
+        // O formato antigo já estava em ordem de ranking; os vazios tinham pontuação 0
+        for (int j = 0; j < LB_LEGADO_ENTRADAS; ++j) {
+            if (m->scores[j].score <= 0) continue;
+            m->scores[j].name[3] = '\0';
+            inserirEmMemoria(lb, m->scores[j].name, m->scores[j].score);
+        }
+    }
+    free(legado);
+
+    if (!ok) {
+        printf("Aviso: '%s' nao reconhecido; recordes antigos ignorados.\n", LEADERBOARD_LEGACY_PATH);
+        Leaderboard_Free(data);
+        return false;
+    }
+
+    if (Leaderboard_WriteAll(data))
+        printf("Recordes de '%s' migrados para '%s'.\n", LEADERBOARD_LEGACY_PATH, LEADERBOARD_PATH);
+    return true;
+}
+
+static void Leaderboard_Load(LeaderboardData* data) {
+    memset(data, 0, sizeof(*data));
+
+    FILE* file = fopen(LEADERBOARD_PATH, "rb");
+    if (!file) {
+        Leaderboard_MigrateLegacy(data);
+        return;
+    }
+
+    Uint8 buf[LB_REGISTRO];
+    Uint8 atual[LB_CABECALHO], v1[LB_CABECALHO];
+    montarCabecalho(atual, LB_VERSAO, LB_REGISTRO);
+    montarCabecalho(v1, 1, LB_REGISTRO_V1);
+
+    size_t tamanho = 0;
+    if (fread(buf, 1, LB_CABECALHO, file) == LB_CABECALHO) {
+        if (memcmp(buf, atual, LB_CABECALHO) == 0)  tamanho = LB_REGISTRO;
+        else if (memcmp(buf, v1, LB_CABECALHO) == 0) tamanho = LB_REGISTRO_V1;
+    }
+    if (tamanho == 0) {
+        // Versão desconhecida ou cabeçalho estragado: guarda o arquivo de lado em vez de acrescentar nele
+        fclose(file);
+        char ruim[256];
+        snprintf(ruim, sizeof(ruim), "%s%s", LEADERBOARD_PATH, LB_RUIM_SUFIXO);
+        ReplaceFileAtomic(LEADERBOARD_PATH, ruim);
+        printf("Aviso: '%s' invalido; movido para '%s'.\n", LEADERBOARD_PATH, ruim);
+        return;
+    }
+
+    int invalidos = 0;
+    size_t lidos;
+    while ((lidos = fread(buf, 1, tamanho, file)) == tamanho) {
+        if (GetU32LE(buf + tamanho - 4) != Fnv1a32(buf, tamanho - 4)) { invalidos++; continue; }
+
+        Uint64 chartId = 0;
+        Uint8* p = buf;
+        if (tamanho == LB_REGISTRO) {
+            chartId = GetU64LE(buf);
+            p += 8;
+        }
+        p[SONG_NAME_MAX_LEN - 1] = '\0';
+        char nome[4] = {0};
+        memcpy(nome, p + SONG_NAME_MAX_LEN, 3);
+        SongLeaderboard* lb = buscarOuCriarRegistro(data, chartId, (const char*)p);
+        if (lb) inserirEmMemoria(lb, nome, (int)GetU32LE(p + SONG_NAME_MAX_LEN + 4));
+    }
+    if (lidos > 0) invalidos++; // registro cortado no fim (gravação interrompida)
+    fclose(file);
+
+    // Tira os registros ruins do arquivo para os próximos acréscimos começarem alinhados;
+    // um arquivo da versão anterior é regravado na atual pelo mesmo caminho
+    if (invalidos > 0) printf("Aviso: %d registro(s) invalido(s) em '%s' descartados.\n", invalidos, LEADERBOARD_PATH);
+    if (invalidos > 0 || tamanho != LB_REGISTRO) Leaderboard_WriteAll(data);
+}
+
+LeaderboardData* Leaderboard_Get(void) {
+    if (!s_carregado) {
+        Leaderboard_Load(&s_dados);
+        s_carregado = true;
+    }
+    return &s_dados;
+}
+
+void Leaderboard_Shutdown(void) {
+    Leaderboard_Free(&s_dados);
+    s_carregado = false;
+}
+
+int Leaderboard_Insert(SongLeaderboard* lb, const char* name, int score) {
+    int rank = inserirEmMemoria(lb, name, score);
+    if (rank < 0) return -1;
+
+    FILE* file = fopen(LEADERBOARD_PATH, "ab");
+    if (!file) {
+        printf("Erro: Nao foi possivel gravar o recorde em '%s'.\n", LEADERBOARD_PATH);
+        return rank;
+    }
+
+    Uint8 buf[LB_REGISTRO];
+    fseek(file, 0, SEEK_END);
+    bool ok = true;
+    if (ftell(file) == 0) {
+        montarCabecalho(buf, LB_VERSAO, LB_REGISTRO);
+        ok = fwrite(buf, 1, LB_CABECALHO, file) == LB_CABECALHO;
+    }
+    montarRegistro(buf, lb, &lb->scores[rank]);
+    ok = ok && fwrite(buf, 1, LB_REGISTRO, file) == LB_REGISTRO;
+    ok = (fclose(file) == 0) && ok;
+
+    // Um registro pela metade desalinharia os próximos acréscimos: regrava tudo
+    // (o recorde novo já está na memória, em s_dados)
+    if (!ok && !Leaderboard_WriteAll(&s_dados))
+        printf("Erro: Nao foi possivel gravar o recorde em '%s'.\n", LEADERBOARD_PATH);
+    return rank;
+}
@@ -1,11 +1,19 @@
 #ifndef LEADERBOARD_H
 #define LEADERBOARD_H
 
-#define MAX_LEADERBOARD_ENTRIES 10
-#define MAX_SONGS_IN_LEADERBOARD 50
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include "auxFuncs/idIndex.h"
+
 #define SONG_NAME_MAX_LEN 64
+#define LEADERBOARD_VISIBLE_ENTRIES 10 // quantos aparecem no ranking (e dão direito a nome)
 
-#include <SDL2/SDL_ttf.h>
+// Arquivo de recordes: cabeçalho versionado seguido de registros de tamanho
+// fixo, cada um com sua soma de verificação. Salvar um recorde é acrescentar um
+// registro no fim; um registro cortado por queda de energia é descartado na
+// leitura e o arquivo é reescrito (temporário + rename) só com os válidos.
+#define LEADERBOARD_PATH        "leaderboards.sbl"
+#define LEADERBOARD_LEGACY_PATH "leaderboards.dat" // despejo antigo da struct, migrado na primeira carga
 
 // Estrutura para um único recorde (Nome, Pontuação)
 typedef struct {
@@ -13,19 +21,54 @@ typedef struct {
     int score;
 } HighScore;
 
-// Estrutura que agrupa os recordes de UMA música
+// Recordes de UMA música, em ordem decrescente de pontuação (sem limite de quantidade)
 typedef struct {
-    char songName[SONG_NAME_MAX_LEN];
-    HighScore scores[MAX_LEADERBOARD_ENTRIES];
+    Uint64 chartId;                    // hash do conteúdo do .samba (0 = recorde antigo, ainda sem id)
+    char songName[SONG_NAME_MAX_LEN];  // nome do arquivo sem extensão, só para exibição e migração
+    HighScore* scores;
+    int scoreCount;
+    int scoreCapacity;
 } SongLeaderboard;
 
-// Estrutura principal que será salva em arquivo
+// Todas as músicas que já tiveram recorde (sem limite de quantidade),
+// com um índice hash chartId -> música para a busca não depender do tamanho da biblioteca
 typedef struct {
+    SongLeaderboard* songs;
     int songCount;
-    SongLeaderboard songLeaderboards[MAX_SONGS_IN_LEADERBOARD];
+    int songCapacity;
+    IdIndex indice;       // chartId -> posição em 'songs'
+    int legados;          // músicas com chartId 0, adotadas pelo nome na inicialização (Leaderboard_Adopt)
 } LeaderboardData;
 
-void Leaderboard_Load(LeaderboardData* data);
-void Leaderboard_Save(const LeaderboardData* data);
+// Recordes carregados uma vez (na primeira chamada) e compartilhados por menu e jogo
+LeaderboardData* Leaderboard_Get(void);
+
+// Libera os recordes compartilhados (saída da aplicação)
+void Leaderboard_Shutdown(void);
+
+// Ranking do chart, ou NULL se ele nunca teve recorde. Só consulta a memória;
+// um recorde antigo (sem id) ainda não adotado é devolvido pelo 'songName'.
+SongLeaderboard* Leaderboard_Find(LeaderboardData* data, Uint64 chartId, const char* songName);
+
+// Migração: dá 'chartId' ao recorde antigo (sem id) de mesmo 'songName', só em
+// memória. Retorna true se adotou; quem chama grava uma vez no fim (Leaderboard_WriteAll).
+bool Leaderboard_Adopt(LeaderboardData* data, Uint64 chartId, const char* songName);
+
+// Reescreve o arquivo inteiro com o conteúdo em memória (temporário + rename)
+bool Leaderboard_WriteAll(const LeaderboardData* data);
+
+// Igual a Leaderboard_Find, mas cria um ranking vazio se preciso. Criar pode
+// realocar 'songs': ponteiros obtidos antes para outras músicas deixam de valer.
+SongLeaderboard* Leaderboard_FindOrCreate(LeaderboardData* data, Uint64 chartId, const char* songName);
+
+// Posição (0 = primeiro) que 'score' ocuparia; empates ficam abaixo dos antigos
+int Leaderboard_RankFor(const SongLeaderboard* lb, int score);
+
+// Entrada 'rank' ou "---"/0 se o ranking ainda não tem tantas
+HighScore Leaderboard_Entry(const SongLeaderboard* lb, int rank);
+
+// Insere o recorde em memória e acrescenta um registro no arquivo.
+// Retorna a posição em que entrou, ou -1 se não conseguiu alocar.
+int Leaderboard_Insert(SongLeaderboard* lb, const char* name, int score);
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,314 @@
+#include "library.h"
+#include "stage.h"
+#include "difficulty.h"
+#include "auxFuncs/utils.h"
+#include "auxFuncs/assetPack.h"
+#include "auxFuncs/idIndex.h"
+#include "auxFuncs/textIndex.h"
+#include <SDL2/SDL_mixer.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+// Cache (inteiros em little-endian):
+//   "SBBI" | versão u32 | músicas u32 |
+//   músicas x (chartId u64 | caminho do chart char[192] | tamanho do chart u64 |
+//              data do chart s64 | caminho do áudio char[192] | tamanho do áudio u64 |
+//              data do áudio s64 | duração em ms u32 | notas u32 | flags u32 |
+//              dificuldade em centésimos u32 |
+//              ondaMax u8[C] | ondaMin u8[C] | densidade u8[C]) |
+//   FNV-1a u32 de tudo antes
+#define LIB_MAGIA        "SBBI"
+#define LIB_VERSAO       3  // v2 não guardava o chart (id recalculado a cada início): tudo é indexado de novo
+#define LIB_CABECALHO    12
+#define LIB_CAMINHO      192
+#define LIB_ARQUIVO      (LIB_CAMINHO + 8 + 8) // caminho, tamanho e data
+#define LIB_ENTRADA      (8 + 2 * LIB_ARQUIVO + 4 + 4 + 4 + 4 + 3 * LIBRARY_COLUNAS)
+#define LIB_FLAG_ONDA    1u
+
+// Catálogo: o nome-base do .samba em assets/beatMaps, o nome de exibição e o artista
+static const char* s_catalogo[][3] = {
+    {"meu_lugar", "Meu Lugar", "Arlindo Cruz"},
+    {"do_fundo_do_nosso_quintal", "Do Fundo do Nosso Quintal", "Jorge Aragao"}
+};
+
+static LibrarySong* s_musicas = NULL;
+static int          s_total = 0;
+static TextIndex    s_busca;
+
+// O que identifica a versão de um arquivo (chart ou áudio) que gerou a entrada
+typedef struct {
+    Uint64 tamanho;
+    Sint64 data;
+} Assinatura;
+
+static Assinatura assinaturaDe(const char* caminho) {
+    Assinatura a = {0, 0};
+    struct stat st;
+    if (caminho[0] && stat(caminho, &st) == 0) {
+        a.tamanho = (Uint64)st.st_size;
+        a.data    = (Sint64)st.st_mtime;
+    }
+    return a;
+}
+
+// caminho | tamanho | data, como no cache
+static void gravarArquivo(Uint8* p, const char* caminho) {
+    Assinatura a = assinaturaDe(caminho);
+    snprintf((char*)p, LIB_CAMINHO, "%s", caminho);
+    PutU64LE(p + LIB_CAMINHO,     a.tamanho);
+    PutU64LE(p + LIB_CAMINHO + 8, (Uint64)a.data);
+}
+
+// O arquivo gravado em 'p' ainda é o mesmo do disco? Copia o caminho em 'caminho'.
+static bool arquivoIgual(const Uint8* p, char* caminho) {
+    memcpy(caminho, p, LIB_CAMINHO);
+    caminho[LIB_CAMINHO - 1] = '\0';
+    Assinatura a = assinaturaDe(caminho);
+    return a.tamanho == GetU64LE(p + LIB_CAMINHO) && a.data == (Sint64)GetU64LE(p + LIB_CAMINHO + 8);
+}
+
+/* =========================
+   Indexação
+   ========================= */
+
+// Pico positivo e negativo de cada coluna numa passada só pelo áudio
+// decodificado, que é liberado logo em seguida. Retorna a duração do áudio
+// em ms, ou 0 se ele não pôde ser decodificado.
+static Uint32 extrairOnda(LibrarySong* m) {
+    int frequencia = 0, canais = 0;
+    Uint16 formato = 0;
+    if (!Mix_QuerySpec(&frequencia, &formato, &canais) || formato != AUDIO_S16SYS || canais < 1) return 0;
+
+    Mix_Chunk* chunk = Asset_LoadWAV(m->musica);
+    if (!chunk) {
+        printf("Aviso: nao foi possivel decodificar '%s' para a miniatura: %s\n", m->musica, Mix_GetError());
+        return 0;
+    }
+
+    const Sint16* pcm = (const Sint16*)chunk->abuf;
+    const Uint64 quadros = chunk->alen / (sizeof(Sint16) * (Uint32)canais);
+    Uint64 q = 0;
+    for (int c = 0; c < LIBRARY_COLUNAS && quadros > 0; ++c) {
+        const Uint64 fim = quadros * (Uint64)(c + 1) / LIBRARY_COLUNAS;
+        int menor = 0, maior = 0;
+        for (; q < fim; ++q) {
+            int soma = 0;
+            for (int k = 0; k < canais; ++k) soma += pcm[q * (Uint64)canais + k];
+            int v = soma / canais;
+            if (v > maior) maior = v;
+            if (v < menor) menor = v;
+        }
+        m->ondaMax[c] = (Uint8)(maior * 255 / 32767);
+        m->ondaMin[c] = (Uint8)(-menor * 255 / 32768);
+    }
+    Mix_FreeChunk(chunk);
+
+    m->temOnda = quadros > 0;
+    return (Uint32)(quadros * 1000 / (Uint64)frequencia);
+}
+
+// Lê o chart (sem recursos) e o áudio e preenche os dados da miniatura
+static bool indexar(LibrarySong* m) {
+    Fase* fase = Fase_CarregarChart(m->caminho);
+    if (!fase) return false;
+
+    printf("Indexando '%s'...\n", m->caminho);
+    m->chartId = fase->chartId; // somado na leitura do chart
+    snprintf(m->musica, sizeof(m->musica), "%s", fase->caminhoMusica);
+    m->totalNotas = fase->totalNotas;
+    m->dificuldade = Difficulty_Rate(fase->beatmap, fase->totalNotas); // notas já em ordem de hitTime
+    m->temOnda = false;
+    memset(m->ondaMax, 0, sizeof(m->ondaMax));
+    memset(m->ondaMin, 0, sizeof(m->ondaMin));
+    memset(m->densidade, 0, sizeof(m->densidade));
+
+    // Duração: a do áudio (a onda e a densidade ficam na mesma escala), senão a do cabeçalho
+    Uint32 duracao = extrairOnda(m);
+    if (duracao == 0) duracao = fase->durationMs;
+    for (int i = 0; duracao == 0 && i < fase->totalNotas; ++i) {
+        Uint32 fim = fase->beatmap[i].hitTime + fase->beatmap[i].duration;
+        if (fim + 1 > duracao) duracao = fim + 1;
+    }
+    m->duracaoMs = duracao;
+
+    int contagem[LIBRARY_COLUNAS] = {0};
+    int maiorContagem = 0;
+    for (int i = 0; duracao > 0 && i < fase->totalNotas; ++i) {
+        Uint64 c = (Uint64)fase->beatmap[i].hitTime * LIBRARY_COLUNAS / duracao;
+        if (c >= LIBRARY_COLUNAS) c = LIBRARY_COLUNAS - 1;
+        if (++contagem[c] > maiorContagem) maiorContagem = contagem[c];
+    }
+    for (int c = 0; c < LIBRARY_COLUNAS && maiorContagem > 0; ++c) {
+        m->densidade[c] = (Uint8)(contagem[c] * 255 / maiorContagem);
+    }
+
+    Fase_Liberar(fase);
+    return true;
+}
+
+/* =========================
+   Cache
+   ========================= */
+
+// Lê o cache inteiro. Retorna o buffer (entradas a partir de LIB_CABECALHO) ou NULL se não serve.
+static Uint8* Library_LoadCache(Uint32* total) {
+    FILE* file = fopen(LIBRARY_INDEX_PATH, "rb");
+    if (!file) return NULL;
+
+    Uint8 cab[LIB_CABECALHO];
+    bool ok = fread(cab, 1, LIB_CABECALHO, file) == LIB_CABECALHO &&
+              memcmp(cab, LIB_MAGIA, 4) == 0 && GetU32LE(cab + 4) == LIB_VERSAO &&
+              GetU32LE(cab + 8) <= LIBRARY_MAX_MUSICAS * 4;
+    *total = ok ? GetU32LE(cab + 8) : 0;
+    size_t tamanho = LIB_CABECALHO + (size_t)*total * LIB_ENTRADA + 4;
+    Uint8* buf = ok ? (Uint8*)malloc(tamanho) : NULL;
+    if (buf) {
+        memcpy(buf, cab, LIB_CABECALHO);
+        ok = fread(buf + LIB_CABECALHO, 1, tamanho - LIB_CABECALHO, file) == tamanho - LIB_CABECALHO &&
+             GetU32LE(buf + tamanho - 4) == Fnv1a32(buf, tamanho - 4);
+    }
+    fclose(file);
+
+    if (!ok) {
+        free(buf);
+        printf("Aviso: '%s' invalido; a biblioteca sera indexada de novo.\n", LIBRARY_INDEX_PATH);
+        return NULL;
+    }
+    return buf;
+}
+
+// Chave de uma entrada do cache: o caminho do chart
+static Uint64 chaveDe(const char* caminho) {
+    return Fnv1a64(caminho, strlen(caminho));
+}
+
+// Procura o chart no cache (índice caminho -> entrada). Só vale se o chart e o
+// áudio ainda têm o tamanho e a data gravados; aí o chartId vem do cache e o
+// chart nem é aberto.
+static bool Library_FromCache(const Uint8* buf, const IdIndex* entradas, LibrarySong* m) {
+    int i = IdIndex_Get(entradas, chaveDe(m->caminho));
+    if (i < 0) return false;
+
+    const Uint8* p = buf + LIB_CABECALHO + (size_t)i * LIB_ENTRADA;
+    char chart[LIB_CAMINHO], musica[LIB_CAMINHO];
+    if (!arquivoIgual(p + 8, chart) || strcmp(chart, m->caminho) != 0) return false;
+    if (!arquivoIgual(p + 8 + LIB_ARQUIVO, musica)) return false;
+    const Uint8* q = p + 8 + 2 * LIB_ARQUIVO;
+
+    m->chartId    = GetU64LE(p);
+    snprintf(m->musica, sizeof(m->musica), "%s", musica);
+    m->duracaoMs  = GetU32LE(q);
+    m->totalNotas = (int)GetU32LE(q + 4);
+    m->temOnda    = (GetU32LE(q + 8) & LIB_FLAG_ONDA) != 0;
+    m->dificuldade = GetU32LE(q + 12) / 100.0f;
+    q += 16;
+    memcpy(m->ondaMax,   q,                      LIBRARY_COLUNAS);
+    memcpy(m->ondaMin,   q + LIBRARY_COLUNAS,     LIBRARY_COLUNAS);
+    memcpy(m->densidade, q + 2 * LIBRARY_COLUNAS, LIBRARY_COLUNAS);
+    return true;
+}
+
+static void Library_SaveCache(void) {
+    size_t tamanho = LIB_CABECALHO + (size_t)s_total * LIB_ENTRADA + 4;
+    Uint8* buf = (Uint8*)calloc(1, tamanho);
+    if (!buf) return;
+
+    memcpy(buf, LIB_MAGIA, 4);
+    PutU32LE(buf + 4, LIB_VERSAO);
+    PutU32LE(buf + 8, (Uint32)s_total);
+    Uint8* p = buf + LIB_CABECALHO;
+    for (int i = 0; i < s_total; ++i, p += LIB_ENTRADA) {
+        const LibrarySong* m = &s_musicas[i];
+        PutU64LE(p, m->chartId);
+        gravarArquivo(p + 8, m->caminho);
+        gravarArquivo(p + 8 + LIB_ARQUIVO, m->musica);
+        Uint8* q = p + 8 + 2 * LIB_ARQUIVO;
+        PutU32LE(q,      m->duracaoMs);
+        PutU32LE(q + 4,  (Uint32)m->totalNotas);
+        PutU32LE(q + 8,  m->temOnda ? LIB_FLAG_ONDA : 0);
+        PutU32LE(q + 12, (Uint32)(m->dificuldade * 100.0f + 0.5f));
+        q += 16;
+        memcpy(q,                       m->ondaMax,   LIBRARY_COLUNAS);
+        memcpy(q + LIBRARY_COLUNAS,     m->ondaMin,   LIBRARY_COLUNAS);
+        memcpy(q + 2 * LIBRARY_COLUNAS, m->densidade, LIBRARY_COLUNAS);
+    }
+    PutU32LE(p, Fnv1a32(buf, tamanho - 4));
+
+    char temp[256];
+    snprintf(temp, sizeof(temp), "%s.tmp", LIBRARY_INDEX_PATH);
+    FILE* file = fopen(temp, "wb");
+    bool ok = file && fwrite(buf, 1, tamanho, file) == tamanho;
+    if (file && !ok) { fclose(file); remove(temp); }
+    if (!ok || !CommitTempFile(file, temp, LIBRARY_INDEX_PATH))
+        printf("Aviso: Nao foi possivel gravar '%s' (sera refeito na proxima vez).\n", LIBRARY_INDEX_PATH);
+    free(buf);
+}
+
+/* =========================
+   API
+   ========================= */
+void Library_Init(void) {
+    Uint32 totalCache = 0;
+    Uint8* cache = Library_LoadCache(&totalCache);
+    bool mudou = (cache == NULL);
+
+    // Entradas do cache pelo caminho do chart: achar cada música é O(1) em vez de varrer o arquivo
+    IdIndex entradas = {0};
+    char caminho[LIB_CAMINHO];
+    for (Uint32 i = 0; cache && i < totalCache; ++i) {
+        memcpy(caminho, cache + LIB_CABECALHO + (size_t)i * LIB_ENTRADA + 8, LIB_CAMINHO);
+        caminho[LIB_CAMINHO - 1] = '\0';
+        IdIndex_Put(&entradas, chaveDe(caminho), (int)i);
+    }
+
+    s_total = 0;
+    int catalogo = (int)(sizeof(s_catalogo) / sizeof(s_catalogo[0]));
+    if (catalogo > LIBRARY_MAX_MUSICAS) catalogo = LIBRARY_MAX_MUSICAS;
+    s_musicas = (LibrarySong*)malloc((size_t)(catalogo > 0 ? catalogo : 1) * sizeof(LibrarySong));
+    for (int i = 0; s_musicas && i < catalogo; ++i) {
+        LibrarySong* m = &s_musicas[s_total];
+        memset(m, 0, sizeof(*m));
+        snprintf(m->id, sizeof(m->id), "%s", s_catalogo[i][0]);
+        snprintf(m->nome, sizeof(m->nome), "%s", s_catalogo[i][1]);
+        snprintf(m->artista, sizeof(m->artista), "%s", s_catalogo[i][2]);
+        snprintf(m->caminho, sizeof(m->caminho), "assets/beatMaps/%s.samba", s_catalogo[i][0]);
+        if (!(cache && Library_FromCache(cache, &entradas, m))) {
+            mudou = true;
+            if (!indexar(m)) printf("Aviso: '%s' nao pode ser indexado.\n", m->caminho);
+        }
+        s_total++;
+    }
+    IdIndex_Free(&entradas);
+    free(cache);
+
+    if (mudou || (Uint32)s_total != totalCache) Library_SaveCache();
+
+    // Índice de busca: id no índice = posição no catálogo
+    char texto[sizeof(s_musicas[0].nome) + sizeof(s_musicas[0].artista) + 2];
+    for (int i = 0; i < s_total; ++i) {
+        snprintf(texto, sizeof(texto), "%s %s", s_musicas[i].nome, s_musicas[i].artista);
+        if (!TextIndex_Add(&s_busca, texto)) break;
+    }
+    if (!TextIndex_Finish(&s_busca)) printf("Aviso: sem memoria para o indice de busca.\n");
+}
+
+void Library_Shutdown(void) {
+    TextIndex_Free(&s_busca);
+    free(s_musicas);
+    s_musicas = NULL;
+    s_total = 0;
+}
+
+int Library_Count(void) {
+    return s_total;
+}
+
+const LibrarySong* Library_Get(int indice) {
+    return (indice >= 0 && indice < s_total) ? &s_musicas[indice] : NULL;
+}
+
+int Library_Search(const char* consulta, const int* candidatos, int totalCandidatos, int* saida) {
+    return TextIndex_Search(&s_busca, consulta, candidatos, totalCandidatos, saida);
+}
@@ -0,0 +1,49 @@
+#ifndef LIBRARY_H
+#define LIBRARY_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+// Biblioteca de músicas: o catálogo de charts e, para cada um, o que a tela
+// de seleção mostra sem abrir nada durante o menu (duração, total de notas,
+// dificuldade, miniatura da forma de onda e da densidade de notas).
+//  - biblioteca.idx: cache desses dados e do chartId por chart, com o tamanho
+//    e a data do chart e do áudio. Chart editado ou áudio trocado = indexar de
+//    novo; o resto sai direto do arquivo, sem abrir o chart.
+//  - Busca por nome e artista num índice de trigramas (textIndex.h), montado
+//    junto com o catálogo.
+#define LIBRARY_INDEX_PATH  "biblioteca.idx"
+#define LIBRARY_MAX_MUSICAS 8192
+#define LIBRARY_COLUNAS     96  // resolução das miniaturas (colunas na música toda)
+
+typedef struct {
+    char   caminho[256];    // .samba
+    char   id[64];          // nome-base do arquivo (chave antiga dos recordes)
+    char   nome[128];       // para exibir
+    char   artista[96];
+    char   musica[192];     // MUSICA: do cabeçalho
+    Uint64 chartId;
+    Uint32 duracaoMs;
+    int    totalNotas;
+    float  dificuldade;     // Difficulty_Rate das notas
+    bool   temOnda;         // false se o áudio não pôde ser decodificado
+    Uint8  ondaMax[LIBRARY_COLUNAS];   // pico positivo de cada coluna, 0-255
+    Uint8  ondaMin[LIBRARY_COLUNAS];   // pico negativo, em módulo
+    Uint8  densidade[LIBRARY_COLUNAS]; // notas na coluna, relativo à mais cheia (255)
+} LibrarySong;
+
+// Monta o catálogo, lê o cache e indexa o que faltar (decodifica o áudio).
+// Chamar uma vez, depois de App_Init (a decodificação usa o formato do mixer).
+void Library_Init(void);
+void Library_Shutdown(void);
+
+int                Library_Count(void);
+const LibrarySong* Library_Get(int indice);
+
+// Índices (em ordem crescente) das músicas cujo nome ou artista bate com
+// 'consulta', em 'saida' (espaço para Library_Count). 'candidatos' restringe a
+// busca, ex.: ao resultado anterior quando a consulta só ganhou letras no fim.
+// Ver TextIndex_Search.
+int Library_Search(const char* consulta, const int* candidatos, int totalCandidatos, int* saida);
+
+#endif // LIBRARY_H
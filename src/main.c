@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include <stdbool.h>
+#include <string.h>
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_image.h>
 #include <SDL2/SDL_mixer.h>
@@ -9,10 +10,45 @@
 #include "auxFuncs/auxWaitEvent.h"
 #include "app.h"
 #include "menu.h" 
+#include "auxFuncs/profiler.h"
+#include "auxFuncs/trace.h"
+#include "auxFuncs/allocCounter.h"
+#include "auxFuncs/quality.h"
+#include "auxFuncs/video.h"
+#include "auxFuncs/spectrum.h"
+#include "auxFuncs/assetPack.h"
+#include "auxFuncs/texCache.h"
+#include "auxFuncs/pacing.h"
+#include "config.h"
+#include "leaderboard.h"
+#include "history.h"
+#include "library.h"
 
 // --- Definição das Variáveis Globais de Resolução ---
-int SCREEN_WIDTH = 1280;  // Valor padrão inicial
-int SCREEN_HEIGHT = 720;  // Valor padrão inicial
+int SCREEN_WIDTH = LOGICAL_WIDTH;   // Fixos: o SDL amplia para o monitor
+int SCREEN_HEIGHT = LOGICAL_HEIGHT;
+
+// Chamado pelo SDL_mixer na thread de áudio depois de cada mixagem.
+static void App_PostMix(void* udata, Uint8* stream, int len) {
+    (void)udata;
+    // Registrado antes do Trace_Open: só marca o nome como dado quando o trace já grava
+    static bool threadNomeada = false;
+    if (!threadNomeada && Trace_IsActive()) { Trace_NameThread("audio"); threadNomeada = true; }
+    Trace_AudioCallback(len);
+    Spectrum_Feed(stream, len);
+}
+
+// Recordes gravados antes do chartId ganham o id do chart de mesmo nome na
+// biblioteca; o arquivo é regravado uma vez aqui, nunca durante uma busca.
+static void App_AdotarRecordesAntigos(void) {
+    LeaderboardData* recordes = Leaderboard_Get();
+    bool adotou = false;
+    for (int i = 0; i < Library_Count() && recordes->legados > 0; ++i) {
+        const LibrarySong* musica = Library_Get(i);
+        if (Leaderboard_Adopt(recordes, musica->chartId, musica->id)) adotou = true;
+    }
+    if (adotou) Leaderboard_WriteAll(recordes);
+}
 
 // Inicializa todos os subsistemas da SDL de uma só vez.
 // Retorna 'true' em caso de sucesso, 'false' em caso de falha.
@@ -37,7 +73,14 @@ bool App_Init() {
         printf("ERRO: SDL_ttf nao pode inicializar! TTF_Error: %s\n", TTF_GetError());
         return false;
     }
+
+    // O analisador precisa do formato que o dispositivo realmente aceitou
+    int frequencia = 0, canais = 0;
+    Uint16 formato = 0;
+    if (Mix_QuerySpec(&frequencia, &formato, &canais)) Spectrum_Init(frequencia, formato, canais);
+    Mix_SetPostMix(App_PostMix, NULL);
     
+    Prof_Init();
     printf("Subsistemas inicializados com sucesso!\n");
     return true;
 }
@@ -45,6 +88,9 @@ bool App_Init() {
 // Encerra todos os subsistemas da SDL.
 void App_Shutdown() {
     printf("Encerrando subsistemas da SDL...\n");
+    Mix_SetPostMix(NULL, NULL);
+    Spectrum_Shutdown();
+    Trace_Close();
     TTF_Quit();
     Mix_Quit();
     IMG_Quit();
@@ -56,26 +102,63 @@ void App_Shutdown() {
 
 int main(int argc, char* argv[]) {
 
+    // --- Argumentos de linha de comando ---
+    //   --autoplay            o bot toca todas as partidas com precisão perfeita
+    //   --autoplay=humano     o bot toca com pequenos desvios de tempo
+    //   --fase <arquivo>      pula o menu e abre direto o .samba indicado
+    //   --trace <saida.json>  grava zonas, quadros, entrada e áudio (Chrome Trace / Perfetto)
+    //   --charting            recarrega o .samba ao salvar, sem parar a música nem dar fim de jogo
+    const char* startSongPath = NULL;
+    const char* tracePath = NULL;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--autoplay") == 0) {
+            Game_SetAutoplay(AUTOPLAY_PERFEITO);
+        } else if (strcmp(argv[i], "--autoplay=humano") == 0) {
+            Game_SetAutoplay(AUTOPLAY_HUMANO);
+        } else if (strcmp(argv[i], "--charting") == 0) {
+            Game_SetCharting(true);
+        } else if (strcmp(argv[i], "--fase") == 0 && i + 1 < argc) {
+            startSongPath = argv[++i];
+        } else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            tracePath = argv[++i];
+        } else {
+            printf("Aviso: argumento desconhecido ignorado: %s\n", argv[i]);
+        }
+    }
+
+    AllocCounter_Install(); // só faz algo em builds com DEBUG=1
+    Config_Load(CONFIG_PATH);
+    AssetPack_Open(ASSETPACK_PATH); // sem pacote (make pack), os assets vêm dos arquivos soltos
+    Pacing_Init(); // SINCRONIA decide se o renderer usa vsync
+
     // Inicializa todas as bibliotecas de uma vez.
     if (!App_Init()) {
         return -1;
     }
 
-    // --- LÓGICA DE RESOLUÇÃO DINÂMICA ---
+    History_Init();
+    Library_Init();
+    App_AdotarRecordesAntigos();
+
+    if (tracePath && Trace_Open(tracePath)) {
+        Trace_NameThread("principal");
+    }
+
+    // A janela ocupa o monitor inteiro; o jogo desenha na resolução lógica
+    // (SCREEN_WIDTH x SCREEN_HEIGHT) e o renderer amplia com letterbox.
     SDL_DisplayMode dm;
+    int janelaW = SCREEN_WIDTH, janelaH = SCREEN_HEIGHT;
     if (SDL_GetCurrentDisplayMode(0, &dm) != 0) {
-        printf("Aviso: Falha ao obter resolucao do monitor (%s). Usando padrao 1280x720.\n", SDL_GetError());
+        printf("Aviso: Falha ao obter resolucao do monitor (%s).\n", SDL_GetError());
     } else {
-        // Define a resolução do jogo para ser 80% ou 90% da tela do usuário (para modo janela)
-        SCREEN_WIDTH = dm.w;
-        SCREEN_HEIGHT = dm.h;
+        janelaW = dm.w;
+        janelaH = dm.h;
     }
 
-    // Cria a janela (flag RESIZABLE para permitir redimensionar, ou FULLSCREEN_DESKTOP)
     SDL_Window* window = SDL_CreateWindow("Samba Raiz", 
                                           SDL_WINDOWPOS_CENTERED, 
                                           SDL_WINDOWPOS_CENTERED, 
-                                          SCREEN_WIDTH, SCREEN_HEIGHT, 
+                                          janelaW, janelaH, 
                                           SDL_WINDOW_SHOWN | SDL_WINDOW_FULLSCREEN_DESKTOP); // Usando Fullscreen Desktop para preencher a tela
     
     if (!window) {
@@ -84,22 +167,37 @@ int main(int argc, char* argv[]) {
         return -1;
     }
 
-    // Atualiza as variáveis globais com o tamanho real da janela criada (caso o sistema mude)
-    SDL_GetWindowSize(window, &SCREEN_WIDTH, &SCREEN_HEIGHT);
-
-    SDL_Renderer* renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+    Uint32 flagsRenderer = SDL_RENDERER_ACCELERATED | (Pacing_UsesVsync() ? SDL_RENDERER_PRESENTVSYNC : 0);
+    SDL_Renderer* renderer = SDL_CreateRenderer(window, -1, flagsRenderer);
     if (!renderer) {
         printf("ERRO: Renderizador nao pode ser criado! SDL_Error: %s\n", SDL_GetError());
         SDL_DestroyWindow(window);
         App_Shutdown();
         return -1;
     }
+    if (!Video_Init(renderer)) {
+        SDL_DestroyRenderer(renderer);
+        SDL_DestroyWindow(window);
+        App_Shutdown();
+        return -1;
+    }
+    Prof_InitOverlay(renderer);
+    TexCache_Init(renderer);
+
+    // O governador de qualidade e o ritmo jit miram a taxa do monitor (60 Hz se desconhecida)
+    int refresh = (SDL_GetWindowDisplayMode(window, &dm) == 0 && dm.refresh_rate > 0) ? dm.refresh_rate : 60;
+    Quality_Init(1000.0f / (float)refresh);
+    Pacing_SetRefresh(1000.0f / (float)refresh);
 
     // Inicia o loop principal do jogo, que lida com o reinício.
     // Loop principal da APLICAÇÃO
 
     ApplicationState currentState = APP_STATE_MENU;
     char selectedSongPath[256] = {0}; // Para guardar a música que o menu escolheu
+    if (startSongPath) {
+        snprintf(selectedSongPath, sizeof(selectedSongPath), "%s", startSongPath);
+        currentState = APP_STATE_GAMEPLAY;
+    }
 
     while (currentState != APP_STATE_EXIT) {
         if (currentState == APP_STATE_MENU) {
@@ -113,9 +211,15 @@ int main(int argc, char* argv[]) {
     }
 
     // Encerramento final de tudo.
+    Leaderboard_Shutdown();
+    History_Shutdown();
+    Library_Shutdown();
+    Prof_Shutdown(); // texturas do overlay precisam do renderer vivo
+    Video_Shutdown();
     SDL_DestroyRenderer(renderer);
     SDL_DestroyWindow(window);
     App_Shutdown();
+    AssetPack_Close(); // por último: fontes e músicas liam do mapeamento
 
     return 0;
 }
\ No newline at end of file
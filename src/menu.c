@@ -2,25 +2,70 @@
 #include "menu.h"
 #include "defs.h"
 #include "leaderboard.h"
+#include "stage.h"
+#include "history.h"
+#include "library.h"
+#include "difficulty.h"
 #include "game.h"
+#include "playlist.h"
 #include "auxFuncs/utils.h"
 #include "auxFuncs/auxWaitEvent.h"
+#include "auxFuncs/profiler.h"
+#include "auxFuncs/trace.h"
+#include "auxFuncs/video.h"
+#include "auxFuncs/assetPack.h"
+#include "auxFuncs/texCache.h"
+#include "auxFuncs/pacing.h"
 #include <dirent.h> 
+#include <stdlib.h>
 #include <SDL2/SDL_image.h> 
 #include <SDL2/SDL_ttf.h>
 #include <SDL2/SDL_mixer.h>
 
+// Tempo parado no menu principal até o attract (demo automática) começar
+#define MENU_ATTRACT_IDLE_MS 20000
+
+// Lista de seleção virtualizada: só as linhas à vista são montadas e
+// desenhadas, então o custo do quadro não cresce com a biblioteca.
+#define LISTA_Y       280   // centro da primeira linha à vista
+#define LISTA_LINHA_H 60
+#define LISTA_LINHAS  10    // linhas à vista
+#define LISTA_ROLAGEM 3     // linhas por passo da roda do mouse
+
+// Miniatura de cada linha da seleção: forma de onda em cima, densidade de
+// notas embaixo. Uma faixa por linha à vista numa textura só, preenchida
+// quando a música aparece (com folga, para voltar a rolagem não refazer).
+#define MINIATURA_ONDA_H      32
+#define MINIATURA_DENSIDADE_H 16
+#define MINIATURA_H           (MINIATURA_ONDA_H + MINIATURA_DENSIDADE_H)
+#define MINIATURA_ESCALA_X    4      // cada coluna vira 4 px na tela
+#define MINIATURA_X           980
+#define MINIATURA_FAIXAS      (2 * LISTA_LINHAS)
+
+// Busca por nome/artista (Library_Search): '/' abre a caixa, o texto refiltra a cada tecla
+#define BUSCA_MAX 48
+
 // Estados internos do menu
 typedef enum {
     MENU_SCREEN_MAIN,
     MENU_SCREEN_SONG_SELECT
 } MenuScreen;
 
+// Ordem da lista de seleção
+typedef enum {
+    ORDEM_CATALOGO,
+    ORDEM_MAIS_FACEIS,
+    ORDEM_MAIS_DIFICEIS,
+    ORDEM_NUM
+} MenuOrdem;
+
 // Estrutura para guardar informações de uma música encontrada
 typedef struct {
     char fileName[256];
     char displayName[128];
     HighScore topScore;
+    Uint64 chartId;
+    float dificuldade; // da biblioteca: ordenar e filtrar não relê nenhum chart
 } SongInfo;
 
 // Variáveis estáticas do menu
@@ -30,32 +75,82 @@ static TTF_Font* s_fontSmall = NULL;   //fonte menor p/ instruções
 static MenuScreen s_currentScreen = MENU_SCREEN_MAIN;
 static int s_selectedButton = 0;
 
-static SongInfo s_songList[50]; // Suporta até 50 músicas
+static SongInfo* s_songList = NULL; // Library_Count entradas
 static int s_songCount = 0;
+static SDL_Texture* s_thumbAtlas = NULL;
+static int    s_thumbMusica[MINIATURA_FAIXAS]; // música em cada faixa (-1 = vazia)
+static Uint32 s_thumbUso[MINIATURA_FAIXAS];    // último quadro que usou a faixa
+static Uint32 s_quadroMenu = 0;
+
+// Lista exibida: índices em s_songList depois da busca, do filtro e da ordem.
+// Na seleção de músicas, s_selectedButton é uma posição nesta lista e s_topo
+// a primeira posição à vista.
+static int*      s_visiveis = NULL;
+static int       s_totalVisiveis = 0;
+static int       s_topo = 0;
+static MenuOrdem s_ordem  = ORDEM_CATALOGO;
+static int       s_filtro = -1; // -1 = todas, senão uma DificuldadeFaixa
+
+// Busca: o texto digitado e as músicas que batem com ele, em ordem de catálogo
+static char s_busca[BUSCA_MAX] = "";
+static bool s_digitando = false;
+static int* s_resultados = NULL;
+static int  s_totalResultados = 0;
 
 //Hitboxes dos botões do menu
 static SDL_Rect s_btnRects[4];
 
+// Attract: última interação do jogador e próxima música da demo
+static Uint32 s_lastInteraction = 0;
+static int    s_attractIndex    = 0;
+
 // Preview de música (estado)
 static Mix_Music* s_previewMusic = NULL;
 static int        s_previewPlayingIndex = -1;
 
+// Posição do mouse no evento, já em coordenadas lógicas (o SDL converte
+// os eventos; SDL_GetMouseState devolveria pixels da janela)
+static void EventMousePos(const SDL_Event* e, int* mx, int* my) {
+    if (e->type == SDL_MOUSEMOTION) { *mx = e->motion.x; *my = e->motion.y; }
+    else                            { *mx = e->button.x; *my = e->button.y; }
+}
+
 // Verifica se um ponto (mx, my) está dentro de um retângulo r
 static bool ptInRect(int mx, int my, SDL_Rect r) {
     return (mx >= r.x && mx < r.x + r.w && my >= r.y && my < r.y + r.h);
 }
 
-//Retângulo clicável na tela de seleção de musicas
-static SDL_Rect GetSongRowRect(int index) {
-    const int listStartY = 250;      
-    const int listLineH  = 60;       
+//Retângulo clicável na tela de seleção de musicas ('linha' = posição à vista, 0 no topo)
+static SDL_Rect GetSongRowRect(int linha) {
     const int left       = 80;       
     const int right      = SCREEN_WIDTH - 80; 
 
-    SDL_Rect r = { left, listStartY + index*listLineH - 28, right - left, 56 };
+    SDL_Rect r = { left, LISTA_Y + linha*LISTA_LINHA_H - 28, right - left, 56 };
     return r;
 }
 
+// Linha da lista exibida sob o ponto, ou -1. Conta direta: não percorre a lista.
+static int SongRowAt(int mx, int my) {
+    int linha = (my - (LISTA_Y - 28)) / LISTA_LINHA_H;
+    if (my < LISTA_Y - 28 || linha >= LISTA_LINHAS || s_topo + linha >= s_totalVisiveis) return -1;
+    return ptInRect(mx, my, GetSongRowRect(linha)) ? s_topo + linha : -1;
+}
+
+// Rolagem: mantém s_topo dentro da lista
+static void Menu_ScrollTo(int topo) {
+    int maximo = s_totalVisiveis - LISTA_LINHAS;
+    if (topo > maximo) topo = maximo;
+    if (topo < 0) topo = 0;
+    s_topo = topo;
+}
+
+// Rola o mínimo para a música selecionada ficar à vista
+static void Menu_RevealSelection(void) {
+    if (s_selectedButton < s_topo) Menu_ScrollTo(s_selectedButton);
+    else if (s_selectedButton >= s_topo + LISTA_LINHAS) Menu_ScrollTo(s_selectedButton - LISTA_LINHAS + 1);
+    else Menu_ScrollTo(s_topo);
+}
+
 //Controle do preview
 static void Menu_StopPreview(void) {
     if (Mix_PlayingMusic()) Mix_HaltMusic();
@@ -64,17 +159,9 @@ static void Menu_StopPreview(void) {
 }
 static void Menu_PlayPreview(int idx) {
     if (idx < 0 || idx >= s_songCount) return;
-    // Toca o .mp3 correspondente ao .samba (mesmo ID)
-    // Mapeamento simples: troca a extensão e a pasta
-    // Ex.: assets/beatMaps/meu_lugar.samba -> assets/music/MeuLugar_ArlindoCruz.mp3 (ajuste abaixo se quiser nomes exatos)
-    // Aqui vamos construir um caminho padrão "assets/music/<id>.mp3" se existir.
-    const char* mp3Path = NULL;
-    if (strstr(s_songList[idx].fileName, "meu_lugar")) {
-        mp3Path = "assets/music/MeuLugar_ArlindoCruz.mp3";
-    } else if (strstr(s_songList[idx].fileName, "do_fundo_do_nosso_quintal")) {
-        mp3Path = "assets/music/DoFundoDoNossoQuintal_JorgeAragao.mp3";
-    }
-
+    // Toca a MUSICA: do chart, que a biblioteca já guardou
+    const LibrarySong* musica = Library_Get(idx);
+    const char* mp3Path = (musica && musica->musica[0]) ? musica->musica : NULL;
     if (!mp3Path) return;
 
     // Se já está tocando essa mesma, pausar
@@ -84,65 +171,157 @@ static void Menu_PlayPreview(int idx) {
     }
 
     Menu_StopPreview();
-    s_previewMusic = Mix_LoadMUS(mp3Path);
+    s_previewMusic = Asset_LoadMUS(mp3Path);
     if (s_previewMusic) {
         Mix_PlayMusic(s_previewMusic, 0);   // toca 1x (mude p/ -1 se quiser loop)
         s_previewPlayingIndex = idx;
     }
 }
 
+static void Menu_FreeSongs(void) {
+    free(s_songList);   s_songList = NULL;
+    free(s_visiveis);   s_visiveis = NULL;
+    free(s_resultados); s_resultados = NULL;
+    s_songCount = s_totalVisiveis = s_totalResultados = 0;
+}
+
 // Carrega a lista de músicas e seus recordes
 static void Menu_LoadSongs() {
-    // 1. Carrega a base de dados de todos os recordes do arquivo
-    LeaderboardData leaderboardData;
-    Leaderboard_Load(&leaderboardData);
-    
-    // 2. Define a lista de músicas do jogo. O primeiro nome é o "ID" para o ranking E para o nome do arquivo.
-    const char* song_database[][2] = {
-        {"meu_lugar", "Meu Lugar"},
-        {"do_fundo_do_nosso_quintal", "Do Fundo do Nosso Quintal"} 
-    };
-    s_songCount = sizeof(song_database) / sizeof(song_database[0]);
-    // 3. Itera sobre a lista de músicas do jogo para preencher a s_songList
+    // 1. Recordes compartilhados com o jogo (o arquivo só é lido na primeira vez)
+    LeaderboardData* leaderboardData = Leaderboard_Get();
+
+    // 2. Músicas da biblioteca, já indexadas na inicialização
+    Menu_FreeSongs();
+    int total = Library_Count();
+    s_songList   = (SongInfo*)malloc((size_t)(total > 0 ? total : 1) * sizeof(SongInfo));
+    s_visiveis   = (int*)malloc((size_t)(total > 0 ? total : 1) * sizeof(int));
+    s_resultados = (int*)malloc((size_t)(total > 0 ? total : 1) * sizeof(int));
+    if (!s_songList || !s_visiveis || !s_resultados) {
+        printf("Aviso: sem memoria para a lista de musicas.\n");
+        Menu_FreeSongs();
+        return;
+    }
+    s_songCount = total;
     for (int i = 0; i < s_songCount; ++i) {
-        // Pega o nome de exibição da nossa base de dados
-        strcpy(s_songList[i].displayName, song_database[i][1]);
-
-        // Gera o caminho completo do arquivo a partir do ID
-        sprintf(s_songList[i].fileName, "assets/beatMaps/%s.samba", song_database[i][0]);
-
-        // Procura o recorde para esta música usando o ID
-        bool foundRecord = false;
-        for (int j = 0; j < leaderboardData.songCount; ++j) {
-            // Compara o ID da música com o nome salvo no leaderboard
-            if (strcmp(leaderboardData.songLeaderboards[j].songName, song_database[i][0]) == 0) {
-                 // Encontrou! Copia o recorde (nome e pontuação)
-                 s_songList[i].topScore = leaderboardData.songLeaderboards[j].scores[0];
-                 foundRecord = true;
-                 break; // Para de procurar, pois já achou a música
-            }
-        }
+        const LibrarySong* musica = Library_Get(i);
+        snprintf(s_songList[i].displayName, sizeof(s_songList[i].displayName), "%s", musica->nome);
+        snprintf(s_songList[i].fileName, sizeof(s_songList[i].fileName), "%s", musica->caminho);
+
+        // Procura o recorde pelo hash do chart, em O(1) (sem recorde: "---" e 0)
+        s_songList[i].chartId = musica->chartId;
+        s_songList[i].dificuldade = musica->dificuldade;
+        s_songList[i].topScore = Leaderboard_Entry(Leaderboard_Find(leaderboardData, musica->chartId, musica->id), 0);
+    }
+}
+
+// Ordem por dificuldade; empate fica na ordem do catálogo
+static int compararDificuldade(const void* a, const void* b) {
+    int ia = *(const int*)a, ib = *(const int*)b;
+    float da = s_songList[ia].dificuldade, db = s_songList[ib].dificuldade;
+    if (da != db) return ((s_ordem == ORDEM_MAIS_FACEIS) == (da < db)) ? -1 : 1;
+    return ia - ib;
+}
 
-        // Se, após o loop, não encontrou um recorde para a música, define os valores padrão
-        if (!foundRecord) {
-            strcpy(s_songList[i].topScore.name, "---");
-            s_songList[i].topScore.score = 0;
+// Refaz a lista exibida com a busca, o filtro e a ordem atuais, mantendo a
+// música selecionada se ela continuar visível
+static void Menu_ApplyView(void) {
+    int selecionada = (s_selectedButton >= 0 && s_selectedButton < s_totalVisiveis) ? s_visiveis[s_selectedButton] : -1;
+
+    const bool buscando = s_busca[0] != '\0';
+    const int base = buscando ? s_totalResultados : s_songCount;
+    s_totalVisiveis = 0;
+    for (int k = 0; k < base; ++k) {
+        int i = buscando ? s_resultados[k] : k;
+        if (s_filtro >= 0 && (int)Difficulty_Faixa(s_songList[i].dificuldade) != s_filtro) continue;
+        s_visiveis[s_totalVisiveis++] = i;
+    }
+    if (s_ordem != ORDEM_CATALOGO) qsort(s_visiveis, s_totalVisiveis, sizeof(int), compararDificuldade);
+
+    s_selectedButton = 0;
+    for (int k = 0; k < s_totalVisiveis; ++k) if (s_visiveis[k] == selecionada) s_selectedButton = k;
+    Menu_RevealSelection();
+}
+
+// Refaz o resultado da busca e a lista. 'refinar': a consulta só ganhou
+// caracteres no fim, então basta conferir o resultado anterior.
+static void Menu_Search(bool refinar) {
+    if (s_busca[0] == '\0')  s_totalResultados = 0;
+    else if (refinar)        s_totalResultados = Library_Search(s_busca, s_resultados, s_totalResultados, s_resultados);
+    else if (s_songCount > 0) s_totalResultados = Library_Search(s_busca, NULL, 0, s_resultados);
+    Menu_ApplyView();
+}
+
+// Liga/desliga a caixa de busca. Fora dela o SDL não gera SDL_TEXTINPUT
+// (as letras são comandos: D, F, M...).
+static void Menu_SetTyping(bool digitando) {
+    s_digitando = digitando;
+    if (digitando) SDL_StartTextInput();
+    else           SDL_StopTextInput();
+}
+
+// Cria a textura das faixas de miniatura (vazias; preenchidas por Menu_ThumbSlot)
+static void Menu_CreateThumbAtlas(SDL_Renderer* renderer) {
+    for (int f = 0; f < MINIATURA_FAIXAS; ++f) { s_thumbMusica[f] = -1; s_thumbUso[f] = 0; }
+    s_thumbAtlas = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC,
+                                     LIBRARY_COLUNAS, MINIATURA_H * MINIATURA_FAIXAS);
+    if (s_thumbAtlas) SDL_SetTextureBlendMode(s_thumbAtlas, SDL_BLENDMODE_BLEND);
+}
+
+// Faixa do atlas com a miniatura da música 'indice'. Se ela não está lá,
+// desenha a partir dos dados da biblioteca (nada é decodificado aqui) na faixa
+// usada há mais tempo: onda espelhada em volta do centro e barras de densidade.
+static int Menu_ThumbSlot(int indice) {
+    int faixa = 0;
+    for (int f = 0; f < MINIATURA_FAIXAS; ++f) {
+        if (s_thumbMusica[f] == indice) { s_thumbUso[f] = s_quadroMenu; return f; }
+        if (s_thumbUso[f] < s_thumbUso[faixa]) faixa = f;
+    }
+
+    static Uint32 pixels[MINIATURA_H * LIBRARY_COLUNAS];
+    memset(pixels, 0, sizeof(pixels));
+    const LibrarySong* musica = Library_Get(indice);
+    const Uint32 corOnda = 0xE0FFFFFFu, corDensidade = 0xE0FFC000u; // ARGB
+    const int centro = MINIATURA_ONDA_H / 2;
+    for (int c = 0; musica && c < LIBRARY_COLUNAS; ++c) {
+        if (musica->temOnda) {
+            int cima  = centro - 1 - musica->ondaMax[c] * (centro - 1) / 255;
+            int baixo = centro + musica->ondaMin[c] * (centro - 1) / 255;
+            for (int y = cima; y <= baixo; ++y) pixels[y * LIBRARY_COLUNAS + c] = corOnda;
         }
+        int barra = (musica->densidade[c] * MINIATURA_DENSIDADE_H + 254) / 255;
+        for (int y = MINIATURA_H - barra; y < MINIATURA_H; ++y) pixels[y * LIBRARY_COLUNAS + c] = corDensidade;
     }
+
+    SDL_Rect destino = { 0, faixa * MINIATURA_H, LIBRARY_COLUNAS, MINIATURA_H };
+    SDL_UpdateTexture(s_thumbAtlas, &destino, pixels, LIBRARY_COLUNAS * (int)sizeof(Uint32));
+    s_thumbMusica[faixa] = indice;
+    s_thumbUso[faixa] = s_quadroMenu;
+    return faixa;
 }
 // Inicializa os recursos do menu
 static bool Menu_Init(SDL_Renderer* renderer) {
-    s_background = IMG_LoadTexture(renderer, "assets/image/menuBG.png");
-    s_font = TTF_OpenFont("assets/font/pixelFont.ttf", 48);
-    if (!s_background || !s_font) return false;
+    Uint64 profCarga = Prof_Begin(PROF_ZONA_CARGA);
+    s_background = TexCache_LoadTexture(renderer, "assets/image/menuBG.png");
+    s_font = Asset_OpenFont("assets/font/pixelFont.ttf", 48);
+    if (!s_background || !s_font) {
+        Prof_End(PROF_ZONA_CARGA, profCarga);
+        return false;
+    }
 
     //abre uma fonte menor só para textos longos/rodapé
-    s_fontSmall = TTF_OpenFont("assets/font/pixelFont.ttf", 28);
-    if (!s_fontSmall) return false;
+    s_fontSmall = Asset_OpenFont("assets/font/pixelFont.ttf", 28);
+    if (!s_fontSmall) {
+        Prof_End(PROF_ZONA_CARGA, profCarga);
+        return false;
+    }
     
     Menu_LoadSongs();
+    Menu_Search(false); // a busca continua valendo na volta de uma partida
+    Menu_CreateThumbAtlas(renderer);
+    Prof_End(PROF_ZONA_CARGA, profCarga);
     s_currentScreen = MENU_SCREEN_MAIN;
     s_selectedButton = 1; // Começa em "Músicas"
+    s_lastInteraction = SDL_GetTicks();
 
     // Calcula as hitboxes dos botões (coordenadas batendo com o RenderText)
     {
@@ -156,6 +335,7 @@ static bool Menu_Init(SDL_Renderer* renderer) {
 
     //garante que não há preview tocando ao entrar
     Menu_StopPreview();
+    Menu_SetTyping(false);
 
     return true;
 }
@@ -163,14 +343,64 @@ static bool Menu_Init(SDL_Renderer* renderer) {
 // Libera os recursos do menu
 static void Menu_Shutdown() {
     SDL_DestroyTexture(s_background);
+    if (s_thumbAtlas) { SDL_DestroyTexture(s_thumbAtlas); s_thumbAtlas = NULL; }
     TTF_CloseFont(s_font);
     if (s_fontSmall) TTF_CloseFont(s_fontSmall);
+    Menu_SetTyping(false);
+    Menu_FreeSongs();
 }
 
 // Lida com os inputs do menu
 static ApplicationState Menu_HandleEvent(SDL_Event* e, char* selectedSongPath) {
+    if (e->type == SDL_KEYDOWN || e->type == SDL_MOUSEMOTION || e->type == SDL_MOUSEBUTTONDOWN || e->type == SDL_MOUSEWHEEL) {
+        s_lastInteraction = SDL_GetTicks();
+    }
+
+    // Caixa de busca aberta: o teclado escreve em vez de dar comandos. Só ASCII
+    // visível (o RenderText é Latin-1); sem acento a busca acha do mesmo jeito.
+    if (s_currentScreen == MENU_SCREEN_SONG_SELECT && s_digitando) {
+        if (e->type == SDL_TEXTINPUT) {
+            size_t n = strlen(s_busca);
+            const size_t antes = n;
+            for (const char* c = e->text.text; *c && n + 1 < sizeof(s_busca); ++c) {
+                if (*c >= ' ' && *c <= '~') s_busca[n++] = *c;
+            }
+            s_busca[n] = '\0';
+            if (n != antes) Menu_Search(antes > 0);
+            return APP_STATE_MENU;
+        }
+        if (e->type == SDL_KEYDOWN) {
+            SDL_Keycode key = e->key.keysym.sym;
+            if (key == SDLK_BACKSPACE) { // com repetição: segurar apaga tudo
+                size_t n = strlen(s_busca);
+                if (n > 0) { s_busca[n - 1] = '\0'; Menu_Search(false); }
+                return APP_STATE_MENU;
+            }
+            if (e->key.repeat != 0 && key != SDLK_UP && key != SDLK_DOWN) return APP_STATE_MENU;
+            if (key == SDLK_ESCAPE) { // fecha e limpa a busca
+                s_busca[0] = '\0';
+                Menu_SetTyping(false);
+                Menu_Search(false);
+                return APP_STATE_MENU;
+            }
+            if (key == SDLK_RETURN || key == SDLK_KP_ENTER) {
+                Menu_SetTyping(false); // e segue: Enter inicia a música selecionada
+            } else if (key != SDLK_UP && key != SDLK_DOWN && key != SDLK_PAGEUP && key != SDLK_PAGEDOWN && key != SDLK_F3) {
+                return APP_STATE_MENU; // letras chegam como SDL_TEXTINPUT
+            }
+        }
+    }
+
+    // Setas com repetição: segurar percorre bibliotecas longas
+    if (s_currentScreen == MENU_SCREEN_SONG_SELECT && e->type == SDL_KEYDOWN && e->key.repeat != 0 && s_totalVisiveis > 0) {
+        SDL_Keycode key = e->key.keysym.sym;
+        if (key == SDLK_UP && s_selectedButton > 0) { s_selectedButton--; Menu_RevealSelection(); }
+        if (key == SDLK_DOWN && s_selectedButton < s_totalVisiveis - 1) { s_selectedButton++; Menu_RevealSelection(); }
+    }
+
     if (e->type == SDL_KEYDOWN && e->key.repeat == 0) {
         SDL_Keycode key = e->key.keysym.sym;
+        if (key == SDLK_F3) Prof_ToggleOverlay();
         if (s_currentScreen == MENU_SCREEN_MAIN) {
             if (key == SDLK_UP) s_selectedButton = (s_selectedButton - 1 + 4) % 4;
             if (key == SDLK_DOWN) s_selectedButton = (s_selectedButton + 1) % 4;
@@ -178,24 +408,50 @@ static ApplicationState Menu_HandleEvent(SDL_Event* e, char* selectedSongPath) {
                 if (s_selectedButton == 1) { // "Músicas"
                     s_currentScreen = MENU_SCREEN_SONG_SELECT;
                     s_selectedButton = 0; // Reseta para a primeira música
+                    s_topo = 0;
                 } else if (s_selectedButton == 3) { // "Sair"
                     return APP_STATE_EXIT;
                 }
             }
         } else if (s_currentScreen == MENU_SCREEN_SONG_SELECT) {
-            if (key == SDLK_UP) s_selectedButton = (s_selectedButton - 1 + s_songCount) % s_songCount;
-            if (key == SDLK_DOWN) s_selectedButton = (s_selectedButton + 1) % s_songCount;
+            if (key == SDLK_d) { s_ordem = (MenuOrdem)((s_ordem + 1) % ORDEM_NUM); Menu_ApplyView(); }
+            if (key == SDLK_f) { s_filtro = (s_filtro + 2) % (DIFICULDADE_NUM_FAIXAS + 1) - 1; Menu_ApplyView(); }
+            if (key == SDLK_SLASH || key == SDLK_KP_DIVIDE) Menu_SetTyping(true);
+            const bool temMusica = s_totalVisiveis > 0; // filtro sem músicas: só ESC, D, F e /
+            if (key == SDLK_UP && temMusica) s_selectedButton = (s_selectedButton - 1 + s_totalVisiveis) % s_totalVisiveis;
+            if (key == SDLK_DOWN && temMusica) s_selectedButton = (s_selectedButton + 1) % s_totalVisiveis;
+            if (key == SDLK_PAGEUP && temMusica) s_selectedButton = SDL_max(s_selectedButton - LISTA_LINHAS, 0);
+            if (key == SDLK_PAGEDOWN && temMusica) s_selectedButton = SDL_min(s_selectedButton + LISTA_LINHAS, s_totalVisiveis - 1);
+            if (key == SDLK_HOME && temMusica) s_selectedButton = 0;
+            if (key == SDLK_END && temMusica) s_selectedButton = s_totalVisiveis - 1;
+            Menu_RevealSelection();
             if (key == SDLK_ESCAPE) { // Voltar
                  Menu_StopPreview();       //para preview ao sair
                 s_currentScreen = MENU_SCREEN_MAIN;
                 s_selectedButton = 1;
             }
-            if (key == SDLK_SPACE) {      //play/pause preview
-                Menu_PlayPreview(s_selectedButton);
+            if (key == SDLK_SPACE && temMusica) {      //play/pause preview
+                Menu_PlayPreview(s_visiveis[s_selectedButton]);
             }
-            if (key == SDLK_RETURN || key == SDLK_KP_ENTER) { // Selecionou uma música
+            if ((key == SDLK_RETURN || key == SDLK_KP_ENTER) && temMusica) { // Selecionou uma música
                  Menu_StopPreview();       //para garantir que o gameplay não sobreponha preview
-                strcpy(selectedSongPath, s_songList[s_selectedButton].fileName);
+                strcpy(selectedSongPath, s_songList[s_visiveis[s_selectedButton]].fileName);
+                return APP_STATE_GAMEPLAY;
+            }
+            if (key == SDLK_m && temMusica) { // maratona: da selecionada até o fim da lista exibida
+                Menu_StopPreview();
+                Playlist_Limpar();
+                for (int i = s_selectedButton; i < s_totalVisiveis; ++i) {
+                    int indice = s_visiveis[i];
+                    if (!Playlist_Adicionar(s_songList[indice].fileName, Library_Get(indice)->totalNotas)) break;
+                }
+                strcpy(selectedSongPath, s_songList[s_visiveis[s_selectedButton]].fileName);
+                return APP_STATE_GAMEPLAY;
+            }
+            if (key == SDLK_TAB && temMusica) { // demo: o bot toca a música selecionada
+                Menu_StopPreview();
+                strcpy(selectedSongPath, s_songList[s_visiveis[s_selectedButton]].fileName);
+                Game_QueueDemo(AUTOPLAY_PERFEITO, false);
                 return APP_STATE_GAMEPLAY;
             }
         }
@@ -206,7 +462,7 @@ static ApplicationState Menu_HandleEvent(SDL_Event* e, char* selectedSongPath) {
         (e->type == SDL_MOUSEMOTION || e->type == SDL_MOUSEBUTTONDOWN)) {
 
         int mx, my;
-        SDL_GetMouseState(&mx, &my);
+        EventMousePos(e, &mx, &my);
 
         // hover atualiza a seleção visual (somente botões habilitados)
         if (ptInRect(mx, my, s_btnRects[1])) {
@@ -220,6 +476,7 @@ static ApplicationState Menu_HandleEvent(SDL_Event* e, char* selectedSongPath) {
             if (ptInRect(mx, my, s_btnRects[1])) {
                 s_currentScreen = MENU_SCREEN_SONG_SELECT;
                 s_selectedButton = 0; // primeira música
+                s_topo = 0;
             } else if (ptInRect(mx, my, s_btnRects[3])) {
                 return APP_STATE_EXIT;
             }
@@ -231,21 +488,24 @@ static ApplicationState Menu_HandleEvent(SDL_Event* e, char* selectedSongPath) {
         (e->type == SDL_MOUSEMOTION || e->type == SDL_MOUSEBUTTONDOWN)) {
 
         int mx, my;
-        SDL_GetMouseState(&mx, &my);
-
-        for (int i = 0; i < s_songCount; ++i) {
-            SDL_Rect row = GetSongRowRect(i);
-            if (ptInRect(mx, my, row)) {
-                s_selectedButton = i; // hover destaca a linha
-                if (e->type == SDL_MOUSEBUTTONDOWN && e->button.button == SDL_BUTTON_LEFT) {
-                   // clique toca/pausa o preview
-                    Menu_PlayPreview(i); 
-                }
-                break; // já achou a linha sob o mouse
+        EventMousePos(e, &mx, &my);
+
+        int v = SongRowAt(mx, my);
+        if (v >= 0) {
+            s_selectedButton = v; // hover destaca a linha
+            if (e->type == SDL_MOUSEBUTTONDOWN && e->button.button == SDL_BUTTON_LEFT) {
+               // clique toca/pausa o preview
+                Menu_PlayPreview(s_visiveis[v]); 
             }
         }
     }
 
+    // Roda do mouse rola a lista; a seleção fica onde está
+    if (s_currentScreen == MENU_SCREEN_SONG_SELECT && e->type == SDL_MOUSEWHEEL) {
+        int passos = e->wheel.direction == SDL_MOUSEWHEEL_FLIPPED ? -e->wheel.y : e->wheel.y;
+        Menu_ScrollTo(s_topo - passos * LISTA_ROLAGEM);
+    }
+
     return APP_STATE_MENU; // Por padrão, continua no menu
 }
 
@@ -269,15 +529,33 @@ static void Menu_Render(SDL_Renderer* renderer) {
     } else if (s_currentScreen == MENU_SCREEN_SONG_SELECT) {
         RenderText(renderer, s_font, "Escolha uma Musica", SCREEN_WIDTH / 2, 100, gold, TEXT_ALIGN_CENTER);
 
+        static const char* nomesOrdem[ORDEM_NUM] = { "Catalogo", "Mais faceis", "Mais dificeis" };
+        char vistaBuffer[160];
+        snprintf(vistaBuffer, sizeof(vistaBuffer), "Ordem: %s   Dificuldade: %s   (%d de %d)", nomesOrdem[s_ordem],
+                 s_filtro < 0 ? "Todas" : Difficulty_FaixaNome((DificuldadeFaixa)s_filtro), s_totalVisiveis, s_songCount);
+        RenderText(renderer, s_fontSmall, vistaBuffer, SCREEN_WIDTH / 2, 170, white, TEXT_ALIGN_CENTER);
+
+        if (s_digitando || s_busca[0]) {
+            char buscaBuffer[BUSCA_MAX + 16];
+            snprintf(buscaBuffer, sizeof(buscaBuffer), "Busca: %s%s", s_busca, s_digitando ? "_" : "");
+            RenderText(renderer, s_fontSmall, buscaBuffer, SCREEN_WIDTH / 2, 215, s_digitando ? gold : white, TEXT_ALIGN_CENTER);
+        }
+        if (s_totalVisiveis == 0) {
+            RenderText(renderer, s_fontSmall, s_busca[0] ? "Nenhuma musica encontrada" : "Nenhuma musica nesta faixa",
+                       SCREEN_WIDTH / 2, LISTA_Y, grey, TEXT_ALIGN_CENTER);
+        }
+
         // --- Lógica de Renderização da Lista de Músicas com Recordes ---
-        int listStartY = 250;     // Posição Y inicial da lista
-        int listLineHeight = 60;  // Espaçamento entre as músicas
+        // Só as LISTA_LINHAS linhas a partir de s_topo
         int nameX = 150;          // Posição X para o nome da música (alinhado à esquerda)
         int scoreX = SCREEN_WIDTH - 150; // Posição X para o recorde (alinhado à direita)
+        s_quadroMenu++;
 
-        for (int i = 0; i < s_songCount; ++i) {
-            SDL_Color color = (s_selectedButton == i) ? gold : white;
-            int y_pos = listStartY + i * listLineHeight;
+        for (int linha = 0; linha < LISTA_LINHAS && s_topo + linha < s_totalVisiveis; ++linha) {
+            const int v = s_topo + linha;
+            const int i = s_visiveis[v];
+            SDL_Color color = (s_selectedButton == v) ? gold : white;
+            int y_pos = LISTA_Y + linha * LISTA_LINHA_H;
 
             // indicador ▶ na música em preview
             char nameBuf[192];
@@ -288,6 +566,14 @@ static void Menu_Render(SDL_Renderer* renderer) {
 
             // 1. Desenha o nome da música, alinhado à ESQUERDA
             RenderText(renderer, s_font, nameBuf, nameX, y_pos, color, TEXT_ALIGN_LEFT);
+
+            // Miniatura (onda + densidade), recortada da textura única
+            if (s_thumbAtlas) {
+                SDL_Rect src = { 0, Menu_ThumbSlot(i) * MINIATURA_H, LIBRARY_COLUNAS, MINIATURA_H };
+                SDL_Rect dst = { MINIATURA_X, y_pos - MINIATURA_H / 2, LIBRARY_COLUNAS * MINIATURA_ESCALA_X, MINIATURA_H };
+                SDL_SetTextureAlphaMod(s_thumbAtlas, s_selectedButton == v ? 255 : 140);
+                SDL_RenderCopy(renderer, s_thumbAtlas, &src, &dst);
+            }
       
             // 2. Desenha o recorde, alinhado à DIREITA
             char recordBuffer[128];
@@ -299,15 +585,48 @@ static void Menu_Render(SDL_Renderer* renderer) {
             RenderText(renderer, s_font, recordBuffer, scoreX, y_pos, color, TEXT_ALIGN_RIGHT);
         }
 
-        const int instrY1 = 440;
-        const int instrY2 = 480;
-        RenderText(renderer, s_fontSmall, "Barra de Espaco / Clique: Preview",
+        // Barra de rolagem: o trecho à vista dentro da lista exibida
+        if (s_totalVisiveis > LISTA_LINHAS) {
+            SDL_Rect trilho = { SCREEN_WIDTH - 50, LISTA_Y - 28, 8, LISTA_LINHAS * LISTA_LINHA_H - 4 };
+            SDL_Rect marca  = trilho;
+            marca.h = SDL_max(trilho.h * LISTA_LINHAS / s_totalVisiveis, 16);
+            marca.y = trilho.y + (trilho.h - marca.h) * s_topo / (s_totalVisiveis - LISTA_LINHAS);
+            SDL_SetRenderDrawColor(renderer, grey.r, grey.g, grey.b, 255);
+            SDL_RenderFillRect(renderer, &trilho);
+            SDL_SetRenderDrawColor(renderer, gold.r, gold.g, gold.b, 255);
+            SDL_RenderFillRect(renderer, &marca);
+        }
+
+        // Estatísticas da música selecionada, direto dos agregados do histórico
+        if (s_selectedButton >= 0 && s_selectedButton < s_totalVisiveis) {
+            const SongInfo* musica = &s_songList[s_visiveis[s_selectedButton]];
+            const SongStats* st = History_GetStats(musica->chartId);
+            const LibrarySong* info = Library_Get(s_visiveis[s_selectedButton]);
+            char statsBuffer[256];
+            int n = snprintf(statsBuffer, sizeof(statsBuffer), "%s%sDificuldade: %.1f (%s)   ",
+                             info ? info->artista : "", (info && info->artista[0]) ? "   " : "", musica->dificuldade,
+                             Difficulty_FaixaNome(Difficulty_Faixa(musica->dificuldade)));
+            if (st && st->plays > 0) {
+                snprintf(statsBuffer + n, sizeof(statsBuffer) - n, "Jogadas: %d   Melhor precisao: %.1f%%   Clear: %d%%",
+                         st->plays, st->bestAccuracy, st->clears * 100 / st->plays);
+            } else {
+                snprintf(statsBuffer + n, sizeof(statsBuffer) - n, "Nunca jogada");
+            }
+            RenderText(renderer, s_fontSmall, statsBuffer, SCREEN_WIDTH / 2, SCREEN_HEIGHT - 180, white, TEXT_ALIGN_CENTER);
+        }
+
+        const int instrY1 = SCREEN_HEIGHT - 120;
+        const int instrY2 = SCREEN_HEIGHT - 80;
+        RenderText(renderer, s_fontSmall, "Barra de Espaco / Clique: Preview   /: Buscar   Roda / PgUp / PgDn: Rolar",
            SCREEN_WIDTH/2, instrY1, white, TEXT_ALIGN_CENTER);
-        RenderText(renderer, s_fontSmall, "Enter: Iniciar    ->   ESC: Voltar",
+        RenderText(renderer, s_fontSmall, "Enter: Iniciar   M: Maratona   TAB: Demo   D: Ordem   F: Filtro   ESC: Voltar",
            SCREEN_WIDTH/2, instrY2, white, TEXT_ALIGN_CENTER);
     }
-    
-    SDL_RenderPresent(renderer);
+
+    Prof_RenderOverlay(renderer);
+    Uint64 prof = Prof_Begin(PROF_ZONA_PRESENT);
+    Video_Present(renderer);
+    Prof_End(PROF_ZONA_PRESENT, prof);
 }
 
 // A função principal que será chamada pela main
@@ -315,18 +634,30 @@ ApplicationState Menu_Run(SDL_Renderer* renderer, char* selectedSongPath) {
     if (!Menu_Init(renderer)) return APP_STATE_EXIT;
 
     ApplicationState nextState = APP_STATE_MENU;
-    Uint32 timeout = 16;
+    Uint32 timeout = Pacing_UsesVsync() ? 16 : 0; // em jit quem espera é o Pacing_WaitForFrame
 
     while (nextState == APP_STATE_MENU) {
+        Pacing_WaitForFrame();
         SDL_Event e;
         while (AUX_WaitEventTimeout(&e, &timeout) != 0) {
+            Trace_Input(&e);
             if (e.type == SDL_QUIT) {
                 nextState = APP_STATE_EXIT;
                 break;
             }
             nextState = Menu_HandleEvent(&e, selectedSongPath);
         }
+
+        // Attract: ninguém mexeu no menu principal por um tempo -> demo humanizada
+        if (nextState == APP_STATE_MENU && s_currentScreen == MENU_SCREEN_MAIN && s_songCount > 0 &&
+            SDL_GetTicks() - s_lastInteraction >= MENU_ATTRACT_IDLE_MS) {
+            strcpy(selectedSongPath, s_songList[s_attractIndex].fileName);
+            s_attractIndex = (s_attractIndex + 1) % s_songCount;
+            Game_QueueDemo(AUTOPLAY_HUMANO, true);
+            nextState = APP_STATE_GAMEPLAY;
+        }
         Menu_Render(renderer);
+        Prof_EndFrame();
     }
     
     Menu_Shutdown();
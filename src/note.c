@@ -4,12 +4,19 @@
 #include <SDL2/SDL2_gfxPrimitives.h>
 #include <math.h> // Para fmaxf
 
+static bool s_contornoAA = true;
+
+void Note_SetOutlineAA(bool ligado) { s_contornoAA = ligado; }
+
 // Cria nota simples
 Nota Note_Create(SDL_Keycode tecla, Uint32 spawnTime) {
     Nota n = {0}; // Zera a struct
     n.tecla = tecla;
     n.spawnTime = spawnTime;
+    n.hitTime = spawnTime + Note_TravelMs(tecla);
+    n.distHit = n.distTail = n.hitTime;
     n.duration = 0;
+    n.beat = -1;
     n.estado = NOTA_INATIVA;
     n.pos = (SDL_FRect){NOTE_START_X, NOTE_Y, NOTE_WIDTH, NOTE_HEIGHT};
     return n;
@@ -19,16 +26,72 @@ Nota Note_Create(SDL_Keycode tecla, Uint32 spawnTime) {
 Nota Note_CreateLong(SDL_Keycode tecla, Uint32 spawnTime, Uint32 duration) {
     Nota n = Note_Create(tecla, spawnTime);
     n.duration = duration;
+    n.distTail = n.distHit + duration;
+    n.bodyLength = NOTE_SPEED * (duration / 1000.0f);
     return n;
 }
 
 // Atualiza a posição
-void Note_Update(Nota* nota, float deltaTime) {
+void Note_Update(Nota* nota, double distAgora, float escala) {
     if (nota->estado == NOTA_ATIVA || nota->estado == NOTA_SEGURANDO || nota->estado == NOTA_QUEBRADA) {
-        nota->pos.x -= NOTE_SPEED * deltaTime;
+        nota->pos.x = Note_CheckerX(nota->tecla) + (float)((nota->distHit - distAgora) * escala);
+        nota->bodyLength = (float)((nota->distTail - nota->distHit) * escala);
+    }
+}
+
+float Note_CheckerX(SDL_Keycode tecla) {
+    return (tecla == SDLK_z) ? CHECKER_Z_X : (tecla == SDLK_x) ? CHECKER_X_X : CHECKER_C_X;
+}
+
+double Note_SpawnDist(const Nota* nota, float escala) {
+    return nota->distHit - (NOTE_START_X - Note_CheckerX(nota->tecla)) / escala;
+}
+
+// Com hi-speed, o percurso diferente de cada pista pode inverter notas
+// vizinhas: inserção estável (linear, a lista já vem quase em ordem de acerto).
+void Note_SortBySpawn(Nota* notas, int total, float escala) {
+    for (int i = 1; i < total; ++i) {
+        Nota n = notas[i];
+        double chave = Note_SpawnDist(&n, escala);
+        int j = i - 1;
+        while (j >= 0 && Note_SpawnDist(&notas[j], escala) > chave) { notas[j + 1] = notas[j]; --j; }
+        notas[j + 1] = n;
+    }
+}
+
+void Note_AdvanceFrame(Nota* notas, int total, int* proxima, double distAgora, float escala,
+                       Uint32 tempoMs, float offsetMs, float dt, NotasPerdidas* perdidas) {
+    perdidas->toques = perdidas->longas = 0;
+    while (*proxima < total) {
+        Nota* n = &notas[*proxima];
+        if (distAgora < Note_SpawnDist(n, escala)) break;
+        n->estado = NOTA_ATIVA;
+        (*proxima)++;
+    }
+
+    // Passou da janela OK depois do alvo (já com o offset do jogador) = erro
+    float limiteMs = (float)tempoMs - offsetMs - HIT_WINDOW_OK_MS;
+    for (int i = 0; i < total; ++i) {
+        Nota* nota = &notas[i];
+        if (nota->estado == NOTA_ATIVA || nota->estado == NOTA_SEGURANDO) Note_Update(nota, distAgora, escala);
+
+        if (nota->estado == NOTA_ATIVA) {
+            if ((float)nota->hitTime < limiteMs) { nota->estado = NOTA_INATIVA; perdidas->toques++; }
+        } else if (nota->estado == NOTA_SEGURANDO) {
+            if ((float)(nota->hitTime + nota->duration) < limiteMs) { nota->estado = NOTA_INATIVA; perdidas->longas++; }
+        }
+
+        if (nota->despawnTimer > 0) {
+            nota->despawnTimer -= dt;
+            if (nota->despawnTimer <= 0) nota->estado = NOTA_INATIVA;
+        }
     }
 }
 
+Uint32 Note_TravelMs(SDL_Keycode tecla) {
+    return (Uint32)((NOTE_START_X - Note_CheckerX(tecla)) * 1000.0f / NOTE_SPEED + 0.5f);
+}
+
 // Lógica de renderização completa
 void Note_Render(const Nota* nota, SDL_Renderer* renderer, float checker_pos_x) {
     if (nota->estado == NOTA_INATIVA || nota->estado == NOTA_ATINGIDA) return;
@@ -48,8 +111,7 @@ void Note_Render(const Nota* nota, SDL_Renderer* renderer, float checker_pos_x)
     float checker_centerX = checker_pos_x + (NOTE_WIDTH / 2);
 
     if (nota->duration > 0) { // Lógica para NOTA LONGA
-        float body_length = NOTE_SPEED * (nota->duration / 1000.0f);
-        float tail_centerX = head_centerX + body_length;
+        float tail_centerX = head_centerX + nota->bodyLength;
 
         // Desenha o CORPO 
         float body_visible_start_x = head_centerX;
@@ -67,13 +129,13 @@ void Note_Render(const Nota* nota, SDL_Renderer* renderer, float checker_pos_x)
         // Desenha a CAUDA (círculo final) 
         if (tail_centerX > checker_pos_x) {
              filledCircleRGBA(renderer, (Sint16)tail_centerX, centerY, radius, r, g, b, a);
-             aacircleRGBA(renderer, (Sint16)tail_centerX, centerY, radius, 255, 255, 255, a);
+             if (s_contornoAA) aacircleRGBA(renderer, (Sint16)tail_centerX, centerY, radius, 255, 255, 255, a);
         }
     }
     
     // Desenha a CABEÇA (círculo inicial) 
     if (!(nota->estado == NOTA_SEGURANDO && head_centerX < checker_centerX)) {
         filledCircleRGBA(renderer, head_centerX, centerY, radius, r, g, b, a);
-        aacircleRGBA(renderer, head_centerX, centerY, radius, 255, 255, 255, a);
+        if (s_contornoAA) aacircleRGBA(renderer, head_centerX, centerY, radius, 255, 255, 255, a);
     }
 }
\ No newline at end of file
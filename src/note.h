@@ -4,6 +4,7 @@
 #define NOTE_H
 
 #include <SDL2/SDL.h>
+#include <stdbool.h>
 
 // Estados possíveis de uma nota
 typedef enum {
@@ -19,15 +20,50 @@ typedef struct {
     SDL_Keycode tecla;
     Uint32 spawnTime;
     Uint32 duration;      // Duração em ms. 0 para notas normais.
+    Uint32 hitTime;       // Ms em que a cabeça chega ao checker (o julgamento é por ele)
+    Sint32 beat;          // Beat do mapa de andamento em que a nota cai (-1 = chart sem BPM ou antes do beat 0)
+    double distHit;       // Cabeça e cauda na tabela de rolagem (ScrollMap_Dist de hitTime e do fim)
+    double distTail;
     EstadoNota estado;
     SDL_FRect pos;
+    float bodyLength;     // Comprimento do corpo em pixels no frame atual (0 para notas normais)
     float despawnTimer; // Timer para notas erradas desaparecerem.
 } Nota;
 
 // Protótipos das funções
 Nota Note_Create(SDL_Keycode tecla, Uint32 spawnTime);
 Nota Note_CreateLong(SDL_Keycode tecla, Uint32 spawnTime, Uint32 duration);
-void Note_Update(Nota* nota, float deltaTime);
+// Posiciona a nota a partir da distância de rolagem do frame: uma conta por nota,
+// sem acumular deslocamento. 'escala' = pixels por unidade de distância (NOTE_SPEED/1000 * hi-speed).
+void Note_Update(Nota* nota, double distAgora, float escala);
+
+// X do checker da pista da tecla
+float Note_CheckerX(SDL_Keycode tecla);
+
+// Distância de rolagem em que a nota aparece na borda direita (NOTE_START_X)
+double Note_SpawnDist(const Nota* nota, float escala);
+
+// Põe o beatmap em ordem de surgimento (Note_SpawnDist), que é a ordem que
+// Note_AdvanceFrame percorre. Chamar ao carregar e ao mudar o hi-speed.
+void Note_SortBySpawn(Nota* notas, int total, float escala);
+
+// Notas que passaram da janela num quadro (o chamador aplica combo, vida e julgamento)
+typedef struct {
+    int toques;   // cabeça não acertada
+    int longas;   // longa segurada além do fim sem soltar
+} NotasPerdidas;
+
+// Um quadro do beatmap (Game_Update e o bench usam este mesmo passo): surgimento
+// a partir de '*proxima', posição, perdas e despawn. Uma nota vira erro quando
+// tempoMs - offsetMs passa do alvo (ou do fim da longa) por mais de HIT_WINDOW_OK_MS.
+void Note_AdvanceFrame(Nota* notas, int total, int* proxima, double distAgora, float escala,
+                       Uint32 tempoMs, float offsetMs, float dt, NotasPerdidas* perdidas);
+
+// Tempo que a nota leva do surgimento ao checker a velocidade 1 (define hitTime dos charts em ms)
+Uint32 Note_TravelMs(SDL_Keycode tecla);
 void Note_Render(const Nota* nota, SDL_Renderer* renderer, float checker_pos_x);
 
+// Liga/desliga o contorno antialiased (aacircle) das notas; ligado por padrão.
+void Note_SetOutlineAA(bool ligado);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,160 @@
+#include "playlist.h"
+#include "auxFuncs/texCache.h"
+#include <SDL2/SDL_image.h>
+#include <SDL2/SDL_mixer.h>
+#include <stdio.h>
+#include <string.h>
+
+typedef struct {
+    char caminho[256];
+    int  totalNotas;
+} PlaylistItem;
+
+// O que o thread de apoio entrega: a fase sem texturas e as imagens já decodificadas.
+// As texturas são subidas depois, pelo thread principal (Playlist_Preparar).
+typedef struct {
+    SDL_Thread*  thread;
+    SDL_atomic_t pronto;
+    char         caminho[256];
+    Fase*        fase;
+    SDL_Surface* fundo;
+    SDL_Surface* pista;
+    SDL_Texture* fundoTex;
+    SDL_Texture* pistaTex;
+} PreCarga;
+
+static PlaylistItem s_itens[PLAYLIST_MAX];
+static int          s_total = 0;
+static int          s_posicao = 0;
+static PreCarga     s_preCarga;
+
+static int preCarregar(void* dados) {
+    PreCarga* p = (PreCarga*)dados;
+    Fase* fase = Fase_CarregarChart(p->caminho);
+    if (fase && Fase_PreCarregarMusica(fase)) {
+        p->fundo = TexCache_LoadSurface(fase->caminhoFundo);
+        p->pista = TexCache_LoadSurface(fase->caminhoPista);
+    } else if (fase) {
+        printf("Playlist: nao foi possivel ler a musica '%s': %s\n", fase->caminhoMusica, Mix_GetError());
+        Fase_Liberar(fase);
+        fase = NULL;
+    }
+    p->fase = fase;
+    SDL_AtomicSet(&p->pronto, 1);
+    return 0;
+}
+
+// Espera o thread de pré-carga, se houver
+static void esperarPreCarga(void) {
+    if (s_preCarga.thread) {
+        SDL_WaitThread(s_preCarga.thread, NULL);
+        s_preCarga.thread = NULL;
+    }
+}
+
+static void descartarPreCarga(void) {
+    esperarPreCarga();
+    Fase_Liberar(s_preCarga.fase);
+    if (s_preCarga.fundo) SDL_FreeSurface(s_preCarga.fundo);
+    if (s_preCarga.pista) SDL_FreeSurface(s_preCarga.pista);
+    if (s_preCarga.fundoTex) SDL_DestroyTexture(s_preCarga.fundoTex);
+    if (s_preCarga.pistaTex) SDL_DestroyTexture(s_preCarga.pistaTex);
+    memset(&s_preCarga, 0, sizeof(s_preCarga));
+}
+
+void Playlist_Limpar(void) {
+    descartarPreCarga();
+    s_total = 0;
+    s_posicao = 0;
+}
+
+void Playlist_Reiniciar(void) {
+    descartarPreCarga();
+    s_posicao = 0;
+}
+
+bool Playlist_Adicionar(const char* caminho, int totalNotas) {
+    if (s_total >= PLAYLIST_MAX) return false;
+    snprintf(s_itens[s_total].caminho, sizeof(s_itens[s_total].caminho), "%s", caminho);
+    s_itens[s_total].totalNotas = totalNotas;
+    s_total++;
+    return true;
+}
+
+bool Playlist_Ativa(void)     { return s_total > 1; }
+int  Playlist_Total(void)     { return s_total; }
+int  Playlist_Posicao(void)   { return s_posicao; }
+bool Playlist_TemProxima(void) { return s_posicao + 1 < s_total; }
+
+const char* Playlist_Atual(void) {
+    return s_posicao < s_total ? s_itens[s_posicao].caminho : NULL;
+}
+
+int Playlist_MaxNotas(void) {
+    int maior = 0;
+    for (int i = 0; i < s_total; ++i)
+        if (s_itens[i].totalNotas > maior) maior = s_itens[i].totalNotas;
+    return maior;
+}
+
+void Playlist_PreCarregarProxima(void) {
+    if (!Playlist_TemProxima() || s_preCarga.thread || SDL_AtomicGet(&s_preCarga.pronto)) return;
+
+    snprintf(s_preCarga.caminho, sizeof(s_preCarga.caminho), "%s", s_itens[s_posicao + 1].caminho);
+    s_preCarga.thread = SDL_CreateThread(preCarregar, "playlist", &s_preCarga);
+    if (!s_preCarga.thread) {
+        // Sem thread a pré-carga acontece na troca, com uma pausa visível
+        printf("Aviso: thread de pre-carga indisponivel (%s).\n", SDL_GetError());
+    }
+}
+
+// Sobe uma superfície decodificada e a libera (com erro a textura fica NULL)
+static void subirTextura(SDL_Renderer* renderer, SDL_Surface** superficie, SDL_Texture** textura) {
+    *textura = SDL_CreateTextureFromSurface(renderer, *superficie);
+    SDL_FreeSurface(*superficie);
+    *superficie = NULL;
+}
+
+void Playlist_Preparar(SDL_Renderer* renderer) {
+    if (!s_preCarga.thread || !SDL_AtomicGet(&s_preCarga.pronto)) return;
+    if (!s_preCarga.fase) return;
+    if (s_preCarga.fundo)      subirTextura(renderer, &s_preCarga.fundo, &s_preCarga.fundoTex);
+    else if (s_preCarga.pista) subirTextura(renderer, &s_preCarga.pista, &s_preCarga.pistaTex);
+}
+
+const Fase* Playlist_ProximaPronta(const char** caminho) {
+    if (!s_preCarga.thread || !SDL_AtomicGet(&s_preCarga.pronto)) return NULL;
+    *caminho = s_preCarga.caminho;
+    return s_preCarga.fase;
+}
+
+Fase* Playlist_TomarProxima(SDL_Renderer* renderer) {
+    if (!Playlist_TemProxima()) return NULL;
+
+    if (!s_preCarga.thread && !SDL_AtomicGet(&s_preCarga.pronto)) {
+        snprintf(s_preCarga.caminho, sizeof(s_preCarga.caminho), "%s", s_itens[s_posicao + 1].caminho);
+        preCarregar(&s_preCarga);
+    }
+    esperarPreCarga();
+
+    Fase* fase = s_preCarga.fase;
+    s_preCarga.fase = NULL;
+    if (fase) {
+        // Normalmente já subidas por Playlist_Preparar; o resto sobe agora
+        if (s_preCarga.fundo) subirTextura(renderer, &s_preCarga.fundo, &s_preCarga.fundoTex);
+        if (s_preCarga.pista) subirTextura(renderer, &s_preCarga.pista, &s_preCarga.pistaTex);
+        fase->background  = s_preCarga.fundoTex;
+        fase->rhythmTrack = s_preCarga.pistaTex;
+        s_preCarga.fundoTex = s_preCarga.pistaTex = NULL;
+        if (!fase->background || !fase->rhythmTrack) {
+            printf("Playlist: erro ao carregar as imagens de '%s': %s\n", s_preCarga.caminho, IMG_GetError());
+            Fase_Liberar(fase);
+            fase = NULL;
+        }
+    }
+    descartarPreCarga();
+
+    s_posicao++;
+    if (fase) printf("Playlist: '%s' (%d/%d) com %d notas.\n", Playlist_Atual(), s_posicao + 1, s_total, fase->totalNotas);
+    return fase;
+}
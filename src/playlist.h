@@ -0,0 +1,45 @@
+#ifndef PLAYLIST_H
+#define PLAYLIST_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include "stage.h"
+
+// Maratona: vários charts em sequência, sem voltar ao menu entre eles.
+// Enquanto uma música toca, um thread de apoio já lê o chart da próxima,
+// copia o áudio para a memória e decodifica as imagens. As texturas precisam
+// do renderer: o thread principal sobe uma por quadro (Playlist_Preparar)
+// ainda durante a música, e a troca só entrega o que já está pronto.
+#define PLAYLIST_MAX 16
+
+// Espera o thread, descarta a pré-carga e esvazia a lista.
+void Playlist_Limpar(void);
+// Volta para a primeira música (tentar de novo)
+void Playlist_Reiniciar(void);
+// 'totalNotas' dimensiona a arena da partida para a maior música da lista
+bool Playlist_Adicionar(const char* caminho, int totalNotas);
+
+bool        Playlist_Ativa(void);    // mais de uma música na lista
+int         Playlist_Total(void);
+int         Playlist_Posicao(void);  // índice da música em jogo (0 = primeira)
+const char* Playlist_Atual(void);
+int         Playlist_MaxNotas(void);
+bool        Playlist_TemProxima(void);
+
+// Dispara a pré-carga da próxima música (não bloqueia). Chamar no início de cada música.
+void Playlist_PreCarregarProxima(void);
+
+// Thread principal, a cada quadro enquanto a música toca: quando a pré-carga
+// terminou, sobe no máximo uma textura da próxima música por chamada.
+void Playlist_Preparar(SDL_Renderer* renderer);
+
+// Fase pré-carregada da próxima música (talvez ainda sem texturas) e o caminho
+// do chart, ou NULL se a pré-carga não terminou ou falhou. Serve para adiantar
+// o que depende do chart (ex.: o ranking) antes da troca.
+const Fase* Playlist_ProximaPronta(const char** caminho);
+
+// Avança para a próxima música e devolve a fase pronta para tocar. Se o thread
+// ainda não terminou, espera por ele. NULL se a próxima não pôde ser carregada.
+Fase* Playlist_TomarProxima(SDL_Renderer* renderer);
+
+#endif // PLAYLIST_H
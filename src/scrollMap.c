@@ -0,0 +1,62 @@
+#include "scrollMap.h"
+#include <stdlib.h>
+#include <string.h>
+
+bool ScrollMap_Add(ScrollMap* mapa, Uint32 ms, float velocidade) {
+    if (!(velocidade >= 0.0f && velocidade <= SCROLL_VELOCIDADE_MAX)) return false;
+    if (mapa->total == mapa->capacidade) {
+        int novaCapacidade = mapa->capacidade ? mapa->capacidade * 2 : 16;
+        ScrollTrecho* novo = (ScrollTrecho*)realloc(mapa->trechos, (size_t)novaCapacidade * sizeof(ScrollTrecho));
+        if (!novo) return false;
+        mapa->trechos = novo;
+        mapa->capacidade = novaCapacidade;
+    }
+    mapa->trechos[mapa->total++] = (ScrollTrecho){ ms, velocidade, 0.0 };
+    return true;
+}
+
+void ScrollMap_Finalize(ScrollMap* mapa) {
+    if (mapa->total == 0) return;
+
+    // Inserção: estável (no mesmo ms vale a última linha do arquivo) e
+    // linear no caso comum, em que o chart já lista as mudanças em ordem
+    for (int i = 1; i < mapa->total; ++i) {
+        ScrollTrecho t = mapa->trechos[i];
+        int j = i - 1;
+        while (j >= 0 && mapa->trechos[j].ms > t.ms) { mapa->trechos[j + 1] = mapa->trechos[j]; --j; }
+        mapa->trechos[j + 1] = t;
+    }
+
+    int escrita = 0;
+    for (int i = 0; i < mapa->total; ++i) {
+        if (escrita > 0 && mapa->trechos[escrita - 1].ms == mapa->trechos[i].ms) {
+            mapa->trechos[escrita - 1] = mapa->trechos[i];
+        } else {
+            mapa->trechos[escrita++] = mapa->trechos[i];
+        }
+    }
+    mapa->total = escrita;
+
+    // Antes do primeiro trecho a velocidade é 1, então ele começa em dist = ms
+    mapa->trechos[0].dist = mapa->trechos[0].ms;
+    for (int i = 1; i < mapa->total; ++i) {
+        const ScrollTrecho* ant = &mapa->trechos[i - 1];
+        mapa->trechos[i].dist = ant->dist + (double)(mapa->trechos[i].ms - ant->ms) * ant->velocidade;
+    }
+}
+
+void ScrollMap_Free(ScrollMap* mapa) {
+    free(mapa->trechos);
+    memset(mapa, 0, sizeof(*mapa));
+}
+
+double ScrollMap_Dist(const ScrollMap* mapa, double ms) {
+    if (mapa->total == 0 || ms < mapa->trechos[0].ms) return ms;
+    int lo = 0, hi = mapa->total - 1;
+    while (lo < hi) { // último trecho com início <= ms
+        int meio = (lo + hi + 1) / 2;
+        if (mapa->trechos[meio].ms <= ms) lo = meio; else hi = meio - 1;
+    }
+    const ScrollTrecho* t = &mapa->trechos[lo];
+    return t->dist + (ms - t->ms) * t->velocidade;
+}
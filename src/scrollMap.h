@@ -0,0 +1,39 @@
+#ifndef SCROLL_MAP_H
+#define SCROLL_MAP_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+// Velocidade de rolagem (SV) do chart: "s,tempo,multiplicador" no beatmap.
+// Na carga vira uma tabela linear por partes tempo da música -> distância
+// percorrida, em "ms a velocidade 1" (multiplicar por NOTE_SPEED/1000 dá px).
+// Cada nota guarda a distância do seu alvo; no jogo a posição dela é
+// checker + (distNota - distAgora) * escala, com uma busca por frame.
+
+typedef struct {
+    Uint32 ms;         // início do trecho (tempo da música)
+    float  velocidade; // multiplicador de NOTE_SPEED a partir daqui (0 = pausa)
+    double dist;       // distância acumulada em 'ms'
+} ScrollTrecho;
+
+typedef struct {
+    ScrollTrecho* trechos; // em ordem de ms; vazio = velocidade 1 o tempo todo
+    int total;
+    int capacidade;
+} ScrollMap;
+
+#define SCROLL_VELOCIDADE_MAX 20.0f
+
+// Acrescenta uma mudança de velocidade (qualquer ordem). Retorna false se
+// faltou memória ou o multiplicador é negativo/absurdo.
+bool ScrollMap_Add(ScrollMap* mapa, Uint32 ms, float velocidade);
+
+// Ordena os trechos e acumula as distâncias. Chamar depois do último Add.
+void ScrollMap_Finalize(ScrollMap* mapa);
+
+void ScrollMap_Free(ScrollMap* mapa);
+
+// Distância no tempo 'ms' (antes do primeiro trecho a velocidade é 1)
+double ScrollMap_Dist(const ScrollMap* mapa, double ms);
+
+#endif // SCROLL_MAP_H
@@ -1,6 +1,11 @@
 #include "stage.h"
+#include "auxFuncs/assetPack.h"
+#include "auxFuncs/texCache.h"
+#include "auxFuncs/utils.h"
 #include <stdio.h>
 #include <string.h>
+#include <stdlib.h>
+#include <stdbool.h>
 
 // Converte um char ('z', 'x', 'c') para o SDL_Keycode correspondente
 static SDL_Keycode charParaTecla(char c) {
@@ -18,8 +23,54 @@ static SDL_Keycode charParaTecla(char c) {
     return SDLK_UNKNOWN;
 }
 
-Fase* Fase_CarregarDeArquivo(SDL_Renderer* renderer, const char* caminhoDoArquivo) {
-    FILE* file = fopen(caminhoDoArquivo, "r");
+// Garante espaço para mais uma nota no beatmap. Retorna false se faltou memória.
+static bool garantirCapacidade(Fase* fase) {
+    if (fase->totalNotas < fase->capacidadeNotas) return true;
+    int novaCapacidade = fase->capacidadeNotas ? fase->capacidadeNotas * 2 : CAPACIDADE_INICIAL_NOTAS;
+    Nota* novo = (Nota*) realloc(fase->beatmap, (size_t)novaCapacidade * sizeof(Nota));
+    if (!novo) return false;
+    fase->beatmap = novo;
+    fase->capacidadeNotas = novaCapacidade;
+    return true;
+}
+
+// Lê um campo de tempo: ms ou posição "@beat" (exige BPM). '*emBeat' diz qual
+// foi; 'tick' só é preenchido para posições.
+static bool lerTempo(const TempoMap* mapa, const char* campo, Uint32* ms, bool* emBeat, Sint64* tick) {
+    *emBeat = (campo[0] == '@');
+    if (*emBeat) {
+        if (!TempoMap_Definido(mapa) || !TempoMap_LerPosicao(campo, tick)) return false;
+        *ms = TempoMap_MsDoTick(mapa, *tick);
+        return true;
+    }
+    char* fim;
+    unsigned long valor = strtoul(campo, &fim, 10);
+    if (fim == campo) return false;
+    *ms = (Uint32)valor;
+    return true;
+}
+
+static int compararAlvo(const void* a, const void* b) {
+    Uint32 ta = ((const Nota*)a)->hitTime, tb = ((const Nota*)b)->hitTime;
+    return (ta > tb) - (ta < tb);
+}
+
+// fgets que soma no id do chart os bytes lidos (hash == NULL: linha já somada).
+// O arquivo é aberto em binário para o id ser o mesmo em qualquer plataforma;
+// o "\r\n" de charts salvos no Windows vira "\n" só depois de somado.
+static char* lerLinha(char* linha, int tamanho, FILE* file, Uint64* hash) {
+    if (!fgets(linha, tamanho, file)) return NULL;
+    size_t n = strlen(linha);
+    if (hash) *hash = Fnv1a64Add(*hash, linha, n);
+    if (n >= 2 && linha[n - 2] == '\r' && linha[n - 1] == '\n') {
+        linha[n - 2] = '\n';
+        linha[n - 1] = '\0';
+    }
+    return linha;
+}
+
+Fase* Fase_CarregarChart(const char* caminhoDoArquivo) {
+    FILE* file = fopen(caminhoDoArquivo, "rb");
     if (!file) {
         printf("Erro: Nao foi possivel abrir o arquivo da fase: %s\n", caminhoDoArquivo);
         return NULL;
@@ -34,66 +85,190 @@ Fase* Fase_CarregarDeArquivo(SDL_Renderer* renderer, const char* caminhoDoArquiv
     char linha[256];
     char chave[64];
     char valor[192];
+    double bpm = 0.0;
+    Sint32 offsetMs = 0;
+    Uint64 hash = FNV1A64_INICIO; // partes 1 e 2 passam uma vez por cada byte do arquivo
 
     // Parte 1: Ler o Cabeçalho (Metadados)
-    while (fgets(linha, sizeof(linha), file)) {
+    while (lerLinha(linha, sizeof(linha), file, &hash)) {
         if (strcmp(linha, "---\n") == 0) {
             break; // Fim do cabeçalho
         }
         if (sscanf(linha, "%63[^:]:%191s", chave, valor) == 2) { // Regex para : : Leia até 63 caracteres que não sejam um dois-pontos e guarde em chave.  Espere encontrar um dois-pontos literal e descarte-o. Leia o resto da string (até 191 caracteres) e guarde em valor 
             if (strcmp(chave, "MUSICA") == 0) {
-                fase->musica = Mix_LoadMUS(valor);
+                snprintf(fase->caminhoMusica, sizeof(fase->caminhoMusica), "%s", valor);
             } else if (strcmp(chave, "BACKGROUND") == 0) {
-                fase->background = IMG_LoadTexture(renderer, valor);
+                snprintf(fase->caminhoFundo, sizeof(fase->caminhoFundo), "%s", valor);
             } else if (strcmp(chave, "RHYTHMTRACK") == 0) {
-                fase->rhythmTrack = IMG_LoadTexture(renderer, valor);
+                snprintf(fase->caminhoPista, sizeof(fase->caminhoPista), "%s", valor);
             }
             else if (strcmp(chave, "DURACAO_MS") == 0) {
                 fase->durationMs = (Uint32)atoi(valor);
             }
+            else if (strcmp(chave, "BPM") == 0) {
+                bpm = atof(valor);
+            }
+            else if (strcmp(chave, "OFFSET") == 0) {
+                offsetMs = (Sint32)atoi(valor);
+            }
         }
     }
 
-    if (!fase->musica || !fase->background || !fase->rhythmTrack) {
-        printf("Erro ao carregar recursos da fase a partir do arquivo: %s\n", Mix_GetError());
-        Fase_Liberar(fase);
-        fclose(file);
-        return NULL;
+    if (bpm > 0.0 && !TempoMap_Init(&fase->tempo, bpm, offsetMs)) {
+        printf("Aviso: BPM invalido em %s; posicoes em beat serao ignoradas.\n", caminhoDoArquivo);
+    }
+
+    // Parte 2: mudanças de andamento "t,@beat,bpm", em qualquer ponto do beatmap.
+    // O mapa fica completo antes de qualquer posição em beat virar ms, então uma
+    // mudança escrita depois das notas que ela move ainda vale para elas.
+    char campoTempo[64], campoDuracao[64];
+    long inicioBeatmap = ftell(file);
+    int numLinha = 0;
+    while (lerLinha(linha, sizeof(linha), file, &hash)) {
+        ++numLinha;
+        if (linha[0] != 't') continue;
+        Sint64 tick;
+        double novoBpm;
+        if (sscanf(linha, "t,%63[^,],%lf", campoTempo, &novoBpm) != 2 ||
+            !TempoMap_LerPosicao(campoTempo, &tick) || !TempoMap_Add(&fase->tempo, tick, novoBpm)) {
+            printf("Aviso: %s:%d: mudanca de andamento invalida (precisa de BPM no cabecalho e beats em ordem).\n",
+                   caminhoDoArquivo, numLinha);
+        }
     }
 
-    // Parte 2: Ler o Beatmap 
-    int i = 0;
+    // Parte 3: Ler o Beatmap
     char tipo, tecla;
-    Uint32 tempo, duracao;
-    while (i < MAX_NOTAS_POR_FASE && fgets(linha, sizeof(linha), file)) {
-        if (linha[0] == '#' || linha[0] == '\n') continue; // Ignora comentários e linhas vazias
-
-        // Tenta ler o formato de nota longa primeiro
-        if (sscanf(linha, "%c,%c,%u,%u", &tipo, &tecla, &tempo, &duracao) == 4) {
-            if (tipo == 'l') {
-                fase->beatmap[i++] = Note_CreateLong(charParaTecla(tecla), tempo, duracao);
+    bool ordenado = true;
+    fseek(file, inicioBeatmap, SEEK_SET);
+    numLinha = 0;
+    while (lerLinha(linha, sizeof(linha), file, NULL)) {
+        ++numLinha;
+        if (linha[0] == '#' || linha[0] == '\n' || linha[0] == 't') continue; // comentários, linhas vazias e andamento (já lido)
+
+        int campos = sscanf(linha, "%c,%c,%63[^,\n],%63[^,\n]", &tipo, &tecla, campoTempo, campoDuracao);
+        Uint32 tempo, duracao = 0;
+        Sint64 tick = -1, tickFim;
+        bool emBeat;
+
+        // Velocidade de rolagem: "s,tempo,multiplicador" (tempo da música, em ms ou beat)
+        if (tipo == 's') {
+            float velocidade;
+            if (sscanf(linha, "s,%63[^,],%f", campoTempo, &velocidade) != 2 ||
+                !lerTempo(&fase->tempo, campoTempo, &tempo, &emBeat, &tick) ||
+                !ScrollMap_Add(&fase->rolagem, tempo, velocidade)) {
+                printf("Aviso: %s:%d: mudanca de velocidade invalida.\n", caminhoDoArquivo, numLinha);
             }
-        } 
-        // Se não, tenta ler o formato de nota normal
-        else if (sscanf(linha, "%c,%c,%u", &tipo, &tecla, &tempo) == 3) {
-            if (tipo == 'n') {
-                fase->beatmap[i++] = Note_Create(charParaTecla(tecla), tempo);
+            continue;
+        }
+
+        if (campos < 3 || (tipo != 'n' && tipo != 'l') || !lerTempo(&fase->tempo, campoTempo, &tempo, &emBeat, &tick)) {
+            if (campos >= 3 && campoTempo[0] == '@') {
+                printf("Aviso: %s:%d: posicao em beat invalida ou sem BPM no cabecalho.\n", caminhoDoArquivo, numLinha);
             }
+            continue;
         }
+
+        // Em ms o número é o surgimento da nota (formato original); em beat, o momento do acerto
+        SDL_Keycode teclaNota = charParaTecla(tecla);
+        Uint32 percurso = Note_TravelMs(teclaNota);
+        Uint32 alvo = emBeat ? tempo : tempo + percurso;
+
+        if (tipo == 'l') {
+            if (campos != 4) continue;
+            if (campoDuracao[0] == '@') {
+                Uint32 fim;
+                bool fimEmBeat;
+                if (!lerTempo(&fase->tempo, campoDuracao, &fim, &fimEmBeat, &tickFim) || fim < alvo) {
+                    printf("Aviso: %s:%d: fim de nota longa invalido.\n", caminhoDoArquivo, numLinha);
+                    continue;
+                }
+                duracao = fim - alvo;
+            } else {
+                duracao = (Uint32)strtoul(campoDuracao, NULL, 10);
+            }
+        }
+
+        if (!garantirCapacidade(fase)) {
+            printf("Erro: memoria insuficiente para o beatmap de %s\n", caminhoDoArquivo);
+            break;
+        }
+        Uint32 surgimento = emBeat ? (alvo > percurso ? alvo - percurso : 0) : tempo;
+        Nota nota = (tipo == 'l') ? Note_CreateLong(teclaNota, surgimento, duracao)
+                                  : Note_Create(teclaNota, surgimento);
+        nota.hitTime = alvo;
+        if (fase->totalNotas > 0 && alvo < fase->beatmap[fase->totalNotas - 1].hitTime) ordenado = false;
+        fase->beatmap[fase->totalNotas++] = nota;
     }
 
-    fase->totalNotas = i;
+    // Beat de cada nota e posição na tabela de rolagem, agora que os dois mapas estão completos
+    ScrollMap_Finalize(&fase->rolagem);
+    for (int i = 0; i < fase->totalNotas; ++i) {
+        Nota* nota = &fase->beatmap[i];
+        if (TempoMap_Definido(&fase->tempo)) {
+            Sint64 tickAlvo = TempoMap_TickDoMs(&fase->tempo, nota->hitTime);
+            if (tickAlvo >= 0) nota->beat = (Sint32)(tickAlvo / TEMPO_PPQ);
+        }
+        nota->distHit  = ScrollMap_Dist(&fase->rolagem, nota->hitTime);
+        nota->distTail = ScrollMap_Dist(&fase->rolagem, (double)nota->hitTime + nota->duration);
+    }
+
+    // O jogo percorre o beatmap em ordem; misturar ms e beats pode tirar as linhas de ordem
+    if (!ordenado) qsort(fase->beatmap, (size_t)fase->totalNotas, sizeof(Nota), compararAlvo);
+
     fase->proximaNotaIndex = 0;
     fclose(file);
+    fase->chartId = hash ? hash : 1; // 0 fica reservado para "sem id"
+    return fase;
+}
+
+Fase* Fase_CarregarDeArquivo(SDL_Renderer* renderer, const char* caminhoDoArquivo) {
+    Fase* fase = Fase_CarregarChart(caminhoDoArquivo);
+    if (!fase) return NULL;
+
+    fase->musica      = Asset_LoadMUS(fase->caminhoMusica);
+    fase->background  = TexCache_LoadTexture(renderer, fase->caminhoFundo);
+    fase->rhythmTrack = TexCache_LoadTexture(renderer, fase->caminhoPista);
+    if (!fase->musica || !fase->background || !fase->rhythmTrack) {
+        printf("Erro ao carregar recursos da fase a partir do arquivo: %s\n", Mix_GetError());
+        Fase_Liberar(fase);
+        return NULL;
+    }
+
     printf("Fase '%s' carregada com %d notas.\n", caminhoDoArquivo, fase->totalNotas);
     return fase;
 }
 
+bool Fase_PreCarregarMusica(Fase* fase) {
+    // No pacote de assets ela já está em memória (mapeada): nada a copiar
+    const void* mapeada;
+    size_t tamanho = 0;
+    if (AssetPack_Find(fase->caminhoMusica, &mapeada, &tamanho)) {
+        fase->musica = Asset_LoadMUS(fase->caminhoMusica);
+        return fase->musica != NULL;
+    }
+
+    fase->musicaDados = SDL_LoadFile(fase->caminhoMusica, &tamanho);
+    if (!fase->musicaDados) return false;
+
+    SDL_RWops* rw = SDL_RWFromConstMem(fase->musicaDados, (int)tamanho);
+    fase->musica = rw ? Mix_LoadMUS_RW(rw, 1) : NULL;
+    if (!fase->musica) {
+        SDL_free(fase->musicaDados);
+        fase->musicaDados = NULL;
+        return false;
+    }
+    return true;
+}
+
 void Fase_Liberar(Fase* fase) {
     if (fase) {
         if (fase->background) SDL_DestroyTexture(fase->background);
         if (fase->rhythmTrack) SDL_DestroyTexture(fase->rhythmTrack);
         if (fase->musica) Mix_FreeMusic(fase->musica);
+        if (fase->musicaDados) SDL_free(fase->musicaDados); // depois da música que lê dele
+        TempoMap_Free(&fase->tempo);
+        ScrollMap_Free(&fase->rolagem);
+        free(fase->beatmap);
         free(fase);
     }
 }
\ No newline at end of file
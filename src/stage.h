@@ -5,22 +5,56 @@
 #include <SDL2/SDL_image.h>
 #include "note.h"
 #include "defs.h"
+#include "tempoMap.h"
+#include "scrollMap.h"
 
-#define MAX_NOTAS_POR_FASE 4096
+#define CAPACIDADE_INICIAL_NOTAS 1024 // o beatmap cresce por dobra conforme o arquivo é lido
+
+// Beatmap (.samba), depois do "---":
+//   n,tecla,tempo            nota simples
+//   l,tecla,tempo,duração    nota longa
+//   t,@beat,bpm              mudança de andamento (exige BPM no cabeçalho)
+//   s,tempo,multiplicador    velocidade de rolagem (1 = NOTE_SPEED) a partir de 'tempo'
+// 'tempo' é em ms ("13662") ou, com BPM:/OFFSET: no cabeçalho, uma posição
+// em beat: "@12" ou "@12+1/2" (OFFSET é o ms do beat 0). Em ms, o tempo de
+// uma nota é quando ela surge (formato original, a velocidade 1); em beat,
+// é quando ela chega ao checker. A duração também aceita uma posição, que
+// marca o fim da nota. Tudo é convertido para ms inteiros na carga; o jogo
+// não faz conta de beat durante a partida.
+
+#define FASE_CAMINHO_MAX 192
 
 typedef struct {
+    char caminhoMusica[FASE_CAMINHO_MAX];     // MUSICA: do cabeçalho
+    char caminhoFundo[FASE_CAMINHO_MAX];      // BACKGROUND:
+    char caminhoPista[FASE_CAMINHO_MAX];      // RHYTHMTRACK:
     Mix_Music* musica;
+    void* musicaDados;     // bytes do áudio quando pré-carregado (Fase_PreCarregarMusica)
     SDL_Texture* background;
     SDL_Texture* rhythmTrack; 
-    Nota beatmap[MAX_NOTAS_POR_FASE];
+    Nota* beatmap;
     int totalNotas;
+    int capacidadeNotas;
     int proximaNotaIndex; // Para saber qual a próxima nota a ser spawnada
     Uint32 durationMs; // Duração da música em MS
+    Uint64 chartId;    // FNV-1a 64 dos bytes do .samba, somado na leitura: identifica o chart nos recordes
+    TempoMap tempo;    // BPM/OFFSET e mudanças de andamento; vazio em charts só com ms
+    ScrollMap rolagem; // velocidades de rolagem; vazio = constante
 } Fase;
 
 // Carrega os recursos da fase e define o beatmap
 Fase* Fase_CarregarDeArquivo(SDL_Renderer* renderer, const char* caminhoDoArquivo);
 
+// Só o chart (cabeçalho e beatmap), sem abrir música nem texturas: para quem
+// precisa das notas fora de uma partida, como o indexador da biblioteca
+Fase* Fase_CarregarChart(const char* caminhoDoArquivo);
+
+// Abre a música da fase já em memória (do pacote de assets, ou de uma cópia do
+// arquivo inteiro): a playlist chama num thread de apoio, e a troca de música
+// não toca no disco.
+// Retorna false se o áudio não pôde ser lido.
+bool Fase_PreCarregarMusica(Fase* fase);
+
 // Libera a memória usada pela fase
 void Fase_Liberar(Fase* fase);
 
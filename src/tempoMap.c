@@ -0,0 +1,120 @@
+#include "tempoMap.h"
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+
+#define BPM_MIN 1.0
+#define BPM_MAX 2000.0
+
+// Divisão com arredondamento para baixo também para numeradores negativos
+static Sint64 divPiso(Sint64 a, Sint64 b) {
+    Sint64 q = a / b;
+    if ((a % b != 0) && ((a < 0) != (b < 0))) --q;
+    return q;
+}
+
+static bool usPorBeatDe(double bpm, Sint64* usPorBeat) {
+    if (!(bpm >= BPM_MIN && bpm <= BPM_MAX)) return false;
+    *usPorBeat = llround(60000000.0 / bpm);
+    return true;
+}
+
+static bool acrescentar(TempoMap* mapa, TempoTrecho trecho) {
+    if (mapa->total == mapa->capacidade) {
+        int novaCapacidade = mapa->capacidade ? mapa->capacidade * 2 : 8;
+        TempoTrecho* novo = (TempoTrecho*)realloc(mapa->trechos, (size_t)novaCapacidade * sizeof(TempoTrecho));
+        if (!novo) return false;
+        mapa->trechos = novo;
+        mapa->capacidade = novaCapacidade;
+    }
+    mapa->trechos[mapa->total++] = trecho;
+    return true;
+}
+
+bool TempoMap_Init(TempoMap* mapa, double bpm, Sint32 offsetMs) {
+    TempoTrecho primeiro = { 0, (Sint64)offsetMs * 1000, 0 };
+    mapa->total = 0;
+    if (!usPorBeatDe(bpm, &primeiro.usPorBeat)) return false;
+    return acrescentar(mapa, primeiro);
+}
+
+void TempoMap_Free(TempoMap* mapa) {
+    free(mapa->trechos);
+    memset(mapa, 0, sizeof(*mapa));
+}
+
+bool TempoMap_Definido(const TempoMap* mapa) { return mapa->total > 0; }
+
+bool TempoMap_Add(TempoMap* mapa, Sint64 tick, double bpm) {
+    if (mapa->total == 0) return false;
+    const TempoTrecho* ultimo = &mapa->trechos[mapa->total - 1];
+    if (tick < ultimo->tick) return false;
+
+    TempoTrecho trecho;
+    trecho.tick = tick;
+    trecho.inicioUs = ultimo->inicioUs + (tick - ultimo->tick) * ultimo->usPorBeat / TEMPO_PPQ;
+    if (!usPorBeatDe(bpm, &trecho.usPorBeat)) return false;
+
+    if (tick == ultimo->tick) { // duas mudanças no mesmo ponto: vale a última
+        mapa->trechos[mapa->total - 1].usPorBeat = trecho.usPorBeat;
+        return true;
+    }
+    return acrescentar(mapa, trecho);
+}
+
+Uint32 TempoMap_MsDoTick(const TempoMap* mapa, Sint64 tick) {
+    if (mapa->total == 0) return 0;
+    int lo = 0, hi = mapa->total - 1;
+    while (lo < hi) { // último trecho com início <= tick (antes do beat 0 vale o primeiro)
+        int meio = (lo + hi + 1) / 2;
+        if (mapa->trechos[meio].tick <= tick) lo = meio; else hi = meio - 1;
+    }
+    const TempoTrecho* t = &mapa->trechos[lo];
+    Sint64 us = t->inicioUs + divPiso((tick - t->tick) * t->usPorBeat, TEMPO_PPQ);
+    if (us <= 0) return 0;
+    return (Uint32)((us + 500) / 1000);
+}
+
+Sint64 TempoMap_TickDoMs(const TempoMap* mapa, Uint32 ms) {
+    if (mapa->total == 0) return 0;
+    Sint64 us = (Sint64)ms * 1000;
+    int lo = 0, hi = mapa->total - 1;
+    while (lo < hi) {
+        int meio = (lo + hi + 1) / 2;
+        if (mapa->trechos[meio].inicioUs <= us) lo = meio; else hi = meio - 1;
+    }
+    const TempoTrecho* t = &mapa->trechos[lo];
+    // Arredonda para o tick mais próximo: uma nota em ms exatamente no beat não cai no tick anterior
+    return t->tick + divPiso((us - t->inicioUs) * TEMPO_PPQ * 2 + t->usPorBeat, 2 * t->usPorBeat);
+}
+
+bool TempoMap_LerPosicao(const char* texto, Sint64* tick) {
+    const char* p = texto;
+    while (isspace((unsigned char)*p)) ++p;
+    if (*p++ != '@') return false;
+
+    char* fim;
+    long beat = strtol(p, &fim, 10);
+    if (fim == p) return false;
+    Sint64 ticks = (Sint64)beat * TEMPO_PPQ;
+    p = fim;
+
+    if (*p == '+' || *p == '-') {
+        int sinal = (*p == '-') ? -1 : 1;
+        ++p;
+        long num = strtol(p, &fim, 10);
+        if (fim == p || *fim != '/' || num < 0) return false;
+        p = fim + 1;
+        long den = strtol(p, &fim, 10);
+        if (fim == p || den <= 0) return false;
+        p = fim;
+        // Frações que não caem num tick exato (ex.: 1/7) arredondam para o mais próximo
+        ticks += sinal * (((Sint64)num * TEMPO_PPQ * 2 + den) / (2 * den));
+    }
+
+    while (isspace((unsigned char)*p)) ++p;
+    if (*p != '\0') return false;
+    *tick = ticks;
+    return true;
+}
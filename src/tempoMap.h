@@ -0,0 +1,46 @@
+#ifndef TEMPO_MAP_H
+#define TEMPO_MAP_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+// Mapa de andamento de um chart: BPM/OFFSET do cabeçalho mais as mudanças
+// de andamento ("t,@beat,bpm") do beatmap. Posições em beat viram ticks
+// (TEMPO_PPQ por beat) e são convertidas para ms uma vez, na carga, só com
+// inteiros: cada trecho guarda seu início em microssegundos, então notas
+// longe do começo não acumulam arredondamento.
+
+#define TEMPO_PPQ 960 // ticks por beat; divide por 2, 3, 4, 5, 6, 8, 12, 16...
+
+typedef struct {
+    Sint64 tick;      // onde o trecho começa
+    Sint64 inicioUs;  // tempo do chart nesse tick, em microssegundos
+    Sint64 usPorBeat;
+} TempoTrecho;
+
+typedef struct {
+    TempoTrecho* trechos; // em ordem de tick; vazio = chart sem BPM
+    int total;
+    int capacidade;
+} TempoMap;
+
+// Primeiro trecho: 'bpm' a partir do beat 0, que cai em 'offsetMs'
+bool TempoMap_Init(TempoMap* mapa, double bpm, Sint32 offsetMs);
+void TempoMap_Free(TempoMap* mapa);
+
+// true se o chart declarou BPM
+bool TempoMap_Definido(const TempoMap* mapa);
+
+// Mudança de andamento. 'tick' não pode ser anterior ao último trecho.
+bool TempoMap_Add(TempoMap* mapa, Sint64 tick, double bpm);
+
+// Tick -> ms do chart (arredondado; nunca negativo)
+Uint32 TempoMap_MsDoTick(const TempoMap* mapa, Sint64 tick);
+
+// Ms do chart -> tick mais próximo (negativo antes do beat 0). Busca binária nos trechos.
+Sint64 TempoMap_TickDoMs(const TempoMap* mapa, Uint32 ms);
+
+// Lê "@N", "@N+a/b" ou "@N-a/b" (beat N mais a/b de beat). Espaços no fim são aceitos.
+bool TempoMap_LerPosicao(const char* texto, Sint64* tick);
+
+#endif // TEMPO_MAP_H
@@ -0,0 +1,78 @@
+#include "timing.h"
+#include <math.h>
+#include <string.h>
+
+static float* s_amostras = NULL;
+static int    s_capacidade = 0;
+static int    s_total = 0;
+
+size_t Timing_ArenaSize(int capacidade) {
+    return (size_t)capacidade * sizeof(float) + 16;
+}
+
+bool Timing_Init(Arena* arena, int capacidade) {
+    s_total = 0;
+    s_capacidade = capacidade;
+    s_amostras = capacidade > 0 ? (float*)Arena_Alloc(arena, (size_t)capacidade * sizeof(float), 16) : NULL;
+    return capacidade == 0 || s_amostras != NULL;
+}
+
+void Timing_Shutdown(void) {
+    s_amostras = NULL;
+    s_capacidade = s_total = 0;
+}
+
+void Timing_Add(float erroMs) {
+    if (s_total < s_capacidade) s_amostras[s_total++] = erroMs;
+}
+
+void Timing_Summarize(TimingResumo* resumo) {
+    memset(resumo, 0, sizeof(*resumo));
+    resumo->amostras = s_total;
+    if (s_total == 0) return;
+
+    double soma = 0.0;
+    for (int i = 0; i < s_total; ++i) soma += s_amostras[i];
+    double media = soma / s_total;
+
+    double somaQuadrados = 0.0;
+    const int centro = TIMING_BALDES / 2;
+    for (int i = 0; i < s_total; ++i) {
+        double d = s_amostras[i] - media;
+        somaQuadrados += d * d;
+
+        int balde = centro + (int)floorf(s_amostras[i] / TIMING_BALDE_MS + 0.5f);
+        if (balde < 0) balde = 0;
+        if (balde >= TIMING_BALDES) balde = TIMING_BALDES - 1;
+        resumo->histograma[balde]++;
+        if (balde < centro) resumo->cedo++;
+        else if (balde > centro) resumo->tarde++;
+    }
+
+    resumo->mediaMs  = (float)media;
+    resumo->desvioMs = (float)sqrt(somaQuadrados / s_total);
+    for (int b = 0; b < TIMING_BALDES; ++b)
+        if (resumo->histograma[b] > resumo->maiorBalde) resumo->maiorBalde = resumo->histograma[b];
+}
+
+void Timing_Merge(TimingResumo* total, const TimingResumo* parte) {
+    int n = total->amostras + parte->amostras;
+    if (parte->amostras == 0) return;
+
+    // Média e E[x^2] ponderados pelas amostras de cada lado
+    double media = ((double)total->mediaMs * total->amostras + (double)parte->mediaMs * parte->amostras) / n;
+    double quadrados = ((double)total->desvioMs * total->desvioMs + (double)total->mediaMs * total->mediaMs) * total->amostras
+                     + ((double)parte->desvioMs * parte->desvioMs + (double)parte->mediaMs * parte->mediaMs) * parte->amostras;
+    double variancia = quadrados / n - media * media;
+
+    total->amostras = n;
+    total->mediaMs  = (float)media;
+    total->desvioMs = (float)sqrt(variancia > 0.0 ? variancia : 0.0);
+    total->cedo    += parte->cedo;
+    total->tarde   += parte->tarde;
+    total->maiorBalde = 0;
+    for (int b = 0; b < TIMING_BALDES; ++b) {
+        total->histograma[b] += parte->histograma[b];
+        if (total->histograma[b] > total->maiorBalde) total->maiorBalde = total->histograma[b];
+    }
+}
@@ -0,0 +1,41 @@
+#ifndef TIMING_H
+#define TIMING_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "auxFuncs/arena.h"
+
+// Erro de tempo com sinal de cada nota julgada na partida (negativo = cedo,
+// positivo = tarde), num buffer de tamanho fixo tirado da arena da sessão.
+// No fim vira média, desvio padrão e um histograma.
+
+#define TIMING_BALDES        21    // baldes do histograma (o do meio é o 0 ms)
+#define TIMING_BALDE_MS      10.0f // largura de cada balde; as pontas acumulam o que passar
+
+typedef struct {
+    int   amostras;
+    float mediaMs;
+    float desvioMs;
+    int   cedo, tarde;              // amostras antes / depois do balde central
+    int   histograma[TIMING_BALDES];
+    int   maiorBalde;               // para escalar o gráfico
+} TimingResumo;
+
+// Bytes que Timing_Init vai pedir à arena para 'capacidade' amostras
+size_t Timing_ArenaSize(int capacidade);
+
+// Tira o buffer da arena (chamar na carga). Retorna false se não coube.
+bool Timing_Init(Arena* arena, int capacidade);
+void Timing_Shutdown(void);
+
+// Registra um julgamento. Acima da capacidade a amostra é ignorada.
+void Timing_Add(float erroMs);
+
+void Timing_Summarize(TimingResumo* resumo);
+
+// Soma o resumo de uma música ao da sessão inteira (maratona): amostras,
+// histograma, média e desvio combinados como se fossem um só resumo.
+void Timing_Merge(TimingResumo* total, const TimingResumo* parte);
+
+#endif // TIMING_H
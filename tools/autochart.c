@@ -0,0 +1,433 @@
+// autochart.c
+// Gera um rascunho de .samba a partir da música: onsets por fluxo espectral em
+// três bandas (surdo grave -> Z, pandeiro médio -> X, tamborim agudo -> C),
+// andamento por autocorrelação e notas alinhadas à grade de beats do chart
+// (BPM/OFFSET e posições "@beat"). O resultado é um ponto de partida para o
+// charter revisar, não um chart pronto.
+//
+//   output/autochart musica.mp3 [outra.mp3 ...] [--saida-dir D] [--fundo img]
+//                    [--divisao N] [--sensibilidade S] [--sobrescrever]
+//
+// Cada música vira D/<nome>.samba (padrão: assets/beatMaps); um chart que já
+// existe só é substituído com --sobrescrever. Uma linha por
+// música em stdout com notas, BPM e os tempos de decodificação e análise.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+#include <stdbool.h>
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_mixer.h>
+
+#include "../src/auxFuncs/fft.h"
+
+#define AC_TAXA          22050  // a análise roda na metade de 44,1 kHz
+#define AC_QUADRO        1024   // ~46 ms
+#define AC_SALTO         256    // ~11,6 ms entre quadros
+#define AC_BANDAS        3
+#define AC_JANELA_LIMIAR 0.25f  // s para cada lado na média móvel do limiar
+#define AC_BPM_MIN       70.0
+#define AC_BPM_MAX       180.0
+#define AC_BPM_CENTRO    100.0  // preferência quando há ambiguidade de oitava (samba ~ 90-110)
+#define AC_REFINO_PASSOS     100     // candidatos de cada lado do BPM da autocorrelação
+#define AC_REFINO_RESOLUCAO  0.0001  // 0,01% por passo (±1% no total)
+#define AC_TOLERANCIA_GRADE  0.35    // fração do passo da grade; onset mais longe que isso fica de fora
+
+// Faixas das bandas em Hz e a tecla de cada uma
+static const float s_bandaHz[AC_BANDAS][2] = { { 40.0f, 150.0f }, { 150.0f, 2500.0f }, { 2500.0f, 9000.0f } };
+static const char  s_bandaTecla[AC_BANDAS] = { 'z', 'x', 'c' };
+
+typedef struct {
+    const char* saidaDir;
+    const char* fundo;
+    int   divisao;       // posições por beat na grade (2 = colcheias)
+    float sensibilidade; // limiar = média local * sensibilidade
+    bool  sobrescrever;
+} Opcoes;
+
+typedef struct {
+    int    quadros;
+    float* fluxo[AC_BANDAS];  // fluxo espectral por quadro
+    float* forca;             // soma das bandas normalizadas (curva de onsets)
+} Analise;
+
+static double s_msPorTick = 0.0;
+
+static double agoraMs(void) {
+    return (double)SDL_GetPerformanceCounter() * s_msPorTick;
+}
+
+/* -------- Decodificação -------- */
+
+// Decodifica pelo SDL_mixer (mesmos formatos do jogo) e devolve mono a AC_TAXA
+static float* decodificar(const char* caminho, int* totalOut) {
+    Mix_Chunk* chunk = Mix_LoadWAV(caminho);
+    if (!chunk) {
+        printf("Erro: nao foi possivel decodificar %s: %s\n", caminho, Mix_GetError());
+        return NULL;
+    }
+
+    int taxa = 0, canais = 0;
+    Uint16 formato = 0;
+    Mix_QuerySpec(&taxa, &formato, &canais);
+    if (formato != AUDIO_S16SYS || taxa != 2 * AC_TAXA) {
+        printf("Erro: formato de audio inesperado (%d Hz, 0x%x)\n", taxa, formato);
+        Mix_FreeChunk(chunk);
+        return NULL;
+    }
+
+    const Sint16* pcm = (const Sint16*)chunk->abuf;
+    int quadrosPcm = (int)(chunk->alen / (sizeof(Sint16) * (Uint32)canais));
+    int total = quadrosPcm / 2;
+    float* mono = (float*)malloc((size_t)(total > 0 ? total : 1) * sizeof(float));
+    if (!mono) {
+        Mix_FreeChunk(chunk);
+        return NULL;
+    }
+
+    // Mistura os canais e tira a média de cada par (passa-baixa simples antes de dizimar)
+    const float escala = 1.0f / (32768.0f * (float)canais * 2.0f);
+    for (int i = 0; i < total; ++i) {
+        int soma = 0;
+        for (int c = 0; c < canais; ++c) {
+            soma += pcm[(2 * i) * canais + c] + pcm[(2 * i + 1) * canais + c];
+        }
+        mono[i] = (float)soma * escala;
+    }
+    Mix_FreeChunk(chunk);
+    *totalOut = total;
+    return mono;
+}
+
+/* -------- Análise -------- */
+
+static void liberarAnalise(Analise* a) {
+    for (int b = 0; b < AC_BANDAS; ++b) free(a->fluxo[b]);
+    free(a->forca);
+    memset(a, 0, sizeof(*a));
+}
+
+// STFT + fluxo espectral por banda. A magnitude é comprimida por raiz (vetoriza;
+// log1p por bin seria uma chamada de libm escalar a cada um dos ~13 milhões de bins).
+static bool analisar(const float* mono, int total, Analise* a) {
+    memset(a, 0, sizeof(*a));
+    a->quadros = total >= AC_QUADRO ? (total - AC_QUADRO) / AC_SALTO + 1 : 0;
+    if (a->quadros < 2) return false;
+
+    const int bins = AC_QUADRO / 2 + 1;
+    int inicio[AC_BANDAS], fim[AC_BANDAS];
+    for (int b = 0; b < AC_BANDAS; ++b) {
+        inicio[b] = (int)(s_bandaHz[b][0] * AC_QUADRO / AC_TAXA);
+        fim[b]    = (int)(s_bandaHz[b][1] * AC_QUADRO / AC_TAXA);
+        if (fim[b] > bins) fim[b] = bins;
+    }
+
+    Fft fft = {0};
+    float* atual = (float*)malloc((size_t)bins * sizeof(float));
+    float* anterior = (float*)calloc((size_t)bins, sizeof(float));
+    float* subida = (float*)malloc((size_t)bins * sizeof(float));
+    bool ok = atual && anterior && subida && Fft_Init(&fft, AC_QUADRO);
+    for (int b = 0; ok && b < AC_BANDAS; ++b) {
+        a->fluxo[b] = (float*)calloc((size_t)a->quadros, sizeof(float));
+        ok = a->fluxo[b] != NULL;
+    }
+    a->forca = ok ? (float*)calloc((size_t)a->quadros, sizeof(float)) : NULL;
+    if (!a->forca) {
+        if (fft.n) Fft_Free(&fft);
+        free(atual); free(anterior); free(subida);
+        liberarAnalise(a);
+        return false;
+    }
+
+    for (int q = 0; q < a->quadros; ++q) {
+        Fft_Magnitudes(&fft, mono + (size_t)q * AC_SALTO, atual);
+        for (int k = 0; k < bins; ++k) {
+            float c = sqrtf(atual[k]);
+            float d = c - anterior[k];
+            subida[k] = d > 0.0f ? d : 0.0f;
+            anterior[k] = c;
+        }
+        for (int b = 0; b < AC_BANDAS; ++b) {
+            float soma = 0.0f;
+            for (int k = inicio[b]; k < fim[b]; ++k) soma += subida[k];
+            a->fluxo[b][q] = soma / (float)(fim[b] - inicio[b]);
+        }
+    }
+    for (int b = 0; b < AC_BANDAS; ++b) a->fluxo[b][0] = 0.0f; // primeiro quadro não tem anterior
+
+    // Curva de onsets: bandas com o mesmo peso (o grave tem bem menos bins)
+    for (int b = 0; b < AC_BANDAS; ++b) {
+        double media = 0.0;
+        for (int q = 0; q < a->quadros; ++q) media += a->fluxo[b][q];
+        media /= a->quadros;
+        float inv = media > 0.0 ? (float)(1.0 / media) : 0.0f;
+        for (int q = 0; q < a->quadros; ++q) a->forca[q] += a->fluxo[b][q] * inv;
+    }
+
+    Fft_Free(&fft);
+    free(atual); free(anterior); free(subida);
+    return true;
+}
+
+// Soma da curva de onsets nas posições de uma grade de 'periodo' quadros, na
+// melhor fase (devolvida em 'faseOut', em quadros)
+static double pontuarGrade(const Analise* a, double periodo, double* faseOut) {
+    int fases = (int)ceil(periodo);
+    double melhorSoma = -1.0;
+    *faseOut = 0.0;
+    for (int f = 0; f < fases; ++f) {
+        double soma = 0.0;
+        // O pico de um onset ocupa 1-2 quadros e o período é fracionário: pega o maior vizinho
+        for (double t = f; t < a->quadros - 1; t += periodo) {
+            int q = (int)(t + 0.5);
+            float v = a->forca[q];
+            if (q > 0 && a->forca[q - 1] > v) v = a->forca[q - 1];
+            if (q + 1 < a->quadros && a->forca[q + 1] > v) v = a->forca[q + 1];
+            soma += v;
+        }
+        if (soma > melhorSoma) { melhorSoma = soma; *faseOut = f; }
+    }
+    return melhorSoma;
+}
+
+// Andamento por autocorrelação da curva de onsets, com preferência log-gaussiana
+// em torno de AC_BPM_CENTRO; a fase é o deslocamento com mais energia nos beats.
+static void estimarAndamento(const Analise* a, double* bpmOut, double* offsetMsOut) {
+    const double qps = (double)AC_TAXA / AC_SALTO; // quadros por segundo
+    int lagMin = (int)floor(60.0 * qps / AC_BPM_MAX);
+    int lagMax = (int)ceil(60.0 * qps / AC_BPM_MIN);
+
+    double pontos[512];
+    if (lagMax >= (int)SDL_arraysize(pontos) - 1) lagMax = (int)SDL_arraysize(pontos) - 2;
+    if (a->quadros < 4 * lagMax) { // trecho curto demais para medir: grade neutra
+        *bpmOut = AC_BPM_CENTRO;
+        *offsetMsOut = 0.0;
+        return;
+    }
+
+    // Sem a média, todo lag correlaciona "bem" e o pico se perde
+    double media = 0.0;
+    for (int q = 0; q < a->quadros; ++q) media += a->forca[q];
+    media /= a->quadros;
+
+    int melhor = lagMin;
+    for (int lag = lagMin - 1; lag <= lagMax + 1; ++lag) {
+        double soma = 0.0;
+        for (int q = lag; q < a->quadros; ++q) soma += (a->forca[q] - media) * (a->forca[q - lag] - media);
+        double bpm = 60.0 * qps / lag;
+        double oitavas = log2(bpm / AC_BPM_CENTRO);
+        pontos[lag] = soma / (a->quadros - lag) * exp(-0.5 * oitavas * oitavas);
+        if (lag >= lagMin && lag <= lagMax && pontos[lag] > pontos[melhor]) melhor = lag;
+    }
+
+    // Interpolação parabólica para um período fracionário
+    double periodo = melhor;
+    double y0 = pontos[melhor - 1], y1 = pontos[melhor], y2 = pontos[melhor + 1];
+    double den = y0 - 2.0 * y1 + y2;
+    if (den < 0.0) periodo += 0.5 * (y0 - y2) / den;
+
+    // A autocorrelação só acerta o período em ~0,5 quadro; numa música de 5 min
+    // um erro de 0,1% já desloca a grade meio beat no fim. Refina o BPM pelo
+    // alinhamento da grade com os onsets ao longo da música inteira.
+    double bpmGrosso = 60.0 * qps / periodo, bpm = bpmGrosso, melhorFase = 0.0, melhorSoma = -1.0;
+    for (int passo = -AC_REFINO_PASSOS; passo <= AC_REFINO_PASSOS; ++passo) {
+        double candidato = bpmGrosso * (1.0 + passo * AC_REFINO_RESOLUCAO);
+        double fase;
+        double soma = pontuarGrade(a, 60.0 * qps / candidato, &fase);
+        if (soma > melhorSoma) { melhorSoma = soma; bpm = candidato; melhorFase = fase; }
+    }
+
+    *bpmOut = bpm;
+    // Quadro q cobre [q*salto, q*salto + quadro): o onset fica no centro da janela
+    *offsetMsOut = (melhorFase * AC_SALTO + AC_QUADRO / 2) * 1000.0 / AC_TAXA;
+}
+
+/* -------- Notas -------- */
+
+typedef struct {
+    float forca; // 0 = posição vazia
+    int   banda;
+} Posicao;
+
+// Picos de fluxo acima de um limiar adaptativo, por banda, alinhados à grade.
+// Em cada posição da grade fica só a banda mais forte (rascunho sem acordes).
+static int escolherNotas(const Analise* a, double bpm, double offsetMs, const Opcoes* op,
+                         Posicao** posicoesOut, int* totalPosicoesOut) {
+    const double msPorQuadro = 1000.0 * AC_SALTO / AC_TAXA;
+    const double msPorPosicao = 60000.0 / bpm / op->divisao;
+    const int raio = (int)(AC_JANELA_LIMIAR * AC_TAXA / AC_SALTO);
+    const double fimMs = (a->quadros * AC_SALTO + AC_QUADRO / 2) * 1000.0 / AC_TAXA;
+    int totalPosicoes = (int)((fimMs - offsetMs) / msPorPosicao) + 2;
+    if (totalPosicoes < 1) totalPosicoes = 1;
+
+    Posicao* posicoes = (Posicao*)calloc((size_t)totalPosicoes, sizeof(Posicao));
+    double* acumulado = (double*)malloc((size_t)(a->quadros + 1) * sizeof(double));
+    if (!posicoes || !acumulado) {
+        free(posicoes); free(acumulado);
+        return -1;
+    }
+
+    for (int b = 0; b < AC_BANDAS; ++b) {
+        const float* f = a->fluxo[b];
+        acumulado[0] = 0.0;
+        for (int q = 0; q < a->quadros; ++q) acumulado[q + 1] = acumulado[q] + f[q];
+        const double mediaGlobal = acumulado[a->quadros] / a->quadros;
+        if (mediaGlobal <= 0.0) continue;
+
+        for (int q = 2; q < a->quadros - 2; ++q) {
+            if (f[q] < f[q - 1] || f[q] < f[q - 2] || f[q] <= f[q + 1] || f[q] <= f[q + 2]) continue;
+            int de = q - raio < 0 ? 0 : q - raio;
+            int ate = q + raio + 1 > a->quadros ? a->quadros : q + raio + 1;
+            double mediaLocal = (acumulado[ate] - acumulado[de]) / (ate - de);
+            double limiar = mediaLocal * op->sensibilidade + mediaGlobal * 0.5;
+            if (f[q] <= limiar) continue;
+
+            double ms = q * msPorQuadro + 1000.0 * AC_QUADRO / 2 / AC_TAXA;
+            double exata = (ms - offsetMs) / msPorPosicao;
+            int p = (int)floor(exata + 0.5);
+            if (p < 0 || p >= totalPosicoes) continue;
+            if (fabs(exata - p) > AC_TOLERANCIA_GRADE) continue; // fora da grade (andamento variou?)
+            float forca = (float)((f[q] - limiar) / mediaGlobal);
+            if (forca > posicoes[p].forca) { posicoes[p].forca = forca; posicoes[p].banda = b; }
+        }
+    }
+
+    free(acumulado);
+    int notas = 0;
+    for (int p = 0; p < totalPosicoes; ++p) if (posicoes[p].forca > 0.0f) ++notas;
+    *posicoesOut = posicoes;
+    *totalPosicoesOut = totalPosicoes;
+    return notas;
+}
+
+static int mdc(int a, int b) { while (b) { int t = a % b; a = b; b = t; } return a; }
+
+static bool escreverChart(const char* caminho, const char* musica, const Opcoes* op, Uint32 duracaoMs,
+                          double bpm, double offsetMs, const Posicao* posicoes, int totalPosicoes) {
+    FILE* f = fopen(caminho, "w");
+    if (!f) {
+        printf("Erro: Nao foi possivel criar %s\n", caminho);
+        return false;
+    }
+
+    fprintf(f, "# Rascunho gerado pelo autochart: revise antes de publicar\n");
+    fprintf(f, "MUSICA:%s\n", musica);
+    fprintf(f, "BACKGROUND:%s\n", op->fundo);
+    fprintf(f, "RHYTHMTRACK:assets/image/rhythmTrack.png\n");
+    fprintf(f, "DURACAO_MS:%u\n", duracaoMs);
+    fprintf(f, "BPM:%.3f\n", bpm);
+    fprintf(f, "OFFSET:%d\n", (int)lround(offsetMs));
+    fprintf(f, "---\n");
+    fprintf(f, "# Dados do Beatmap (surdo = z, pandeiro = x, tamborim = c; grade de 1/%d de beat)\n", op->divisao);
+
+    for (int p = 0; p < totalPosicoes; ++p) {
+        if (posicoes[p].forca <= 0.0f) continue;
+        int beat = p / op->divisao, resto = p % op->divisao;
+        char tecla = s_bandaTecla[posicoes[p].banda];
+        if (resto == 0) {
+            fprintf(f, "n,%c,@%d\n", tecla, beat);
+        } else {
+            int g = mdc(resto, op->divisao);
+            fprintf(f, "n,%c,@%d+%d/%d\n", tecla, beat, resto / g, op->divisao / g);
+        }
+    }
+    fclose(f);
+    return true;
+}
+
+// assets/music/MeuLugar_ArlindoCruz.mp3 -> <dir>/meulugar_arlindocruz.samba
+static void caminhoDeSaida(const char* musica, const char* dir, char* out, size_t tamanho) {
+    const char* nome = musica;
+    for (const char* c = musica; *c; ++c) if (*c == '/' || *c == '\\') nome = c + 1;
+    char base[128];
+    size_t n = 0;
+    for (; nome[n] && nome[n] != '.' && n < sizeof(base) - 1; ++n) base[n] = (char)tolower((unsigned char)nome[n]);
+    base[n] = '\0';
+    snprintf(out, tamanho, "%s/%s.samba", dir, base);
+}
+
+static bool processar(const char* musica, const Opcoes* op) {
+    char saida[512];
+    caminhoDeSaida(musica, op->saidaDir, saida, sizeof(saida));
+    FILE* existente = op->sobrescrever ? NULL : fopen(saida, "r");
+    if (existente) {
+        fclose(existente);
+        printf("%s: %s ja existe (use --sobrescrever)\n", musica, saida);
+        return false;
+    }
+
+    double t0 = agoraMs();
+    int total = 0;
+    float* mono = decodificar(musica, &total);
+    if (!mono) return false;
+    double t1 = agoraMs();
+
+    Analise a;
+    if (!analisar(mono, total, &a)) {
+        printf("Erro: %s e curta demais ou faltou memoria.\n", musica);
+        free(mono);
+        return false;
+    }
+    free(mono);
+
+    double bpm, offsetMs;
+    estimarAndamento(&a, &bpm, &offsetMs);
+    Posicao* posicoes = NULL;
+    int totalPosicoes = 0;
+    int notas = escolherNotas(&a, bpm, offsetMs, op, &posicoes, &totalPosicoes);
+    liberarAnalise(&a);
+    double t2 = agoraMs();
+    if (notas < 0) return false;
+
+    Uint32 duracao = (Uint32)((double)total * 1000.0 / AC_TAXA);
+    bool ok = escreverChart(saida, musica, op, duracao, bpm, offsetMs, posicoes, totalPosicoes);
+    free(posicoes);
+
+    if (ok) {
+        printf("%s -> %s: %d notas, BPM %.3f, OFFSET %d ms, %.1f s de audio "
+               "(decodificacao %.0f ms, analise %.0f ms)\n",
+               musica, saida, notas, bpm, (int)lround(offsetMs), duracao / 1000.0, t1 - t0, t2 - t1);
+    }
+    return ok;
+}
+
+int main(int argc, char* argv[]) {
+    Opcoes op = { "assets/beatMaps", "assets/image/meuLugarBG.png", 2, 1.4f, false };
+    const char* musicas[256];
+    int totalMusicas = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        if      (strcmp(argv[i], "--saida-dir") == 0 && i + 1 < argc)     op.saidaDir = argv[++i];
+        else if (strcmp(argv[i], "--fundo") == 0 && i + 1 < argc)         op.fundo = argv[++i];
+        else if (strcmp(argv[i], "--divisao") == 0 && i + 1 < argc)       op.divisao = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--sensibilidade") == 0 && i + 1 < argc) op.sensibilidade = (float)atof(argv[++i]);
+        else if (strcmp(argv[i], "--sobrescrever") == 0)                  op.sobrescrever = true;
+        else if (argv[i][0] != '-' && totalMusicas < (int)SDL_arraysize(musicas)) musicas[totalMusicas++] = argv[i];
+    }
+    if (totalMusicas == 0 || op.divisao < 1 || op.divisao > 16 || op.sensibilidade <= 0.0f) {
+        printf("Uso: %s musica.mp3 [outra.mp3 ...] [--saida-dir D] [--fundo img] [--divisao 1-16] [--sensibilidade S] [--sobrescrever]\n", argv[0]);
+        return 1;
+    }
+
+    // Sem janela nem som de verdade: o driver "dummy" só existe para o mixer decodificar
+    SDL_setenv("SDL_AUDIODRIVER", "dummy", 0);
+    if (SDL_Init(SDL_INIT_AUDIO) < 0) {
+        printf("ERRO: SDL nao pode inicializar! SDL_Error: %s\n", SDL_GetError());
+        return 1;
+    }
+    if (Mix_OpenAudio(2 * AC_TAXA, AUDIO_S16SYS, 2, 2048) < 0) {
+        printf("ERRO: SDL_mixer nao pode inicializar! Mix_Error: %s\n", Mix_GetError());
+        SDL_Quit();
+        return 1;
+    }
+    s_msPorTick = 1000.0 / (double)SDL_GetPerformanceFrequency();
+
+    int falhas = 0;
+    for (int i = 0; i < totalMusicas; ++i) if (!processar(musicas[i], &op)) ++falhas;
+
+    Mix_CloseAudio();
+    Mix_Quit();
+    SDL_Quit();
+    return falhas ? 1 : 0;
+}
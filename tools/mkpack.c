@@ -0,0 +1,181 @@
+// mkpack.c
+// Junta os arquivos de um diretório de assets num pacote só (formato em
+// src/auxFuncs/assetPack.h), que o jogo mapeia em memória na inicialização.
+//
+//   output/mkpack [-f] [diretorio] [saida]      (padrão: assets assets.pak)
+//
+// Os caminhos entram como o jogo os pede ("assets/image/menuBG.png"). Charts
+// (.samba) ficam de fora: o jogo os lê soltos, porque são editados e regravados.
+// O pacote é escrito num temporário e só substitui o anterior quando completo.
+// Se o pacote já é mais novo que todos os arquivos e diretórios (arquivo novo
+// ou apagado muda a data do diretório), nada é refeito; -f refaz assim mesmo.
+// É o mkpack que lista e compara, não o make: nomes com espaço não quebram nada.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <SDL2/SDL.h>
+
+#include "../src/auxFuncs/assetPack.h"
+#include "../src/auxFuncs/utils.h"
+
+#define MP_MAX_ARQUIVOS 4096
+
+typedef struct {
+    char   caminho[256];
+    Uint64 hash;
+    Uint64 tamanho;
+    Uint64 offset;
+    Uint32 nomeOffset;
+} Arquivo;
+
+static Arquivo s_arquivos[MP_MAX_ARQUIVOS];
+static int     s_total = 0;
+static time_t  s_maisRecente = 0; // data mais nova entre os arquivos e diretórios listados
+
+static bool terminaCom(const char* s, const char* fim) {
+    size_t a = strlen(s), b = strlen(fim);
+    return a >= b && strcmp(s + a - b, fim) == 0;
+}
+
+static bool listar(const char* dir) {
+    DIR* d = opendir(dir);
+    if (!d) { printf("ERRO: nao foi possivel abrir '%s'.\n", dir); return false; }
+
+    bool ok = true;
+    struct dirent* ent;
+    while (ok && (ent = readdir(d)) != NULL) {
+        if (ent->d_name[0] == '.') continue;
+
+        char caminho[256];
+        if (snprintf(caminho, sizeof(caminho), "%s/%s", dir, ent->d_name) >= (int)sizeof(caminho)) {
+            printf("ERRO: caminho longo demais em '%s'.\n", dir);
+            ok = false;
+            break;
+        }
+        struct stat st;
+        if (stat(caminho, &st) != 0) continue;
+        if (S_ISDIR(st.st_mode)) {
+            if (st.st_mtime > s_maisRecente) s_maisRecente = st.st_mtime;
+            ok = listar(caminho);
+            continue;
+        }
+        if (!S_ISREG(st.st_mode) || terminaCom(caminho, ".samba")) continue;
+        if (st.st_mtime > s_maisRecente) s_maisRecente = st.st_mtime;
+
+        if (s_total >= MP_MAX_ARQUIVOS) { printf("ERRO: mais de %d arquivos.\n", MP_MAX_ARQUIVOS); ok = false; break; }
+        Arquivo* a = &s_arquivos[s_total++];
+        snprintf(a->caminho, sizeof(a->caminho), "%s", caminho);
+        a->hash = Fnv1a64(a->caminho, strlen(a->caminho));
+        a->tamanho = (Uint64)st.st_size;
+    }
+    closedir(d);
+    return ok;
+}
+
+static int compararHash(const void* pa, const void* pb) {
+    const Arquivo* a = (const Arquivo*)pa;
+    const Arquivo* b = (const Arquivo*)pb;
+    if (a->hash != b->hash) return a->hash < b->hash ? -1 : 1;
+    return strcmp(a->caminho, b->caminho);
+}
+
+static bool copiar(FILE* saida, const char* caminho, Uint64 tamanho) {
+    FILE* f = fopen(caminho, "rb");
+    if (!f) return false;
+    static Uint8 bloco[1 << 16];
+    Uint64 copiados = 0;
+    size_t lidos;
+    while ((lidos = fread(bloco, 1, sizeof(bloco), f)) > 0) {
+        if (fwrite(bloco, 1, lidos, saida) != lidos) break;
+        copiados += lidos;
+    }
+    fclose(f);
+    return copiados == tamanho; // mudou durante a cópia: melhor refazer
+}
+
+int main(int argc, char* argv[]) {
+    bool forcar = argc > 1 && strcmp(argv[1], "-f") == 0;
+    if (forcar) { argv++; argc--; }
+    const char* dir   = argc > 1 ? argv[1] : "assets";
+    const char* saida = argc > 2 ? argv[2] : ASSETPACK_PATH;
+
+    struct stat st;
+    if (stat(dir, &st) == 0) s_maisRecente = st.st_mtime;
+    if (!listar(dir)) return 1;
+    if (!forcar && stat(saida, &st) == 0 && st.st_mtime > s_maisRecente) {
+        printf("%s: atualizado.\n", saida);
+        return 0;
+    }
+    qsort(s_arquivos, (size_t)s_total, sizeof(Arquivo), compararHash);
+
+    // Layout: cabeçalho, índice, nomes e então os dados, cada um alinhado
+    Uint32 bytesNomes = 0;
+    for (int i = 0; i < s_total; ++i) {
+        s_arquivos[i].nomeOffset = bytesNomes;
+        bytesNomes += (Uint32)strlen(s_arquivos[i].caminho);
+    }
+    size_t tamIndice = (size_t)s_total * ASSETPACK_ENTRADA + bytesNomes;
+    Uint64 offset = ASSETPACK_CABECALHO + tamIndice;
+    for (int i = 0; i < s_total; ++i) {
+        offset = (offset + ASSETPACK_ALINHAMENTO - 1) / ASSETPACK_ALINHAMENTO * ASSETPACK_ALINHAMENTO;
+        s_arquivos[i].offset = offset;
+        offset += s_arquivos[i].tamanho;
+    }
+
+    Uint8* indice = (Uint8*)calloc(1, tamIndice + 1);
+    if (!indice) { printf("ERRO: sem memoria para o indice.\n"); return 1; }
+    for (int i = 0; i < s_total; ++i) {
+        const Arquivo* a = &s_arquivos[i];
+        Uint8* e = indice + (size_t)i * ASSETPACK_ENTRADA;
+        PutU64LE(e, a->hash);
+        PutU64LE(e + 8, a->offset);
+        PutU64LE(e + 16, a->tamanho);
+        PutU32LE(e + 24, a->nomeOffset);
+        PutU32LE(e + 28, (Uint32)strlen(a->caminho));
+        memcpy(indice + (size_t)s_total * ASSETPACK_ENTRADA + a->nomeOffset, a->caminho, strlen(a->caminho));
+    }
+
+    Uint8 cabecalho[ASSETPACK_CABECALHO] = {0};
+    memcpy(cabecalho, ASSETPACK_MAGICO, 4);
+    PutU32LE(cabecalho + 4, ASSETPACK_VERSAO);
+    PutU32LE(cabecalho + 8, (Uint32)s_total);
+    PutU32LE(cabecalho + 12, bytesNomes);
+    PutU32LE(cabecalho + 16, Fnv1a32(indice, tamIndice));
+
+    char temp[300];
+    snprintf(temp, sizeof(temp), "%s.tmp", saida);
+    FILE* f = fopen(temp, "wb");
+    if (!f) { printf("ERRO: nao foi possivel criar '%s'.\n", temp); free(indice); return 1; }
+
+    bool ok = fwrite(cabecalho, 1, sizeof(cabecalho), f) == sizeof(cabecalho) &&
+              fwrite(indice, 1, tamIndice, f) == tamIndice;
+    free(indice);
+
+    static const Uint8 zeros[ASSETPACK_ALINHAMENTO] = {0};
+    Uint64 posicao = ASSETPACK_CABECALHO + tamIndice;
+    for (int i = 0; ok && i < s_total; ++i) {
+        const Arquivo* a = &s_arquivos[i];
+        size_t enchimento = (size_t)(a->offset - posicao);
+        ok = fwrite(zeros, 1, enchimento, f) == enchimento;
+        if (ok && !copiar(f, a->caminho, a->tamanho)) {
+            printf("ERRO: falha ao copiar '%s'.\n", a->caminho);
+            ok = false;
+        }
+        posicao = a->offset + a->tamanho;
+    }
+
+    if (!ok) {
+        fclose(f);
+        remove(temp);
+        return 1;
+    }
+    if (!CommitTempFile(f, temp, saida)) {
+        printf("ERRO: nao foi possivel gravar '%s'.\n", saida);
+        return 1;
+    }
+    printf("%s: %d arquivos, %llu bytes.\n", saida, s_total, (unsigned long long)posicao);
+    return 0;
+}